@@ -23,21 +23,29 @@
 
 #include "modules/adminapi/cluster/status.h"
 #include <algorithm>
+#include <chrono>
 #include "modules/adminapi/cluster_set/cluster_set_impl.h"
 #include "modules/adminapi/common/common.h"
 #include "modules/adminapi/common/common_status.h"
+#include "modules/adminapi/common/errors.h"
 #include "modules/adminapi/common/metadata_storage.h"
 #include "modules/adminapi/common/parallel_applier_options.h"
 #include "modules/adminapi/common/sql.h"
 #include "mysqlshdk/libs/mysql/clone.h"
 #include "mysqlshdk/libs/mysql/group_replication.h"
 #include "mysqlshdk/libs/mysql/repl_config.h"
+#include "mysqlshdk/libs/utils/threads.h"
 
 namespace mysqlsh {
 namespace dba {
 namespace cluster {
 
 namespace {
+
+// Maximum number of members which are connected to and queried at the same
+// time, this is the maximum size of a group
+constexpr size_t k_max_parallel_member_probes = 9;
+
 template <typename R>
 inline bool set_uint(shcore::Dictionary_t dict, const std::string &prop,
                      const R &row, const std::string &field) {
@@ -107,6 +115,31 @@ inline bool set_ts(shcore::Dictionary_t dict, const std::string &prop,
 
 }  // namespace
 
+void connect_in_parallel(std::vector<Member_connection> *members,
+                         std::chrono::milliseconds timeout) {
+  const bool has_deadline = timeout.count() > 0;
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+  mysqlshdk::utils::for_each_in_parallel(
+      members->begin(), members->end(), k_max_parallel_member_probes,
+      [has_deadline, deadline](Member_connection &member) {
+        if (has_deadline && std::chrono::steady_clock::now() >= deadline) {
+          member.error = shcore::str_format(
+              "Could not open connection to '%s': timeout while waiting for "
+              "the other members to be probed",
+              member.endpoint.c_str());
+          return;
+        }
+
+        // each attempt uses the default connect timeout
+        try {
+          member.instance = member.connect();
+        } catch (const shcore::Error &e) {
+          member.error = e.format();
+        }
+      });
+}
+
 Status::Status(const Cluster_impl &cluster,
                const mysqlshdk::utils::nullable<uint64_t> &extended)
     : m_cluster(cluster), m_extended(extended) {}
@@ -115,13 +148,32 @@ Status::~Status() {}
 
 void Status::connect_to_members() {
   auto ipool = current_ipool();
+  std::vector<Member_connection> members;
 
   for (const auto &inst : m_instances) {
-    try {
-      m_member_sessions[inst.endpoint] =
-          ipool->connect_unchecked_endpoint(inst.endpoint);
-    } catch (const shcore::Error &e) {
-      m_member_connect_errors[inst.endpoint] = e.format();
+    Member_connection member;
+    member.endpoint = inst.endpoint;
+    member.connect = [ipool, endpoint = inst.endpoint]() {
+      return ipool->connect_unchecked_endpoint(endpoint);
+    };
+
+    members.emplace_back(std::move(member));
+  }
+
+  connect_to_members(&members);
+}
+
+void Status::connect_to_members(std::vector<Member_connection> *members) {
+  // dba.connectTimeout is also the deadline for all the members to be tried
+  connect_in_parallel(
+      members, std::chrono::milliseconds(static_cast<int64_t>(
+                   current_shell_options()->get().dba_connect_timeout * 1000)));
+
+  for (auto &member : *members) {
+    if (member.instance) {
+      m_member_sessions[member.endpoint] = std::move(member.instance);
+    } else {
+      m_member_connect_errors[member.endpoint] = std::move(member.error);
     }
   }
 }
@@ -469,14 +521,14 @@ void Status::collect_basic_local_status(shcore::Dictionary_t dict,
   std::string sql;
 
   if (version >= Version(8, 0, 0)) {
-    if (m_cluster.is_cluster_set_member()) {
+    if (m_is_cluster_set_member) {
       // PRIMARY of PC has no relevant replication lag info
       // PRIMARY of RC shows lag from clusterset_replication channel
       // SECONDARY members show replication from gr_applier channel
       std::string channel_name;
 
       if (is_primary) {
-        if (!m_cluster.is_primary_cluster()) {
+        if (!m_is_primary_cluster) {
           channel_name = k_clusterset_async_channel_name;
         }
       } else {
@@ -1193,6 +1245,121 @@ shcore::Array_t validate_instance_recovery_user(
 
 }  // namespace
 
+/**
+ * Queries the status of a member, using only the session to that member, so
+ * that members can be probed in parallel.
+ */
+void Status::probe_member(Member_probe *probe) {
+  using mysqlshdk::gr::Member_role;
+  using mysqlshdk::gr::Member_state;
+  using mysqlshdk::mysql::Replication_channel;
+
+  const auto &instance = probe->instance;
+  const auto &member = probe->member;
+  auto &minfo = probe->minfo;
+  auto &self_state = probe->self_state;
+  auto &super_read_only = probe->super_read_only;
+  auto &offline_mode = probe->offline_mode;
+  auto &fence_sysvars = probe->fence_sysvars;
+  auto &auto_rejoin = probe->auto_rejoin;
+  auto &applier_channel = probe->applier_channel;
+  auto &recovery_channel = probe->recovery_channel;
+  auto &parallel_applier_options = probe->parallel_applier_options;
+
+  // Get the current parallel-applier options
+  parallel_applier_options = Parallel_applier_options(*instance);
+
+  // Get super_read_only value of each instance to set the mode accurately.
+  super_read_only = instance->get_sysvar_bool("super_read_only");
+
+  // Get offline_mode value of each instance to set the mode accurately.
+  offline_mode = instance->get_sysvar_bool("offline_mode");
+
+  // Check if auto-rejoin is running.
+  auto_rejoin = mysqlshdk::gr::is_running_gr_auto_rejoin(*instance);
+
+  self_state = mysqlshdk::gr::get_member_state(*instance);
+
+  minfo.version = instance->get_version().get_base();
+
+  if (!m_extended.is_null()) {
+    if (*m_extended >= 1) {
+      fence_sysvars = instance->get_fence_sysvars();
+
+      auto workers = parallel_applier_options.replica_parallel_workers;
+
+      if (parallel_applier_options.replica_parallel_workers.get_safe() > 0) {
+        (*member)["applierWorkerThreads"] = shcore::Value(*workers);
+      }
+    }
+
+    if (*m_extended >= 3) {
+      collect_local_status(member, *instance,
+                           minfo.state == Member_state::RECOVERING);
+    }
+    if (minfo.state == Member_state::ONLINE)
+      collect_basic_local_status(member, *instance,
+                                 minfo.role == Member_role::PRIMARY);
+
+    shcore::Value recovery_info;
+    if (minfo.state == Member_state::RECOVERING) {
+      std::string status;
+      std::tie(status, recovery_info) =
+          recovery_status(*instance, probe->join_time);
+      if (!status.empty()) {
+        (*member)["recoveryStatusText"] = shcore::Value(status);
+      }
+    }
+
+    // Include recovery channel info if RECOVERING or if there's an error
+    if (mysqlshdk::mysql::get_channel_status(
+            *instance, mysqlshdk::gr::k_gr_recovery_channel,
+            &recovery_channel) &&
+        *m_extended > 0) {
+      if (minfo.state == Member_state::RECOVERING ||
+          recovery_channel.status() != Replication_channel::OFF) {
+        mysqlshdk::mysql::Replication_channel_master_info master_info;
+        mysqlshdk::mysql::Replication_channel_relay_log_info relay_info;
+
+        mysqlshdk::mysql::get_channel_info(
+            *instance, mysqlshdk::gr::k_gr_recovery_channel, &master_info,
+            &relay_info);
+
+        if (!recovery_info) recovery_info = shcore::Value::new_map();
+
+        (*recovery_info.as_map())["recoveryChannel"] = shcore::Value(
+            channel_status(&recovery_channel, &master_info, &relay_info, "",
+                           *m_extended - 1, true, false));
+      }
+    }
+    if (recovery_info) (*member)["recovery"] = recovery_info;
+
+    // Include applier channel info ONLINE and channel not ON
+    // or != RECOVERING and channel not OFF
+    if (mysqlshdk::mysql::get_channel_status(
+            *instance, mysqlshdk::gr::k_gr_applier_channel,
+            &applier_channel) &&
+        *m_extended > 0) {
+      if ((self_state == Member_state::ONLINE &&
+           applier_channel.status() != Replication_channel::ON) ||
+          (self_state != Member_state::RECOVERING &&
+           self_state != Member_state::ONLINE &&
+           applier_channel.status() != Replication_channel::OFF)) {
+        mysqlshdk::mysql::Replication_channel_master_info master_info;
+        mysqlshdk::mysql::Replication_channel_relay_log_info relay_info;
+
+        mysqlshdk::mysql::get_channel_info(
+            *instance, mysqlshdk::gr::k_gr_applier_channel, &master_info,
+            &relay_info);
+
+        (*member)["applierChannel"] = shcore::Value(
+            channel_status(&applier_channel, &master_info, &relay_info, "",
+                           *m_extended - 1, false, false));
+      }
+    }
+  }
+}
+
 shcore::Dictionary_t Status::get_topology(
     const std::vector<mysqlshdk::gr::Member> &member_info) {
   using mysqlshdk::gr::Member_role;
@@ -1211,6 +1378,7 @@ shcore::Dictionary_t Status::get_topology(
   };
 
   std::vector<Instance_metadata_info> instances;
+  std::vector<Member_connection> unmanaged;
 
   // add placeholders for unmanaged members
   for (const auto &m : member_info) {
@@ -1263,15 +1431,18 @@ shcore::Dictionary_t Status::get_topology(
       mysqlshdk::db::Connection_options group_session_copts(
           group_instance->get_connection_options());
       opts.set_login_options_from(group_session_copts);
-      try {
-        m_member_sessions[mdi.md.endpoint] = Instance::connect(opts);
-      } catch (const shcore::Error &e) {
-        m_member_connect_errors[mdi.md.endpoint] = e.format();
-      }
+
+      Member_connection connection;
+      connection.endpoint = mdi.md.endpoint;
+      connection.connect = [opts]() { return Instance::connect(opts); };
+      unmanaged.emplace_back(std::move(connection));
 
       instances.emplace_back(std::move(mdi));
     }
   }
+
+  connect_to_members(&unmanaged);
+
   // look for instances in MD but not in group
   for (const auto &i : m_instances) {
     bool found = false;
@@ -1310,137 +1481,69 @@ shcore::Dictionary_t Status::get_topology(
             m_cluster.get_id());
   }
 
-  for (const auto &inst : instances) {
-    shcore::Dictionary_t member = shcore::make_dict();
-    mysqlshdk::gr::Member minfo(get_member(inst.actual_server_uuid));
-    mysqlshdk::gr::Member_state self_state =
-        mysqlshdk::gr::Member_state::MISSING;
-
-    auto &instance = m_member_sessions[inst.md.endpoint];
-
-    mysqlshdk::utils::nullable<bool> super_read_only;
-    mysqlshdk::utils::nullable<bool> offline_mode;
-    std::vector<std::string> fence_sysvars;
-    bool auto_rejoin = false;
-
-    Replication_channel applier_channel;
-    Replication_channel recovery_channel;
-
-    Parallel_applier_options parallel_applier_options;
+  // Members are queried in parallel, metadata is read and the diagnostics are
+  // done by this thread, both before and after that
+  std::vector<Member_probe> probes(instances.size());
 
-    if (instance) {
-      // Get the current parallel-applier options
-      parallel_applier_options = Parallel_applier_options(*instance);
+  for (size_t i = 0; i < instances.size(); ++i) {
+    const auto &inst = instances[i];
+    auto &probe = probes[i];
 
-      // Get super_read_only value of each instance to set the mode accurately.
-      super_read_only = instance->get_sysvar_bool("super_read_only");
+    probe.instance = m_member_sessions[inst.md.endpoint];
+    probe.minfo = get_member(inst.actual_server_uuid);
+    probe.member = shcore::make_dict();
 
-      // Get offline_mode value of each instance to set the mode accurately.
-      offline_mode = instance->get_sysvar_bool("offline_mode");
+    if (probe.instance && !m_extended.is_null() &&
+        probe.minfo.state == Member_state::RECOVERING) {
+      // Get the join timestamp from the Metadata
+      shcore::Value join_time;
+      m_cluster.get_metadata_storage()->query_instance_attribute(
+          probe.instance->get_uuid(), k_instance_attribute_join_time,
+          &join_time);
 
-      // Check if auto-rejoin is running.
-      auto_rejoin = mysqlshdk::gr::is_running_gr_auto_rejoin(*instance);
-
-      self_state = mysqlshdk::gr::get_member_state(*instance);
-
-      minfo.version = instance->get_version().get_base();
-
-      if (!m_extended.is_null()) {
-        if (*m_extended >= 1) {
-          fence_sysvars = instance->get_fence_sysvars();
+      if (join_time.type == shcore::String)
+        probe.join_time = join_time.as_string();
+    }
+  }
 
-          auto workers = parallel_applier_options.replica_parallel_workers;
+  mysqlshdk::utils::for_each_in_parallel(
+      probes.begin(), probes.end(), k_max_parallel_member_probes,
+      [this](Member_probe &probe) {
+        if (!probe.instance) return;
 
-          if (parallel_applier_options.replica_parallel_workers.get_safe() >
-              0) {
-            (*member)["applierWorkerThreads"] = shcore::Value(*workers);
-          }
+        try {
+          probe_member(&probe);
+        } catch (...) {
+          probe.error = std::current_exception();
         }
+      });
 
-        if (*m_extended >= 3) {
-          collect_local_status(member, *instance,
-                               minfo.state == Member_state::RECOVERING);
-        }
-        if (minfo.state == Member_state::ONLINE)
-          collect_basic_local_status(member, *instance,
-                                     minfo.role == Member_role::PRIMARY);
-
-        shcore::Value recovery_info;
-        if (minfo.state == Member_state::RECOVERING) {
-          std::string status;
-          // Get the join timestamp from the Metadata
-          shcore::Value join_time;
-          m_cluster.get_metadata_storage()->query_instance_attribute(
-              instance->get_uuid(), k_instance_attribute_join_time, &join_time);
-
-          std::tie(status, recovery_info) = recovery_status(
-              *instance,
-              join_time.type == shcore::String ? join_time.as_string() : "");
-          if (!status.empty()) {
-            (*member)["recoveryStatusText"] = shcore::Value(status);
-          }
-        }
+  for (const auto &probe : probes) {
+    if (probe.error) std::rethrow_exception(probe.error);
+  }
 
-        // Include recovery channel info if RECOVERING or if there's an error
-        if (mysqlshdk::mysql::get_channel_status(
-                *instance, mysqlshdk::gr::k_gr_recovery_channel,
-                &recovery_channel) &&
-            *m_extended > 0) {
-          if (minfo.state == Member_state::RECOVERING ||
-              recovery_channel.status() != Replication_channel::OFF) {
-            mysqlshdk::mysql::Replication_channel_master_info master_info;
-            mysqlshdk::mysql::Replication_channel_relay_log_info relay_info;
-
-            mysqlshdk::mysql::get_channel_info(
-                *instance, mysqlshdk::gr::k_gr_recovery_channel, &master_info,
-                &relay_info);
-
-            if (!recovery_info) recovery_info = shcore::Value::new_map();
-
-            (*recovery_info.as_map())["recoveryChannel"] = shcore::Value(
-                channel_status(&recovery_channel, &master_info, &relay_info, "",
-                               *m_extended - 1, true, false));
-          }
-        }
-        if (recovery_info) (*member)["recovery"] = recovery_info;
-
-        // Include applier channel info ONLINE and channel not ON
-        // or != RECOVERING and channel not OFF
-        if (mysqlshdk::mysql::get_channel_status(
-                *instance, mysqlshdk::gr::k_gr_applier_channel,
-                &applier_channel) &&
-            *m_extended > 0) {
-          if ((self_state == Member_state::ONLINE &&
-               applier_channel.status() != Replication_channel::ON) ||
-              (self_state != Member_state::RECOVERING &&
-               self_state != Member_state::ONLINE &&
-               applier_channel.status() != Replication_channel::OFF)) {
-            mysqlshdk::mysql::Replication_channel_master_info master_info;
-            mysqlshdk::mysql::Replication_channel_relay_log_info relay_info;
-
-            mysqlshdk::mysql::get_channel_info(
-                *instance, mysqlshdk::gr::k_gr_applier_channel, &master_info,
-                &relay_info);
-
-            (*member)["applierChannel"] = shcore::Value(
-                channel_status(&applier_channel, &master_info, &relay_info, "",
-                               *m_extended - 1, false, false));
-          }
-        }
-      }
+  for (size_t i = 0; i < instances.size(); ++i) {
+    const auto &inst = instances[i];
+    const auto &probe = probes[i];
+    const auto &member = probe.member;
+    const auto &minfo = probe.minfo;
+    const auto &instance = probe.instance;
+    const auto self_state = probe.self_state;
+    const auto &super_read_only = probe.super_read_only;
+    const auto &offline_mode = probe.offline_mode;
 
-    } else {
+    if (!instance) {
       (*member)["shellConnectError"] =
           shcore::Value(m_member_connect_errors[inst.md.endpoint]);
     }
     feed_metadata_info(member, inst.md);
     feed_member_info(member, minfo, offline_mode, super_read_only,
-                     fence_sysvars, self_state, auto_rejoin);
+                     probe.fence_sysvars, self_state, probe.auto_rejoin);
 
     shcore::Array_t issues = instance_diagnostics(
-        instance.get(), &m_cluster, inst, recovery_channel, applier_channel,
-        super_read_only, minfo, self_state, parallel_applier_options,
-        *m_cluster_transaction_size_limit);
+        instance.get(), &m_cluster, inst, probe.recovery_channel,
+        probe.applier_channel, super_read_only, minfo, self_state,
+        probe.parallel_applier_options, *m_cluster_transaction_size_limit);
 
     if (offline_mode.get_safe(false))
       issues->push_back(
@@ -1649,6 +1752,10 @@ void Status::prepare() {
 
   m_instances = m_cluster.get_instances();
 
+  m_is_cluster_set_member = m_cluster.is_cluster_set_member();
+  m_is_primary_cluster =
+      m_is_cluster_set_member && m_cluster.is_primary_cluster();
+
   // Always connect to members to be able to get an accurate mode, based on
   // their super_ready_only value.
   connect_to_members();
@@ -24,14 +24,21 @@
 #ifndef MODULES_ADMINAPI_CLUSTER_STATUS_H_
 #define MODULES_ADMINAPI_CLUSTER_STATUS_H_
 
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "modules/adminapi/cluster/cluster_impl.h"
+#include "modules/adminapi/common/parallel_applier_options.h"
 #include "modules/command_interface.h"
+#include "mysqlshdk/libs/db/connection_options.h"
 #include "mysqlshdk/libs/mysql/group_replication.h"
+#include "mysqlshdk/libs/mysql/replication.h"
 #include "mysqlshdk/libs/utils/utils_net.h"
 
 namespace mysqlsh {
@@ -47,6 +54,55 @@ struct Instance_metadata_info {
   std::string actual_server_uuid;
 };
 
+/**
+ * Connection to a member, established by one of the worker threads.
+ */
+struct Member_connection {
+  std::string endpoint;
+  // opens the connection, called by the worker thread
+  std::function<std::shared_ptr<Instance>()> connect;
+  std::shared_ptr<Instance> instance;
+  std::string error;
+};
+
+/**
+ * Connects to all the given members in parallel.
+ *
+ * All the connection attempts have to be started within the given timeout,
+ * counted from the moment this function is called, so an unreachable member
+ * doesn't delay the others. Members which could not be tried before the
+ * deadline are reported as connection errors. A timeout of 0 means there's no
+ * deadline.
+ *
+ * Attempts which are in progress when the deadline expires are not cut short,
+ * each one uses the full connect timeout.
+ */
+void connect_in_parallel(std::vector<Member_connection> *members,
+                         std::chrono::milliseconds timeout);
+
+/**
+ * Status of a member, as reported by the member itself. Filled by one of the
+ * worker threads, using only the session to that member.
+ */
+struct Member_probe {
+  std::shared_ptr<Instance> instance;
+  mysqlshdk::gr::Member minfo;
+  // join timestamp of a RECOVERING member, read from the metadata beforehand
+  std::string join_time;
+
+  shcore::Dictionary_t member;
+  mysqlshdk::gr::Member_state self_state = mysqlshdk::gr::Member_state::MISSING;
+  mysqlshdk::utils::nullable<bool> super_read_only;
+  mysqlshdk::utils::nullable<bool> offline_mode;
+  std::vector<std::string> fence_sysvars;
+  bool auto_rejoin = false;
+  mysqlshdk::mysql::Replication_channel applier_channel;
+  mysqlshdk::mysql::Replication_channel recovery_channel;
+  Parallel_applier_options parallel_applier_options;
+
+  std::exception_ptr error;
+};
+
 class Status : public Command_interface {
  public:
   Status(const Cluster_impl &cluster,
@@ -107,8 +163,17 @@ class Status : public Command_interface {
   bool m_no_quorum = false;
   std::optional<int64_t> m_cluster_transaction_size_limit = -1;
 
+  // cached, as the members are probed in parallel and Cluster_impl may query
+  // the metadata to get these
+  bool m_is_cluster_set_member = false;
+  bool m_is_primary_cluster = false;
+
   void connect_to_members();
 
+  void connect_to_members(std::vector<Member_connection> *members);
+
+  void probe_member(Member_probe *probe);
+
   shcore::Dictionary_t check_group_status(
       const mysqlsh::dba::Instance &instance,
       const std::vector<mysqlshdk::gr::Member> &members, bool has_quorum);
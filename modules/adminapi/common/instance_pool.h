@@ -26,6 +26,7 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -320,6 +321,8 @@ class Instance_pool final {
                      mysqlshdk::db::Connection_options *opts);
 
   std::list<Pool_entry> m_pool;
+  // guards m_pool, instances may be leased from several threads
+  std::mutex m_pool_mutex;
   Auth_options m_default_auth_opts;
   struct Metadata_cache;
   Metadata_cache *m_mdcache = nullptr;
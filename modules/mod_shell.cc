@@ -2140,8 +2140,8 @@ REGISTER_HELP_FUNCTION_TEXT(SHELL_DUMPROWS, R"*(
 Formats and dumps the given resultset object to the console.
 
 @param result The resultset object to dump
-@param format One of table, tabbed, vertical, json, ndjson, json/raw,
-json/array, json/pretty. Default is table.
+@param format One of table, tabbed, csv, vertical, json, ndjson,
+json/raw, json/array, json/pretty. Default is table.
 @returns The number of printed rows
 
 This function shows a resultset object returned by a DB Session query in
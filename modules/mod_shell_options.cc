@@ -47,6 +47,11 @@ name cache is enabled. The \rehash command can be used for manual refresh
 @li batchContinueOnError: read-only, boolean value to indicate if the
 execution of an SQL script in batch mode shall continue if errors occur
 
+@li bulkSource: boolean value to indicate if consecutive INSERT and REPLACE
+statements shall be sent to the server in multi-statement batches when
+executing an SQL script in non-interactive batch mode, supported only by classic
+sessions and when the JSON output is disabled
+
 @li connectTimeout: float, default connection timeout used by Shell sessions,
 in seconds
 
@@ -155,6 +160,7 @@ format of printed query results:
 
 @li table: tabular format with a ascii character frame (default)
 @li tabbed: tabular format with no frame, columns separated by tabs
+@li csv: comma separated values with a header line, NULL values are empty
 @li vertical: displays the outputs vertically, one line per column value
 @li json: same as json/pretty
 @li ndjson: newline delimited JSON, same as json/raw
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -122,11 +122,24 @@ class Dialect_dump_writer : public Dump_writer {
   }
 
   void store_row(const mysqlshdk::db::IRow *row) override {
-    for (uint32_t idx = 0; idx < m_num_fields; ++idx) {
-      store_field(row, idx);
-    }
+    store_fields(*row);
+  }
 
-    finish_row();
+  void store_rows(const mysqlshdk::db::Row_batch &batch,
+                  std::vector<std::size_t> *row_sizes) override {
+    const auto rows = batch.size();
+
+    for (std::size_t r = 0; r < rows; ++r) {
+      buffer()->reset_fixed_length();
+
+      const auto length = buffer()->length();
+
+      store_fields(batch.row(r));
+
+      if (row_sizes) {
+        row_sizes->emplace_back(buffer()->length() - length);
+      }
+    }
   }
 
   void store_postamble() override {
@@ -182,14 +195,24 @@ class Dialect_dump_writer : public Dump_writer {
     buffer()->set_fixed_length(fixed_length);
   }
 
-  void store_field(const mysqlshdk::db::IRow *row, uint32_t idx) {
+  template <typename Row>
+  inline void store_fields(const Row &row) {
+    for (uint32_t idx = 0; idx < m_num_fields; ++idx) {
+      store_field(row, idx);
+    }
+
+    finish_row();
+  }
+
+  template <typename Row>
+  inline void store_field(const Row &row, uint32_t idx) {
     if (0 != idx) {
       buffer()->append_fixed(T::fields_terminated_by[0]);
     }
 
     const char *data = nullptr;
     std::size_t length = 0;
-    row->get_raw_data(idx, &data, &length);
+    row.get_raw_data(idx, &data, &length);
 
     bool is_null = nullptr == data;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2021 Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -23,6 +23,7 @@
 
 #include "modules/util/dump/dump_utils.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -125,6 +126,37 @@ std::string get_table_data_filename(const std::string &basename,
          std::to_string(index) + "." + ext;
 }
 
+std::size_t sample_index_ranges(
+    const Index_key &first, const Index_key &last, uint64_t keys_per_range,
+    const std::function<std::vector<Index_key>(const Index_key &from,
+                                               uint64_t offset)> &sample,
+    const std::function<bool(const Index_key &begin, const Index_key &end,
+                             bool last_range)> &on_range) {
+  // a single lookup per range: skip to the last key of the current range,
+  // fetch it along with the first key of the next one
+  const auto offset = std::max(keys_per_range, UINT64_C(1)) - 1;
+  std::size_t ranges_count = 0;
+  Index_key begin = first;
+
+  while (true) {
+    auto keys = sample(begin, offset);
+    // if there are no more keys, rows were removed, close the range with the
+    // last known key
+    const auto &end = keys.empty() ? last : keys[0];
+    const auto last_range = keys.size() < 2 || last == end;
+
+    ++ranges_count;
+
+    if (!on_range(begin, end, last_range) || last_range) {
+      break;
+    }
+
+    begin = std::move(keys[1]);
+  }
+
+  return ranges_count;
+}
+
 bool error_on_user_filters_conflicts(
     const std::vector<shcore::Account> &included_users,
     const std::vector<shcore::Account> &excluded_users) {
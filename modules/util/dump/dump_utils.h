@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -24,6 +24,8 @@
 #ifndef MODULES_UTIL_DUMP_DUMP_UTILS_H_
 #define MODULES_UTIL_DUMP_DUMP_UTILS_H_
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -58,6 +60,37 @@ std::string get_table_data_filename(const std::string &basename,
                                     const std::string &ext, size_t index,
                                     bool last_chunk);
 
+/**
+ * Values of the index columns of a single row.
+ */
+using Index_key = std::vector<std::string>;
+
+/**
+ * Splits the index into ranges holding keys_per_range keys each (the last
+ * range may hold fewer keys). Only the boundaries of the ranges are sampled,
+ * the sampler is called once per range and has to return (at most) two
+ * consecutive keys, skipping `offset` keys in the index order, starting with
+ * the given key (inclusive).
+ *
+ * Each range is passed to the callback as soon as it is known, callback can
+ * stop the process by returning false.
+ *
+ * @param first The first key in the index.
+ * @param last The last key in the index.
+ * @param keys_per_range Requested number of keys in each range.
+ * @param sample Index sampler.
+ * @param on_range Callback called with the first and the last key of a range,
+ *        and a flag set if this is the last range.
+ *
+ * @returns Number of generated ranges.
+ */
+std::size_t sample_index_ranges(
+    const Index_key &first, const Index_key &last, uint64_t keys_per_range,
+    const std::function<std::vector<Index_key>(const Index_key &from,
+                                               uint64_t offset)> &sample,
+    const std::function<bool(const Index_key &begin, const Index_key &end,
+                             bool last_range)> &on_range);
+
 /**
  * Writes errors to the console for each conflicting pair of values, returns
  * true if any errors were found.
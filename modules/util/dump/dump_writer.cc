@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -69,6 +69,12 @@ void Dump_writer::Buffer::set_fixed_length(std::size_t fixed_length) {
   m_fixed_length_remaining = m_fixed_length = fixed_length;
 }
 
+void Dump_writer::Buffer::reset_fixed_length() {
+  m_fixed_length_remaining = m_fixed_length;
+
+  will_write(0);
+}
+
 void Dump_writer::Buffer::will_write(std::size_t bytes) {
   const auto requested_capacity = m_length + m_fixed_length_remaining + bytes;
 
@@ -123,7 +129,9 @@ void Dump_writer::Buffer::write_base64_data(const char *data,
 }
 
 Dump_writer::Dump_writer(std::unique_ptr<IFile> out)
-    : m_output(std::move(out)), m_buffer(std::make_unique<Buffer>()) {
+    : m_output(std::move(out)),
+      m_buffer(std::make_unique<Buffer>()),
+      m_output_block(std::make_unique<Buffer>()) {
   using mysqlshdk::storage::Compressed_file;
 
   m_compressed = dynamic_cast<Compressed_file *>(output()) != nullptr;
@@ -132,6 +140,7 @@ Dump_writer::Dump_writer(std::unique_ptr<IFile> out)
 Dump_writer::~Dump_writer() {
   try {
     if (output()->is_open()) {
+      flush();
       output()->close();
     }
   } catch (const std::runtime_error &error) {
@@ -145,6 +154,28 @@ void Dump_writer::open() {
   }
 }
 
+void Dump_writer::set_output_block_size(std::size_t size) {
+  if (m_output_block->length() > 0) {
+    throw std::logic_error(
+        "Cannot change size of the output block while it holds data");
+  }
+
+  m_output_block_size = size;
+}
+
+Dump_write_result Dump_writer::flush() {
+  Dump_write_result result;
+  const auto length = m_output_block->length();
+
+  if (length > 0) {
+    result.m_bytes_written =
+        write_output(m_output_block->data(), length, "output block");
+    m_output_block->clear();
+  }
+
+  return result;
+}
+
 Dump_write_result Dump_writer::write_preamble(
     const std::vector<mysqlshdk::db::Column> &metadata,
     const std::vector<Encoding_type> &pre_encoded_columns) {
@@ -159,35 +190,60 @@ Dump_write_result Dump_writer::write_row(const mysqlshdk::db::IRow *row) {
   return write_buffer("row");
 }
 
+Dump_write_result Dump_writer::write_rows(
+    const mysqlshdk::db::Row_batch &batch,
+    std::vector<std::size_t> *row_sizes) {
+  buffer()->clear();
+  store_rows(batch, row_sizes);
+  return write_buffer("rows");
+}
+
 Dump_write_result Dump_writer::write_postamble() {
   buffer()->clear();
   store_postamble();
-  return write_buffer("postamble");
+  auto result = write_buffer("postamble");
+  result += flush();
+  return result;
 }
 
-Dump_write_result Dump_writer::write_buffer(const char *context) const {
+Dump_write_result Dump_writer::write_buffer(const char *context) {
   Dump_write_result result;
 
-  result.m_data_bytes = buffer()->length();
-
-  if (result.m_data_bytes > 0) {
-    using mysqlshdk::storage::Compressed_file;
-    const auto compressed = static_cast<Compressed_file *>(output());
-    const auto size = m_compressed ? compressed->file()->tell() : 0;
-    const auto bytes_written =
-        output()->write(buffer()->data(), result.m_data_bytes);
+  const auto length = buffer()->length();
+  result.m_data_bytes = length;
 
-    if (bytes_written < 0) {
-      THROW_ERROR(SHERR_DUMP_DW_WRITE_FAILED, context,
-                  output()->full_path().masked().c_str());
+  if (length > 0) {
+    // data is buffered only if it fits into the output block, if the block is
+    // going to overflow, it's written out first
+    if (m_output_block->length() + length > m_output_block_size) {
+      result += flush();
     }
 
-    result.m_bytes_written =
-        m_compressed ? compressed->file()->tell() - size : bytes_written;
+    if (length >= m_output_block_size) {
+      result.m_bytes_written += write_output(buffer()->data(), length, context);
+    } else {
+      m_output_block->will_write(length);
+      m_output_block->append(buffer()->data(), length);
+    }
   }
 
   return result;
 }
 
+uint64_t Dump_writer::write_output(const char *data, std::size_t length,
+                                   const char *context) const {
+  using mysqlshdk::storage::Compressed_file;
+  const auto compressed = static_cast<Compressed_file *>(output());
+  const auto size = m_compressed ? compressed->file()->tell() : 0;
+  const auto bytes_written = output()->write(data, length);
+
+  if (bytes_written < 0) {
+    THROW_ERROR(SHERR_DUMP_DW_WRITE_FAILED, context,
+                output()->full_path().masked().c_str());
+  }
+
+  return m_compressed ? compressed->file()->tell() - size : bytes_written;
+}
+
 }  // namespace dump
 }  // namespace mysqlsh
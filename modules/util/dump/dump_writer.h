@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -32,6 +32,7 @@
 
 #include "mysqlshdk/libs/db/column.h"
 #include "mysqlshdk/libs/db/row.h"
+#include "mysqlshdk/libs/db/row_batch.h"
 #include "mysqlshdk/libs/storage/ifile.h"
 
 namespace mysqlsh {
@@ -92,6 +93,21 @@ class Dump_writer {
 
   void open();
 
+  /**
+   * Sets size of the output block. Data is accumulated in memory and written
+   * to the output file once block is full, so that the (possibly compressing)
+   * output file does not receive lots of tiny writes. If set to 0, data is
+   * written immediately.
+   */
+  void set_output_block_size(std::size_t size);
+
+  std::size_t output_block_size() const noexcept { return m_output_block_size; }
+
+  /**
+   * Writes out any data accumulated in the output block.
+   */
+  Dump_write_result flush();
+
   mysqlshdk::storage::IFile *output() const { return m_output.get(); }
 
   Dump_write_result write_preamble(
@@ -100,8 +116,24 @@ class Dump_writer {
 
   Dump_write_result write_row(const mysqlshdk::db::IRow *row);
 
+  /**
+   * Writes all rows from the given batch using a single output operation.
+   *
+   * @param batch Rows to be written.
+   * @param row_sizes If set, receives number of data bytes of each row.
+   *
+   * @returns Combined result of writing all the rows.
+   */
+  Dump_write_result write_rows(const mysqlshdk::db::Row_batch &batch,
+                               std::vector<std::size_t> *row_sizes = nullptr);
+
+  /**
+   * Writes the postamble and flushes the output block.
+   */
   Dump_write_result write_postamble();
 
+  static constexpr std::size_t k_default_output_block_size = 2 * 1024 * 1024;
+
  protected:
   class Buffer final {
    public:
@@ -146,6 +178,12 @@ class Dump_writer {
 
     void set_fixed_length(std::size_t fixed_length);
 
+    /**
+     * Restores the fixed length reservation, needs to be called before each
+     * row is stored, if buffer holds multiple rows.
+     */
+    void reset_fixed_length();
+
     void will_write(std::size_t bytes);
 
    private:
@@ -168,14 +206,28 @@ class Dump_writer {
 
   virtual void store_row(const mysqlshdk::db::IRow *row) = 0;
 
+  /**
+   * Stores all rows from the batch, if row_sizes is set, number of bytes
+   * stored for each row is appended to it.
+   */
+  virtual void store_rows(const mysqlshdk::db::Row_batch &batch,
+                          std::vector<std::size_t> *row_sizes) = 0;
+
   virtual void store_postamble() = 0;
 
-  Dump_write_result write_buffer(const char *context) const;
+  Dump_write_result write_buffer(const char *context);
+
+  uint64_t write_output(const char *data, std::size_t length,
+                        const char *context) const;
 
   std::unique_ptr<mysqlshdk::storage::IFile> m_output;
 
   std::unique_ptr<Buffer> m_buffer;
 
+  std::unique_ptr<Buffer> m_output_block;
+
+  std::size_t m_output_block_size = k_default_output_block_size;
+
   bool m_compressed = false;
 };
 
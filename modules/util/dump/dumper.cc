@@ -87,6 +87,18 @@ static constexpr auto k_dump_in_progress_ext = ".dumping";
 static constexpr const int k_mysql_server_net_write_timeout = 30 * 60;
 static constexpr const int k_mysql_server_wait_timeout = 365 * 24 * 60 * 60;
 
+// rows are fetched and written in batches, a batch is complete once either of
+// these limits is reached
+static constexpr const std::size_t k_rows_per_batch = 1024;
+static constexpr const std::size_t k_bytes_per_batch = 1024 * 1024;
+
+// maximum number of background threads compressing data of a single file
+static constexpr const int k_max_compression_threads_per_file = 4;
+
+// data is compressed in independent frames of this (uncompressed) size, this
+// allows loader to seek within a compressed file
+static constexpr const std::size_t k_compressed_frame_size = 8 * 1024 * 1024;
+
 FI_DEFINE(dumper, [](const mysqlshdk::utils::FI::Args &args) {
   throw std::runtime_error(args.get_string("msg"));
 });
@@ -415,29 +427,44 @@ class Dumper::Table_worker final {
       bytes_written_per_file += bytes_written;
       bytes_written_per_update += bytes_written;
 
-      while (const auto row = result->fetch_one()) {
+      mysqlshdk::db::Row_batch batch;
+      std::vector<std::size_t> row_sizes;
+
+      while (result->fetch_batch(&batch, k_rows_per_batch,
+                                 k_bytes_per_batch) > 0) {
         if (m_dumper->m_worker_interrupt) {
           return;
         }
 
-        bytes_written = table.writer->write_row(row);
+        row_sizes.clear();
+
+        // the idx file contains offsets to the data stream, not to binary one
+        uint64_t data_offset = bytes_written_per_file.data_bytes();
+
+        bytes_written = table.writer->write_rows(batch, &row_sizes);
         bytes_written_per_file += bytes_written;
         bytes_written_per_update += bytes_written;
-        bytes_written_per_idx += bytes_written.data_bytes();
-        ++rows_written_per_update;
-        ++rows_written_per_file;
-
-        if (table.index_file && bytes_written_per_idx >= write_idx_every) {
-          // the idx file contains offsets to the data stream, not to binary one
-          const auto offset = mysqlshdk::utils::host_to_network(
-              bytes_written_per_file.data_bytes());
-          table.index_file->write(&offset, sizeof(uint64_t));
-
-          // make sure offsets are written when close to the write_idx_every
-          bytes_written_per_idx %= write_idx_every;
+        rows_written_per_update += batch.size();
+        rows_written_per_file += batch.size();
+
+        for (const auto row_size : row_sizes) {
+          data_offset += row_size;
+          bytes_written_per_idx += row_size;
+
+          if (table.index_file && bytes_written_per_idx >= write_idx_every) {
+            const auto offset = mysqlshdk::utils::host_to_network(data_offset);
+            table.index_file->write(&offset, sizeof(uint64_t));
+
+            // make sure offsets are written when close to the write_idx_every
+            bytes_written_per_idx %= write_idx_every;
+          }
+
+          if (row_size > max_row_size) {
+            max_row_size = row_size;
+          }
         }
 
-        if (update_every == rows_written_per_update) {
+        if (rows_written_per_update >= update_every) {
           m_dumper->update_progress(rows_written_per_update,
                                     bytes_written_per_update);
 
@@ -450,10 +477,6 @@ class Dumper::Table_worker final {
           rows_written_per_update = 0;
           bytes_written_per_update.reset();
         }
-
-        if (bytes_written.data_bytes() > max_row_size) {
-          max_row_size = bytes_written.data_bytes();
-        }
       }
     } catch (const mysqlshdk::db::Error &e) {
       log_error("%sFailed to dump %s (chunk %s) using query: %s, error: %s",
@@ -965,49 +988,46 @@ class Dumper::Table_worker final {
     log_info("%sChunking %s using non-integer algorithm", m_log_id.c_str(),
              info.table->task_name.c_str());
 
-    std::size_t ranges_count = 0;
-
-    Row range_begin = begin;
-    Row range_end;
-
     const auto &columns = info.table->info->index.columns();
     const auto index =
         shcore::str_join(columns.begin() + info.index_column, columns.end(),
                          ",", [](const auto &c) { return c->quoted_name; });
 
     const auto select = "SELECT SQL_NO_CACHE " + index + " FROM " +
-                        info.table->quoted_name + info.partition + " ";
-    const auto order_by_and_limit = info.order_by + " LIMIT " +
-                                    std::to_string(info.rows_per_chunk - 1) +
-                                    ",2 ";
-
-    const auto fetch =
-        [&end](const std::shared_ptr<mysqlshdk::db::IResult> &res) {
-          const auto row = res->fetch_one();
-          return row ? fetch_row(row) : end;
-        };
+                        info.table->quoted_name + info.partition;
+    std::size_t ranges_count = 0;
 
-    std::shared_ptr<mysqlshdk::db::IResult> result;
+    const auto sample = [&info, &select, &ranges_count, this](
+                            const Row &from, uint64_t offset) {
+      const auto result =
+          query(select + where(ge(info, from)) + info.order_by + " LIMIT " +
+                std::to_string(offset) + ",2" +
+                get_query_comment(*info.table, std::to_string(ranges_count)));
+      std::vector<Row> keys;
 
-    do {
-      const auto condition = where(ge(info, range_begin));
-      const auto chunk_id = std::to_string(ranges_count);
-      const auto comment = get_query_comment(*info.table, chunk_id);
+      while (const auto row = result->fetch_one()) {
+        keys.emplace_back(fetch_row(row));
+      }
 
-      result = query(select + condition + order_by_and_limit + comment);
+      return keys;
+    };
 
+    const auto push_chunk = [&info, &ranges_count, this](
+                                const Row &range_begin, const Row &range_end,
+                                bool last_chunk) {
       if (m_dumper->m_worker_interrupt) {
-        return 0;
+        return false;
       }
 
-      range_end = fetch(result);
-
       create_and_push_table_data_task(
-          *info.table, between(info, range_begin, range_end), chunk_id,
-          ranges_count++, range_end == end);
+          *info.table, between(info, range_begin, range_end),
+          std::to_string(ranges_count), ranges_count, last_chunk);
+      ++ranges_count;
 
-      range_begin = fetch(result);
-    } while (range_end != end);
+      return true;
+    };
+
+    sample_index_ranges(begin, end, info.rows_per_chunk, sample, push_chunk);
 
     return ranges_count;
   }
@@ -1162,13 +1182,13 @@ class Dumper::Table_worker final {
     }
   }
 
-  void dump_schema_ddl(const Schema_info &schema) const {
+  void dump_schema_ddl(const Schema_info &schema) {
     log_info("%sWriting DDL for schema %s", m_log_id.c_str(),
              schema.quoted_name.c_str());
 
-    const auto dumper = m_dumper->schema_dumper(m_session);
+    const auto dumper = schema_dumper();
 
-    m_dumper->write_ddl(*m_dumper->dump_schema(dumper.get(), schema.name),
+    m_dumper->write_ddl(*m_dumper->dump_schema(dumper, schema.name),
                         get_schema_filename(schema.basename));
 
     ++m_dumper->m_ddl_written;
@@ -1176,21 +1196,20 @@ class Dumper::Table_worker final {
     m_dumper->validate_dump_consistency(m_session);
   }
 
-  void dump_table_ddl(const Schema_info &schema,
-                      const Table_info &table) const {
+  void dump_table_ddl(const Schema_info &schema, const Table_info &table) {
     log_info("%sWriting DDL for table %s", m_log_id.c_str(),
              table.quoted_name.c_str());
 
-    const auto dumper = m_dumper->schema_dumper(m_session);
+    const auto dumper = schema_dumper();
 
     m_dumper->write_ddl(
-        *m_dumper->dump_table(dumper.get(), schema.name, table.name),
+        *m_dumper->dump_table(dumper, schema.name, table.name),
         get_table_filename(table.basename));
 
     if (m_dumper->m_options.dump_triggers() &&
         dumper->count_triggers_for_table(schema.name, table.name) > 0) {
       m_dumper->write_ddl(
-          *m_dumper->dump_triggers(dumper.get(), schema.name, table.name),
+          *m_dumper->dump_triggers(dumper, schema.name, table.name),
           dump::get_table_data_filename(table.basename, "triggers.sql"));
     }
 
@@ -1199,20 +1218,20 @@ class Dumper::Table_worker final {
     m_dumper->validate_dump_consistency(m_session);
   }
 
-  void dump_view_ddl(const Schema_info &schema, const View_info &view) const {
+  void dump_view_ddl(const Schema_info &schema, const View_info &view) {
     log_info("%sWriting DDL for view %s", m_log_id.c_str(),
              view.quoted_name.c_str());
 
-    const auto dumper = m_dumper->schema_dumper(m_session);
+    const auto dumper = schema_dumper();
 
     // DDL file with the temporary table
     m_dumper->write_ddl(
-        *m_dumper->dump_temporary_view(dumper.get(), schema.name, view.name),
+        *m_dumper->dump_temporary_view(dumper, schema.name, view.name),
         dump::get_table_data_filename(view.basename, "pre.sql"));
 
     // DDL file with the view structure
     m_dumper->write_ddl(
-        *m_dumper->dump_view(dumper.get(), schema.name, view.name),
+        *m_dumper->dump_view(dumper, schema.name, view.name),
         get_table_filename(view.basename));
 
     ++m_dumper->m_ddl_written;
@@ -1225,12 +1244,23 @@ class Dumper::Table_worker final {
     return m_dumper->get_query_comment(table.task_name, id, "chunking");
   }
 
+  Schema_dumper *schema_dumper() {
+    // dumper is reused by all DDL tasks executed by this worker, so that it
+    // does not repeat the statements which set up the state of the session
+    if (!m_schema_dumper) {
+      m_schema_dumper = m_dumper->schema_dumper(m_session);
+    }
+
+    return m_schema_dumper.get();
+  }
+
   const std::size_t m_id;
   const std::string m_log_id;
   Dumper *m_dumper;
   Exception_strategy m_strategy;
   mysqlshdk::utils::Rate_limit m_rate_limit;
   std::shared_ptr<mysqlshdk::db::ISession> m_session;
+  std::unique_ptr<Schema_dumper> m_schema_dumper;
 };
 
 // template specialization of a static method must be defined outside of a class
@@ -2030,10 +2060,16 @@ void Dumper::initialize_instance_cache() {
   m_current_stage = m_progress_thread.start_stage("Gathering information");
   shcore::on_leave_scope finish_stage([this]() { m_current_stage->finish(); });
 
+  const auto session_factory = [this]() {
+    auto s = establish_session(session()->get_connection_options(), false);
+    on_init_thread_session(s);
+    return s;
+  };
+
   auto builder = Instance_cache_builder(
       session(), m_options.included_schemas(), m_options.included_tables(),
       m_options.excluded_schemas(), m_options.excluded_tables(),
-      std::move(m_cache));
+      std::move(m_cache), true, m_options.threads(), session_factory);
 
   if (dump_users()) {
     builder.users(m_options.included_users(), m_options.excluded_users());
@@ -2727,8 +2763,8 @@ Dump_writer *Dumper::get_table_data_writer(const std::string &filename) {
     auto file = m_options.use_single_file()
                     ? std::move(m_output_file)
                     : make_file(filename_for_data_dump(filename), true);
-    auto compressed_file =
-        mysqlshdk::storage::make_file(std::move(file), m_options.compression());
+    auto compressed_file = mysqlshdk::storage::make_file(
+        std::move(file), m_options.compression(), compression_options());
     std::unique_ptr<Dump_writer> writer;
 
     if (import_table::Dialect::default_() == m_options.dialect()) {
@@ -2754,6 +2790,25 @@ Dump_writer *Dumper::get_table_data_writer(const std::string &filename) {
   return m_worker_writers.back().get();
 }
 
+mysqlshdk::storage::Compression_options Dumper::compression_options() const {
+  mysqlshdk::storage::Compression_options options;
+
+  options.frame_size = k_compressed_frame_size;
+
+  // each worker thread writes to its own file, spare CPU cores are split
+  // evenly between these files and used to compress the data in the
+  // background, while worker threads are fetching rows from the server
+  const auto cores = static_cast<int>(std::thread::hardware_concurrency());
+  const auto workers = static_cast<int>(m_options.threads());
+
+  if (workers > 0 && cores > workers) {
+    options.threads = std::min(std::max((cores - workers) / workers, 1),
+                               k_max_compression_threads_per_file);
+  }
+
+  return options;
+}
+
 std::size_t Dumper::finish_writing(Dump_writer *writer, uint64_t total_bytes) {
   std::size_t file_size = 0;
 
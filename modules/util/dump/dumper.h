@@ -37,6 +37,7 @@
 #include "mysqlshdk/libs/db/column.h"
 #include "mysqlshdk/libs/mysql/user_privileges.h"
 #include "mysqlshdk/libs/storage/backend/memory_file.h"
+#include "mysqlshdk/libs/storage/compressed_file.h"
 #include "mysqlshdk/libs/storage/idirectory.h"
 #include "mysqlshdk/libs/storage/ifile.h"
 #include "mysqlshdk/libs/textui/text_progress.h"
@@ -280,6 +281,8 @@ class Dumper {
 
   std::size_t finish_writing(Dump_writer *writer, uint64_t total_bytes);
 
+  mysqlshdk::storage::Compression_options compression_options() const;
+
   std::string close_file(const Dump_writer &writer) const;
 
   void write_metadata() const;
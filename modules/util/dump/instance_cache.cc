@@ -26,11 +26,14 @@
 #include <mysqld_error.h>
 
 #include <algorithm>
+#include <exception>
 #include <iterator>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 
 #include "mysqlshdk/include/shellcore/console.h"
+#include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "mysqlshdk/libs/utils/debug.h"
 #include "mysqlshdk/libs/utils/logger.h"
 #include "mysqlshdk/libs/utils/profiling.h"
@@ -282,24 +285,13 @@ Instance_cache_builder::Instance_cache_builder(
     const std::shared_ptr<mysqlshdk::db::ISession> &session,
     const Filter &included_schemas, const Object_filters &included_tables,
     const Filter &excluded_schemas, const Object_filters &excluded_tables,
-    Instance_cache &&cache, bool include_metadata)
+    Instance_cache &&cache, bool include_metadata, std::size_t threads,
+    const Session_factory &session_factory)
     : m_session(session), m_cache(std::move(cache)) {
   set_schema_filter(included_schemas, excluded_schemas);
   set_table_filter(included_tables, excluded_tables);
 
-  for (const auto &schema : m_cache.schemas) {
-    if (!schema.second.tables.empty()) {
-      set_has_tables();
-    }
-
-    if (!schema.second.views.empty()) {
-      set_has_views();
-    }
-
-    if (has_tables() && has_views()) {
-      break;
-    }
-  }
+  find_objects();
 
   if (m_cache.schemas.empty()) {
     fetch_version();
@@ -310,8 +302,27 @@ Instance_cache_builder::Instance_cache_builder(
   }
 
   if (include_metadata) {
-    fetch_metadata();
+    fetch_metadata(threads, session_factory);
+  }
+}
+
+Instance_cache_builder::Instance_cache_builder(
+    const Instance_cache_builder &parent,
+    const std::shared_ptr<mysqlshdk::db::ISession> &session,
+    Instance_cache &&cache)
+    : m_session(session),
+      m_cache(std::move(cache)),
+      m_table_filter(parent.m_table_filter) {
+  Filter schemas;
+
+  for (const auto &schema : m_cache.schemas) {
+    schemas.emplace(schema.first);
   }
+
+  // schemas were already filtered, query just the ones held by this builder
+  set_schema_filter(schemas, {});
+
+  find_objects();
 }
 
 Instance_cache_builder &Instance_cache_builder::users(const Users &included,
@@ -452,6 +463,22 @@ Instance_cache_builder &Instance_cache_builder::binlog_info() {
 
 Instance_cache Instance_cache_builder::build() { return std::move(m_cache); }
 
+void Instance_cache_builder::find_objects() {
+  for (const auto &schema : m_cache.schemas) {
+    if (!schema.second.tables.empty()) {
+      set_has_tables();
+    }
+
+    if (!schema.second.views.empty()) {
+      set_has_views();
+    }
+
+    if (has_tables() && has_views()) {
+      break;
+    }
+  }
+}
+
 void Instance_cache_builder::filter_schemas() {
   Profiler profiler{"filtering schemas"};
 
@@ -538,16 +565,173 @@ void Instance_cache_builder::filter_tables() {
   m_cache.total.views = count(info, "'VIEW'=TABLE_TYPE");
 }
 
-void Instance_cache_builder::fetch_metadata() {
+void Instance_cache_builder::fetch_metadata(
+    std::size_t threads, const Session_factory &session_factory) {
   Profiler profiler{"fetching metadata"};
 
   fetch_ndbinfo();
   fetch_server_metadata();
-  fetch_view_metadata();
-  fetch_columns();
-  fetch_table_indexes();
-  fetch_table_histograms();
-  fetch_table_partitions();
+
+  mysqlshdk::utils::Duration duration;
+  duration.start();
+
+  const auto durations =
+      session_factory && threads > 1 && m_cache.schemas.size() > 1
+          ? fetch_schema_metadata_in_parallel(threads, session_factory)
+          : fetch_schema_metadata();
+
+  duration.finish();
+
+  if (m_histograms_failed) {
+    current_console()->print_warning("Failed to fetch table histograms.");
+  }
+
+  log_info("Fetching metadata of %zu schemas took %f seconds (%s)",
+           m_cache.schemas.size(), duration.seconds_elapsed(),
+           shcore::str_join(durations, ", ",
+                            [](const auto &stage) {
+                              return shcore::str_format("%s: %f seconds",
+                                                        stage.first,
+                                                        stage.second);
+                            })
+               .c_str());
+}
+
+Instance_cache_builder::Stage_durations
+Instance_cache_builder::fetch_schema_metadata() {
+  Stage_durations durations;
+
+  const auto stage = [this, &durations](const char *name,
+                                        void (Instance_cache_builder::*fetch)()) {
+    mysqlshdk::utils::Duration duration;
+    duration.start();
+
+    (this->*fetch)();
+
+    duration.finish();
+    durations.emplace_back(name, duration.seconds_elapsed());
+  };
+
+  stage("view metadata", &Instance_cache_builder::fetch_view_metadata);
+  stage("columns", &Instance_cache_builder::fetch_columns);
+  // indexes refer to the columns, they need to be fetched first
+  stage("indexes", &Instance_cache_builder::fetch_table_indexes);
+  stage("histograms", &Instance_cache_builder::fetch_table_histograms);
+  stage("partitions", &Instance_cache_builder::fetch_table_partitions);
+
+  return durations;
+}
+
+Instance_cache_builder::Stage_durations
+Instance_cache_builder::fetch_schema_metadata_in_parallel(
+    std::size_t threads, const Session_factory &session_factory) {
+  std::vector<std::shared_ptr<mysqlshdk::db::ISession>> sessions{m_session};
+
+  threads = std::min(threads, m_cache.schemas.size());
+
+  while (sessions.size() < threads) {
+    try {
+      sessions.emplace_back(session_factory());
+    } catch (const std::exception &e) {
+      log_warning(
+          "Failed to open an additional session to fetch metadata, using %zu "
+          "thread(s): %s",
+          sessions.size(), e.what());
+      break;
+    }
+  }
+
+  const auto close_sessions = [&sessions]() {
+    // the first session is owned by the caller
+    for (auto it = std::next(sessions.begin()); it != sessions.end(); ++it) {
+      (*it)->close();
+    }
+  };
+
+  shcore::on_leave_scope cleanup{close_sessions};
+
+  if (sessions.size() < 2) {
+    return fetch_schema_metadata();
+  }
+
+  Profiler profiler{"fetching metadata in parallel"};
+
+  // distribute the schemas, starting with the ones with the most objects, each
+  // one is assigned to the shard with the fewest objects so far
+  std::vector<Instance_cache> caches(sessions.size());
+  std::vector<std::size_t> objects(sessions.size(), 0);
+
+  {
+    std::vector<std::pair<std::size_t, std::string>> schemas;
+    schemas.reserve(m_cache.schemas.size());
+
+    for (const auto &schema : m_cache.schemas) {
+      schemas.emplace_back(
+          schema.second.tables.size() + schema.second.views.size(),
+          schema.first);
+    }
+
+    std::sort(schemas.begin(), schemas.end(), std::greater<>());
+
+    for (const auto &schema : schemas) {
+      const auto idx = std::distance(
+          objects.begin(), std::min_element(objects.begin(), objects.end()));
+
+      objects[idx] += schema.first;
+      // nodes are moved, addresses of the cached objects do not change
+      caches[idx].schemas.insert(m_cache.schemas.extract(schema.second));
+    }
+  }
+
+  std::vector<Instance_cache_builder> shards;
+  shards.reserve(caches.size());
+
+  for (std::size_t i = 0; i < caches.size(); ++i) {
+    caches[i].server_version = m_cache.server_version;
+    shards.emplace_back(Instance_cache_builder(*this, sessions[i],
+                                               std::move(caches[i])));
+  }
+
+  std::vector<Stage_durations> durations(shards.size());
+  std::vector<std::exception_ptr> exceptions(shards.size());
+  std::vector<std::thread> workers;
+  workers.reserve(shards.size());
+
+  for (std::size_t i = 0; i < shards.size(); ++i) {
+    workers.emplace_back(
+        mysqlsh::spawn_scoped_thread([i, &shards, &durations, &exceptions]() {
+          try {
+            durations[i] = shards[i].fetch_schema_metadata();
+          } catch (...) {
+            exceptions[i] = std::current_exception();
+          }
+        }));
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  for (auto &shard : shards) {
+    m_cache.schemas.merge(shard.m_cache.schemas);
+    m_histograms_failed |= shard.m_histograms_failed;
+  }
+
+  for (const auto &exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  Stage_durations total = durations.front();
+
+  for (auto it = std::next(durations.begin()); it != durations.end(); ++it) {
+    for (std::size_t i = 0; i < total.size(); ++i) {
+      total[i].second += (*it)[i].second;
+    }
+  }
+
+  return total;
 }
 
 void Instance_cache_builder::fetch_version() {
@@ -912,7 +1096,7 @@ void Instance_cache_builder::fetch_table_histograms() {
     }
   } catch (const mysqlshdk::db::Error &e) {
     log_error("Failed to fetch table histograms: %s.", e.format().c_str());
-    current_console()->print_warning("Failed to fetch table histograms.");
+    m_histograms_failed = true;
   }
 }
 
@@ -32,6 +32,7 @@
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "mysqlshdk/libs/db/session.h"
@@ -180,14 +181,24 @@ class Instance_cache_builder final {
   using Filter = std::unordered_set<std::string>;
   using Object_filters = std::unordered_map<std::string, Filter>;
   using Trigger_filters = std::unordered_map<std::string, Object_filters>;
+  using Session_factory =
+      std::function<std::shared_ptr<mysqlshdk::db::ISession>()>;
 
   Instance_cache_builder() = delete;
 
+  /**
+   * Creates the builder.
+   *
+   * If session factory is given and more than one thread is requested,
+   * metadata of the schemas is fetched in parallel, each thread using its own
+   * session obtained from the factory and handling a subset of schemas.
+   */
   Instance_cache_builder(
       const std::shared_ptr<mysqlshdk::db::ISession> &session,
       const Filter &included_schemas, const Object_filters &included_tables,
       const Filter &excluded_schemas, const Object_filters &excluded_tables,
-      Instance_cache &&cache = {}, bool include_metadata = true);
+      Instance_cache &&cache = {}, bool include_metadata = true,
+      std::size_t threads = 1, const Session_factory &session_factory = {});
 
   Instance_cache_builder(const Instance_cache_builder &) = delete;
   Instance_cache_builder(Instance_cache_builder &&) = default;
@@ -226,11 +237,41 @@ class Instance_cache_builder final {
     std::string name;
   };
 
+  using Stage_durations = std::vector<std::pair<const char *, double>>;
+
+  /**
+   * Creates a builder which fetches metadata of the schemas held by the given
+   * cache, using the table filter of the parent builder.
+   */
+  Instance_cache_builder(
+      const Instance_cache_builder &parent,
+      const std::shared_ptr<mysqlshdk::db::ISession> &session,
+      Instance_cache &&cache);
+
+  void find_objects();
+
   void filter_schemas();
 
   void filter_tables();
 
-  void fetch_metadata();
+  void fetch_metadata(std::size_t threads,
+                      const Session_factory &session_factory);
+
+  /**
+   * Fetches metadata of the tables and views in the cached schemas.
+   *
+   * @returns Time spent in each stage.
+   */
+  Stage_durations fetch_schema_metadata();
+
+  /**
+   * Fetches metadata of the schemas using multiple threads, each thread
+   * handles a subset of schemas.
+   *
+   * @returns Time spent in each stage, summed over all threads.
+   */
+  Stage_durations fetch_schema_metadata_in_parallel(
+      std::size_t threads, const Session_factory &session_factory);
 
   void fetch_version();
 
@@ -359,6 +400,8 @@ class Instance_cache_builder final {
   bool m_has_tables = false;
 
   bool m_has_views = false;
+
+  bool m_histograms_failed = false;
 };
 
 }  // namespace dump
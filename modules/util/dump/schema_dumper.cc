@@ -549,15 +549,40 @@ void Schema_dumper::fetch_db_collation(const std::string &db,
   @returns  whether there was an error or not
 */
 void Schema_dumper::switch_character_set_results(const char *cs_name) {
+  if (m_current_character_set_results == cs_name) {
+    return;
+  }
+
   try {
     m_mysql->executef("SET SESSION character_set_results = ?", cs_name);
   } catch (const mysqlshdk::db::Error &e) {
+    m_current_character_set_results.clear();
     THROW_ERROR(SHERR_DUMP_SD_CHARACTER_SET_RESULTS_ERROR, cs_name);
   }
+
+  m_current_character_set_results = cs_name;
 }
 
-void Schema_dumper::use(const std::string &db) const {
+int Schema_dumper::enable_quote_show_create() {
+  if (!m_quote_show_create) {
+    if (execute_no_throw("SET SQL_QUOTE_SHOW_CREATE=1")) {
+      return 1;
+    }
+
+    m_quote_show_create = true;
+  }
+
+  return 0;
+}
+
+void Schema_dumper::use(const std::string &db) {
+  if (m_current_schema == db) {
+    return;
+  }
+
+  m_current_schema.clear();
   m_mysql->executef("USE !", db);
+  m_current_schema = db;
 }
 
 void Schema_dumper::unescape(IFile *file, const char *pos, size_t length) {
@@ -1159,7 +1184,7 @@ std::vector<Schema_dumper::Issue> Schema_dumper::get_table_structure(
 
   result_table = shcore::quote_identifier(table);
 
-  if (!execute_no_throw("SET SQL_QUOTE_SHOW_CREATE=1")) {
+  if (!enable_quote_show_create()) {
     /* using SHOW CREATE statement */
     if (!skip_ddl) {
       /* Make an sql-file, if path was given iow. option -T was given */
@@ -206,6 +206,15 @@ class Schema_dumper {
 
   const Instance_cache *m_cache = nullptr;
 
+  /*
+    Session state set by this dumper, used to skip the statements which would
+    not change it when dumper is reused to dump multiple objects. Empty values
+    mean that state is unknown.
+  */
+  std::string m_current_schema;
+  std::string m_current_character_set_results;
+  bool m_quote_show_create = false;
+
  private:
   int execute_no_throw(const std::string &s,
                        mysqlshdk::db::Error *out_error = nullptr);
@@ -232,7 +241,9 @@ class Schema_dumper {
 
   void switch_character_set_results(const char *cs_name);
 
-  void use(const std::string &db) const;
+  int enable_quote_show_create();
+
+  void use(const std::string &db);
 
   void unescape(IFile *file, const char *pos, size_t length);
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -99,13 +99,24 @@ void Text_dump_writer::store_preamble(
 }
 
 void Text_dump_writer::store_row(const mysqlshdk::db::IRow *row) {
-  start_row();
+  store_fields(*row);
+}
 
-  for (uint32_t idx = 0; idx < m_num_fields; ++idx) {
-    store_field(row, idx);
-  }
+void Text_dump_writer::store_rows(const mysqlshdk::db::Row_batch &batch,
+                                  std::vector<std::size_t> *row_sizes) {
+  const auto rows = batch.size();
 
-  finish_row();
+  for (std::size_t r = 0; r < rows; ++r) {
+    buffer()->reset_fixed_length();
+
+    const auto length = buffer()->length();
+
+    store_fields(batch.row(r));
+
+    if (row_sizes) {
+      row_sizes->emplace_back(buffer()->length() - length);
+    }
+  }
 }
 
 void Text_dump_writer::store_postamble() {
@@ -163,12 +174,23 @@ void Text_dump_writer::read_metadata(
   buffer()->set_fixed_length(fixed_length);
 }
 
+template <typename Row>
+void Text_dump_writer::store_fields(const Row &row) {
+  start_row();
+
+  for (uint32_t idx = 0; idx < m_num_fields; ++idx) {
+    store_field(row, idx);
+  }
+
+  finish_row();
+}
+
 void Text_dump_writer::start_row() {
   buffer()->append_fixed(m_dialect.lines_starting_by);
 }
 
-void Text_dump_writer::store_field(const mysqlshdk::db::IRow *row,
-                                   uint32_t idx) {
+template <typename Row>
+void Text_dump_writer::store_field(const Row &row, uint32_t idx) {
   // TODO(pawel): implement a fixed-row format:
   //              https://dev.mysql.com/doc/refman/8.0/en/load-data.html
 
@@ -178,7 +200,7 @@ void Text_dump_writer::store_field(const mysqlshdk::db::IRow *row,
 
   const char *data = nullptr;
   std::size_t length = 0;
-  row->get_raw_data(idx, &data, &length);
+  row.get_raw_data(idx, &data, &length);
 
   bool is_null = nullptr == data;
 
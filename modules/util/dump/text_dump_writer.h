@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -55,6 +55,9 @@ class Text_dump_writer : public Dump_writer {
 
   void store_row(const mysqlshdk::db::IRow *row) override;
 
+  void store_rows(const mysqlshdk::db::Row_batch &batch,
+                  std::vector<std::size_t> *row_sizes) override;
+
   void store_postamble() override;
 
   void read_metadata(const std::vector<mysqlshdk::db::Column> &metadata,
@@ -62,7 +65,11 @@ class Text_dump_writer : public Dump_writer {
 
   void start_row();
 
-  void store_field(const mysqlshdk::db::IRow *row, uint32_t idx);
+  template <typename Row>
+  void store_fields(const Row &row);
+
+  template <typename Row>
+  void store_field(const Row &row, uint32_t idx);
 
   void quote_field(uint32_t idx);
 
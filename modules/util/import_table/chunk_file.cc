@@ -25,9 +25,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <utility>
 
 #include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_scan.h"
 
 namespace mysqlsh {
 namespace import_table {
@@ -145,6 +148,69 @@ void File_iterator::force_offset(size_t start_from_offset) {
   }
 }
 
+File_iterator find(File_iterator first, File_iterator last,
+                   std::string::const_iterator needle_first,
+                   std::string::const_iterator needle_last,
+                   Find_context<File_iterator::value_type> *context) {
+  assert(context);
+
+  if (needle_first == needle_last) {
+    context->needle_found = true;
+    return first;
+  }
+
+  const auto needle_start = static_cast<uint8_t>(*needle_first);
+
+  while (first != last) {
+    const auto size = first.contiguous_size(last);
+
+    if (size > 0) {
+      const auto begin = first.data();
+      const auto end = begin + size;
+      const auto candidate = shcore::find_char(begin, end, needle_start);
+
+      if (candidate != begin) {
+        // none of the elements before the candidate starts the needle
+        context->preceding_element_set = true;
+        context->preceding_element = candidate[-1];
+        first.advance(candidate - begin);
+
+        if (candidate == end) {
+          continue;
+        }
+      }
+    }
+
+    // first character matches (or buffer is empty), compare the whole needle,
+    // just like the generic version does
+    context->last_element = *first;
+    auto it = first;
+
+    for (auto needle_it = needle_first;; it++, ++needle_it) {
+      if (needle_it == needle_last) {
+        context->needle_found = true;
+        return it;
+      }
+
+      if (it == last) {
+        context->needle_found = false;
+        return last;
+      }
+
+      if (!(*it == static_cast<uint8_t>(*needle_it))) {
+        break;
+      }
+    }
+
+    context->preceding_element_set = true;
+    context->preceding_element = *first;
+    ++first;
+  }
+
+  context->needle_found = false;
+  return last;
+}
+
 File_handler::File_handler(mysqlshdk::storage::IFile *fh) : m_fh(fh) {
   m_fh->open(mysqlshdk::storage::Mode::READ);
   m_file_size = m_fh->file_size();
@@ -227,5 +293,192 @@ void Chunk_file::start() {
   }
 }
 
+void release_queued_files(
+    shcore::Synchronized_queue<File_import_info> *queue) {
+  while (auto task = queue->try_pop(std::chrono::milliseconds::zero())) {
+    delete task->file_handler;
+  }
+}
+
+Decompressed_chunk::Decompressed_chunk(const mysqlshdk::storage::IFile &source,
+                                       std::string data,
+                                       std::function<void()> on_release)
+    : Memory_file(source.filename()),
+      m_full_path(source.full_path()),
+      m_filename(source.filename()),
+      m_on_release(std::move(on_release)) {
+  set_content(std::move(data));
+}
+
+Decompressed_chunk::~Decompressed_chunk() {
+  if (m_on_release) {
+    m_on_release();
+  }
+}
+
+Chunk_compressed_file::Chunk_compressed_file()
+    : m_pending(std::make_shared<Pending_chunks>()) {}
+
+void Chunk_compressed_file::set_chunk_size(const size_t bytes) {
+  constexpr const size_t min_bytes_per_chunk = 2 * BUFFER_SIZE;
+  m_chunk_size = std::max(bytes, min_bytes_per_chunk);
+}
+
+size_t Chunk_compressed_file::find_row_end(const std::string &data,
+                                           size_t from) const {
+  const auto &needle = m_dialect.lines_terminated_by;
+
+  if (needle.empty()) {
+    return std::string::npos;
+  }
+
+  const auto escaped = [&data, this](size_t p) {
+    return !m_dialect.fields_escaped_by.empty() && p > 0 &&
+           data[p - 1] == m_dialect.fields_escaped_by[0];
+  };
+
+  auto p = data.find(needle, from);
+
+  while (std::string::npos != p && escaped(p)) {
+    p = data.find(needle, p + needle.size());
+  }
+
+  return std::string::npos == p ? p : p + needle.size();
+}
+
+bool Chunk_compressed_file::wait_for_free_slot(size_t bytes) {
+  std::unique_lock<std::mutex> lock(m_pending->mutex);
+
+  const auto has_room = [this, bytes]() {
+    if (m_pending->count >= m_max_pending_chunks) {
+      return false;
+    }
+
+    // there's always room for a single chunk, otherwise a chunk bigger than
+    // the limit would never be loaded
+    return 0 == m_pending->count ||
+           m_pending->bytes + bytes <= m_max_pending_bytes;
+  };
+
+  while (!m_pending->released.wait_for(lock, std::chrono::milliseconds(100),
+                                       has_room)) {
+    if (m_stop_condition && m_stop_condition()) {
+      return false;
+    }
+  }
+
+  ++m_pending->count;
+  m_pending->bytes += bytes;
+  return true;
+}
+
+bool Chunk_compressed_file::push_chunk(std::string *data, size_t length) {
+  if (!wait_for_free_slot(length)) {
+    return false;
+  }
+
+  std::string rest = data->substr(length);
+  data->resize(length);
+
+  auto chunk = std::make_unique<Decompressed_chunk>(
+      *m_file_handle, std::move(*data), [pending = m_pending, length]() {
+        {
+          std::lock_guard<std::mutex> lock(pending->mutex);
+          --pending->count;
+          pending->bytes -= length;
+        }
+        pending->released.notify_one();
+      });
+
+  File_import_info info;
+  info.file_path = m_file_handle->full_path().real();
+  info.file_size = length;
+  info.content_size = length;
+  info.file_handler = chunk.release();
+  info.range_read = false;
+  info.is_guard = false;
+  m_queue->push(std::move(info));
+
+  *data = std::move(rest);
+  data->reserve(m_chunk_size + BUFFER_SIZE);
+
+  return true;
+}
+
+void Chunk_compressed_file::start() {
+  assert(m_file_handle);
+  assert(m_queue);
+
+  if (!m_file_handle->is_open()) {
+    m_file_handle->open(mysqlshdk::storage::Mode::READ);
+  }
+
+  const size_t needle_size = m_dialect.lines_terminated_by.size();
+  // position of the next row terminator is searched starting at this offset
+  const auto resume_offset = [needle_size](const std::string &data) {
+    return data.size() < needle_size ? 0 : data.size() - needle_size + 1;
+  };
+
+  std::string data;
+  data.reserve(m_chunk_size + BUFFER_SIZE);
+  size_t search_from = 0;
+  uint64_t rows_to_skip = m_skip_rows_count;
+  bool eof = false;
+
+  while (!eof) {
+    const auto size = data.size();
+    data.resize(size + BUFFER_SIZE);
+    const auto bytes = m_file_handle->read(&data[size], BUFFER_SIZE);
+
+    if (bytes < 0) {
+      m_file_handle->close();
+      throw std::runtime_error("Failed to read from " +
+                               m_file_handle->full_path().masked());
+    }
+
+    data.resize(size + bytes);
+    eof = 0 == bytes;
+
+    while (rows_to_skip > 0) {
+      const auto end = find_row_end(data, search_from);
+
+      if (std::string::npos == end) {
+        search_from = resume_offset(data);
+        break;
+      }
+
+      data.erase(0, end);
+      search_from = 0;
+      --rows_to_skip;
+    }
+
+    if (rows_to_skip > 0) {
+      continue;
+    }
+
+    while (data.size() > m_chunk_size) {
+      const auto end = find_row_end(data, std::max(search_from, m_chunk_size));
+
+      if (std::string::npos == end) {
+        search_from = resume_offset(data);
+        break;
+      }
+
+      if (!push_chunk(&data, end)) {
+        m_file_handle->close();
+        return;
+      }
+
+      search_from = 0;
+    }
+  }
+
+  if (0 == rows_to_skip && !data.empty()) {
+    push_chunk(&data, data.size());
+  }
+
+  m_file_handle->close();
+}
+
 }  // namespace import_table
 }  // namespace mysqlsh
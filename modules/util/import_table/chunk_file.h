@@ -24,16 +24,21 @@
 #ifndef MODULES_UTIL_IMPORT_TABLE_CHUNK_FILE_H_
 #define MODULES_UTIL_IMPORT_TABLE_CHUNK_FILE_H_
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
 
 #include "modules/util/import_table/dialect.h"
 #include "modules/util/import_table/helpers.h"
+#include "mysqlshdk/libs/storage/backend/memory_file.h"
 #include "mysqlshdk/libs/storage/ifile.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
 
@@ -167,6 +172,39 @@ class File_iterator final {
    */
   void force_offset(size_t start_from_offset);
 
+  /**
+   * Pointer to the current position, can be used to access up to
+   * contiguous_size(last) bytes.
+   */
+  const uint8_t *data() const { return m_ptr; }
+
+  /**
+   * Number of bytes which can be accessed via data(), without crossing the
+   * buffer boundary and without going past last.
+   *
+   * @param last Iterator to the last element.
+   */
+  size_t contiguous_size(const File_iterator &last) const {
+    const size_t in_buffer = m_ptr < m_ptr_end ? m_ptr_end - m_ptr : 0;
+    const size_t in_range =
+        last.m_offset > m_offset ? last.m_offset - m_offset : 0;
+    return std::min(in_buffer, in_range);
+  }
+
+  /**
+   * Advances iterator by the given number of bytes, which cannot be greater
+   * than contiguous_size().
+   *
+   * @param count Number of bytes.
+   */
+  void advance(size_t count) {
+    if (count > 0) {
+      m_offset += count - 1;
+      m_ptr += count - 1;
+      ++(*this);
+    }
+  }
+
   ~File_iterator() = default;
 
  private:
@@ -254,6 +292,13 @@ struct File_import_info {
   bool is_guard = true;
 };
 
+/**
+ * Deletes file handles of the tasks which are still in the queue, i.e. when
+ * workers have stopped due to an error. Needs to be called once all workers
+ * have finished.
+ */
+void release_queued_files(shcore::Synchronized_queue<File_import_info> *queue);
+
 /**
  * Stores find() function state for continuation
  *
@@ -336,6 +381,16 @@ ForwardIt find(ForwardIt first, ForwardIt last, ForwardIt2 needle_first,
   }
 }
 
+/**
+ * Specialization of the find() function above for the File_iterator. Instead
+ * of visiting each element, buffered data is scanned in blocks for the first
+ * character of the needle, using vector instructions if available.
+ */
+File_iterator find(File_iterator first, File_iterator last,
+                   std::string::const_iterator needle_first,
+                   std::string::const_iterator needle_last,
+                   Find_context<File_iterator::value_type> *context);
+
 /**
  * Skip count lines/rows delimited by needle.
  *
@@ -528,6 +583,118 @@ class Chunk_file final {
   mysqlshdk::storage::IFile *m_file_handle;
 };
 
+/**
+ * Part of a compressed file, decompressed and held in memory until it's
+ * loaded. Callback is invoked once the chunk is destroyed.
+ */
+class Decompressed_chunk final
+    : public mysqlshdk::storage::backend::Memory_file {
+ public:
+  Decompressed_chunk(const mysqlshdk::storage::IFile &source, std::string data,
+                     std::function<void()> on_release);
+
+  Decompressed_chunk(const Decompressed_chunk &other) = delete;
+  Decompressed_chunk(Decompressed_chunk &&other) = delete;
+
+  Decompressed_chunk &operator=(const Decompressed_chunk &other) = delete;
+  Decompressed_chunk &operator=(Decompressed_chunk &&other) = delete;
+
+  ~Decompressed_chunk() override;
+
+  mysqlshdk::Masked_string full_path() const override { return m_full_path; }
+
+  std::string filename() const override { return m_filename; }
+
+ private:
+  mysqlshdk::Masked_string m_full_path;
+  std::string m_filename;
+  std::function<void()> m_on_release;
+};
+
+/**
+ * Splits a compressed file into chunks which end at a row boundary.
+ *
+ * Compressed files cannot be read starting at an arbitrary offset, so the file
+ * is decompressed sequentially and each chunk is pushed to the output queue as
+ * an in-memory file, which can be loaded by any of the workers. Number and
+ * total size of chunks which were queued but not yet loaded are limited, in
+ * order to bound the memory usage.
+ */
+class Chunk_compressed_file final {
+ public:
+  Chunk_compressed_file();
+  Chunk_compressed_file(const Chunk_compressed_file &other) = delete;
+  Chunk_compressed_file(Chunk_compressed_file &&other) = delete;
+
+  Chunk_compressed_file &operator=(const Chunk_compressed_file &other) = delete;
+  Chunk_compressed_file &operator=(Chunk_compressed_file &&other) = delete;
+
+  ~Chunk_compressed_file() = default;
+
+  void set_chunk_size(const size_t bytes);
+  void set_file_handle(mysqlshdk::storage::IFile *fh) { m_file_handle = fh; }
+  void set_dialect(const Dialect &dialect) { m_dialect = dialect; }
+  void set_rows_to_skip(const size_t rows) { m_skip_rows_count = rows; }
+  void set_output_queue(shcore::Synchronized_queue<File_import_info> *queue) {
+    m_queue = queue;
+  }
+
+  /**
+   * Sets maximum number of chunks which are held in memory.
+   */
+  void set_max_pending_chunks(const size_t count) {
+    m_max_pending_chunks = std::max<size_t>(count, 1);
+  }
+
+  /**
+   * Sets maximum total size of chunks which are held in memory. A single chunk
+   * is always allowed, even if it's bigger than this limit.
+   */
+  void set_max_pending_bytes(const size_t bytes) {
+    m_max_pending_bytes = bytes;
+  }
+
+  /**
+   * Sets callback which is periodically checked while waiting for a chunk to
+   * be released, if it returns true, chunking is aborted.
+   */
+  void set_stop_condition(const std::function<bool()> &callback) {
+    m_stop_condition = callback;
+  }
+
+  void start();
+
+ private:
+  struct Pending_chunks {
+    std::mutex mutex;
+    std::condition_variable released;
+    size_t count = 0;
+    size_t bytes = 0;
+  };
+
+  /**
+   * Finds the first row terminator which starts at or after the given offset.
+   *
+   * @returns offset right after the terminator or std::string::npos.
+   */
+  size_t find_row_end(const std::string &data, size_t from) const;
+
+  bool wait_for_free_slot(size_t bytes);
+
+  bool push_chunk(std::string *data, size_t length);
+
+  size_t m_chunk_size = 2 * BUFFER_SIZE;
+  size_t m_max_pending_chunks = 1;
+  size_t m_max_pending_bytes = std::numeric_limits<size_t>::max();
+  Dialect m_dialect;
+  uint64_t m_skip_rows_count = 0;
+  shcore::Synchronized_queue<File_import_info> *m_queue = nullptr;
+  mysqlshdk::storage::IFile *m_file_handle = nullptr;
+  std::function<bool()> m_stop_condition;
+  // shared with the chunks, which may outlive this object
+  std::shared_ptr<Pending_chunks> m_pending;
+};
+
 }  // namespace import_table
 }  // namespace mysqlsh
 
@@ -42,6 +42,13 @@
 namespace mysqlsh {
 namespace import_table {
 
+namespace {
+
+// limit of the memory used by the decompressed chunks which wait to be loaded
+constexpr size_t k_max_pending_chunk_bytes = 512 * 1024 * 1024;
+
+}  // namespace
+
 Import_table::Import_table(const Import_table_options &options)
     : m_progress_thread("Import table", options.show_progress()),
       m_opt(options),
@@ -53,6 +60,7 @@ Import_table::Import_table(const Import_table_options &options)
 Import_table::~Import_table() {
   m_range_queue.shutdown(m_opt.threads_size());
   join_workers();
+  release_queued_files(&m_range_queue);
 }
 
 void Import_table::join_workers() {
@@ -117,6 +125,25 @@ void Import_table::chunk_file() {
   m_range_queue.shutdown(m_opt.threads_size());
 }
 
+void Import_table::chunk_compressed_file() {
+  Chunk_compressed_file chunk;
+  chunk.set_chunk_size(m_opt.bytes_per_chunk());
+  chunk.set_file_handle(m_opt.file_handle());
+  chunk.set_dialect(m_opt.dialect());
+  chunk.set_rows_to_skip(m_opt.skip_rows_count());
+  chunk.set_output_queue(&m_range_queue);
+  // each worker can load one chunk while the next one is waiting in the queue
+  chunk.set_max_pending_chunks(2 * m_opt.threads_size());
+  // with big chunks, fewer of them are decompressed ahead of the workers
+  chunk.set_max_pending_bytes(k_max_pending_chunk_bytes);
+  chunk.set_stop_condition([this]() {
+    return any_exception() || (m_interrupt && *m_interrupt);
+  });
+  chunk.start();
+
+  m_range_queue.shutdown(m_opt.threads_size());
+}
+
 void Import_table::build_queue() {
   m_total_bytes = 0;
   for (const auto &glob_item : m_opt.filelist_from_user()) {
@@ -185,14 +212,17 @@ void Import_table::import() {
     const std::string &path = m_opt.filelist_from_user()[0];
     const auto extension = std::get<1>(shcore::path::split_extension(path));
     if (extension == ".gz" || extension == ".zst") {
-      // cannot chunk compressed files
-      build_queue();
+      // compressed files cannot be chunked by offset, decompress them in this
+      // thread and let the workers load the decompressed chunks, this is done
+      // also when using a single thread, so that skipRows is always honoured
+      chunk_compressed_file();
     } else {
       chunk_file();
     }
   }
 
   join_workers();
+  release_queued_files(&m_range_queue);
   progress_shutdown();
 }
 
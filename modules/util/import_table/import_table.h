@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2018, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -83,6 +83,7 @@ class Import_table final {
   void spawn_workers();
   void join_workers();
   void chunk_file();
+  void chunk_compressed_file();
   void build_queue();
   void progress_setup();
   void progress_shutdown();
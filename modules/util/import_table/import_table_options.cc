@@ -107,6 +107,11 @@ bool transformation_validation(const std::string &expr) {
 bool has_wildcard(const std::string &s) {
   return s.find('*') != std::string::npos || s.find('?') != std::string::npos;
 }
+
+bool is_compressed(const std::string &path) {
+  const auto extension = std::get<1>(shcore::path::split_extension(path));
+  return extension == ".gz" || extension == ".zst";
+}
 }  // namespace
 
 namespace mysqlsh {
@@ -307,8 +312,9 @@ size_t Import_table_option_pack::calc_thread_size() {
   // We need at least one thread
   int64_t threads_size = std::max(static_cast<int64_t>(1), m_threads_size);
 
-  if (!is_multifile()) {
-    // We do not need to spawn more threads than file chunks
+  if (!is_multifile() && !is_compressed(m_filelist_from_user[0])) {
+    // We do not need to spawn more threads than file chunks, size of the
+    // decompressed data is not known, so compressed files are not limited
     const size_t calculated_threads = (m_file_size / bytes_per_chunk()) + 1;
     if (calculated_threads <
         static_cast<size_t>(std::numeric_limits<int64_t>::max())) {
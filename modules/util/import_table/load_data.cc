@@ -46,6 +46,7 @@ using off64_t = off_t;
 #include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "mysqlshdk/include/shellcore/shell_init.h"
 #include "mysqlshdk/libs/rest/error.h"
+#include "mysqlshdk/libs/storage/read_ahead_file.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
 
@@ -72,6 +73,20 @@ int local_infile_error_nop(void * /* userdata */, char * /* error_msg */,
   return CR_LOAD_DATA_LOCAL_INFILE_REJECTED;
 }
 
+/**
+ * Compressed files are decompressed in a background thread, so that the next
+ * block is ready while the current one is being sent to the server.
+ */
+std::unique_ptr<mysqlshdk::storage::IFile> read_ahead(
+    std::unique_ptr<mysqlshdk::storage::IFile> file) {
+  if (file->is_compressed()) {
+    return std::make_unique<mysqlshdk::storage::Read_ahead_file>(
+        std::move(file));
+  }
+
+  return file;
+}
+
 }  // namespace
 
 void Transaction_buffer::before_query() {
@@ -722,6 +737,7 @@ void Load_data_worker::execute(
             fi.chunk_start = 0;
             fi.bytes_left = 0;
             max_trx_size = m_opt.max_transaction_size();
+            fi.filehandler = read_ahead(std::move(fi.filehandler));
           }
 
           fi.buffer = Transaction_buffer(
@@ -731,7 +747,7 @@ void Load_data_worker::execute(
       } else {
         if (file != nullptr) {
           fi.filename = file->full_path().real();
-          fi.filehandler = std::move(file);
+          fi.filehandler = read_ahead(std::move(file));
           file.reset(nullptr);
           fi.buffer = Transaction_buffer(Transaction_buffer::Dumper_Tx_buffer{},
                                          m_opt.dialect(), fi.filehandler.get(),
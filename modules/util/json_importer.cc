@@ -27,11 +27,18 @@
 #else
 #include <sys/select.h>
 #endif
+#include <algorithm>
 #include <deque>
+#include <exception>
 #include <istream>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
+#include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "mysqlshdk/libs/db/mysqlx/session.h"
 #include "mysqlshdk/libs/db/mysqlx/util/setter_any.h"
+#include "mysqlshdk/libs/utils/logger.h"
 #include "mysqlshdk/libs/utils/utils_buffered_input.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
@@ -180,6 +187,50 @@ Json_importer Prepare_json_import::build() {
  */
 static constexpr const int k_inserts_per_transaction = 8;
 
+namespace {
+
+/**
+ * Returns offset of the first document which begins after the given offset,
+ * or the file size if there is no such document.
+ *
+ * JSON strings cannot contain raw line breaks (parser rejects them), so a
+ * closing brace followed by a line break and an opening brace (with only
+ * whitespace in between) can only separate two top-level documents.
+ */
+size_t find_document_boundary(const std::string &path, size_t offset,
+                              size_t file_size) {
+  shcore::Buffered_input input;
+  input.open(path, offset, file_size - offset);
+
+  bool after_closing_brace = false;
+  bool after_line_break = false;
+
+  while (true) {
+    const auto c = input.peek();
+
+    if (input.eof()) {
+      break;
+    }
+
+    if ('{' == c && after_closing_brace && after_line_break) {
+      return input.offset();
+    }
+
+    if ('\n' == c) {
+      after_line_break = true;
+    } else if (!::isspace(c)) {
+      after_closing_brace = '}' == c;
+      after_line_break = false;
+    }
+
+    input.get();
+  }
+
+  return file_size;
+}
+
+}  // namespace
+
 Json_importer::Json_importer(
     const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session)
     : m_session(session) {
@@ -247,6 +298,12 @@ void Json_importer::load_from(const shcore::Document_reader_options &options) {
 
   if (!m_file_path.empty()) {
     auto full_path = shcore::path::expand_user(m_file_path);
+
+    if (m_threads > 1 && shcore::is_file(full_path)) {
+      load_in_parallel(full_path, options);
+      return;
+    }
+
     input.open(full_path);
   }
 
@@ -255,6 +312,116 @@ void Json_importer::load_from(const shcore::Document_reader_options &options) {
 
 void Json_importer::load_from(shcore::Buffered_input *input,
                               const shcore::Document_reader_options &options) {
+  std::atomic<bool> cancel{false};
+  shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
+    cancel = true;
+    return false;
+  });
+
+  import(input, options, cancel);
+
+  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
+}
+
+void Json_importer::load_in_parallel(
+    const std::string &path, const shcore::Document_reader_options &options) {
+  const auto file_size = shcore::file_size(path);
+  std::vector<size_t> boundaries{0};
+
+  for (int64_t i = 1; i < m_threads && boundaries.back() < file_size; ++i) {
+    boundaries.emplace_back(find_document_boundary(
+        path,
+        std::max(boundaries.back(),
+                 file_size / static_cast<size_t>(m_threads) * i),
+        file_size));
+  }
+
+  if (boundaries.back() < file_size) {
+    boundaries.emplace_back(file_size);
+  }
+
+  const auto chunks = boundaries.size() - 1;
+
+  if (chunks <= 1) {
+    shcore::Buffered_input input{path};
+    load_from(&input, options);
+    return;
+  }
+
+  log_info("Importing JSON documents from '%s' using %zu threads",
+           path.c_str(), chunks);
+
+  std::atomic<bool> cancel{false};
+  shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
+    cancel = true;
+    return false;
+  });
+
+  std::mutex progress_mutex;
+  uint64_t documents_imported = 0;
+  const auto report_progress = [&progress_mutex, &documents_imported,
+                                this](uint64_t documents) {
+    std::lock_guard<std::mutex> lock(progress_mutex);
+    documents_imported += documents;
+
+    if (m_print) {
+      m_print(".. " + std::to_string(documents_imported));
+    }
+  };
+
+  std::vector<std::unique_ptr<Json_importer>> workers(chunks);
+  std::vector<std::exception_ptr> exceptions(chunks);
+  std::vector<std::thread> threads;
+  threads.reserve(chunks);
+
+  for (size_t i = 0; i < chunks; ++i) {
+    threads.emplace_back(mysqlsh::spawn_scoped_thread([&, i]() {
+      try {
+        workers[i] = std::make_unique<Json_importer>(m_session_factory());
+
+        auto &worker = *workers[i];
+        worker.m_batch_insert = m_batch_insert;
+        worker.m_progress = report_progress;
+
+        shcore::Buffered_input input;
+        input.open(path, boundaries[i], boundaries[i + 1] - boundaries[i]);
+
+        worker.import(&input, options, cancel);
+      } catch (...) {
+        exceptions[i] = std::current_exception();
+        cancel = true;
+      }
+    }));
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  m_stats.items_processed = 0;
+  m_stats.bytes_processed = 0;
+
+  for (const auto &worker : workers) {
+    if (worker) {
+      m_stats.items_processed += worker->m_stats.items_processed;
+      m_stats.bytes_processed += worker->m_stats.bytes_processed;
+      m_stats.documents_successfully_imported +=
+          worker->m_stats.documents_successfully_imported;
+    }
+  }
+
+  for (const auto &exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
+}
+
+void Json_importer::import(shcore::Buffered_input *input,
+                           const shcore::Document_reader_options &options,
+                           const std::atomic<bool> &cancel) {
   m_stats.items_processed = 0;
   m_stats.bytes_processed = 0;
   m_packet_size_tracker.inserts_in_this_transaction = 0;
@@ -266,12 +433,6 @@ void Json_importer::load_from(shcore::Buffered_input *input,
 
   m_session->execute("START TRANSACTION");
 
-  bool cancel = false;
-  shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
-    cancel = true;
-    return false;
-  });
-
   shcore::Json_reader reader(input, options);
   reader.parse_bom();
 
@@ -287,8 +448,6 @@ void Json_importer::load_from(shcore::Buffered_input *input,
 
   flush();
   commit(true);
-
-  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
 }
 
 void Json_importer::put(const std::string &item) {
@@ -312,7 +471,9 @@ void Json_importer::update_statistics(xcl::XQuery_result *xquery_result) {
   bool ret = xquery_result->try_get_affected_rows(&affected_rows);
   if (ret) {
     m_stats.documents_successfully_imported += affected_rows;
-    if (m_print) {
+    if (m_progress) {
+      m_progress(affected_rows);
+    } else if (m_print) {
       m_print(".. " + std::to_string(m_stats.documents_successfully_imported));
     }
   }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -24,6 +24,8 @@
 #ifndef MODULES_UTIL_JSON_IMPORTER_H_
 #define MODULES_UTIL_JSON_IMPORTER_H_
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
 #include "mysqlshdk/include/scripting/types.h"
@@ -185,6 +187,9 @@ class Prepare_json_import {
 
 class Json_importer {
  public:
+  using Session_factory =
+      std::function<std::shared_ptr<mysqlshdk::db::mysqlx::Session>()>;
+
   explicit Json_importer(
       const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session);
   ~Json_importer() {}
@@ -201,6 +206,22 @@ class Json_importer {
    * @param path Path to JSON document. Empty path enables read from stdin.
    */
   void set_path(const std::string &path) { m_file_path = path; }
+
+  /**
+   * Set number of threads used to import the documents.
+   *
+   * Multiple threads are used only when importing from a regular file, which
+   * is then split at document boundaries. Each part is parsed and inserted by
+   * a separate thread, using its own X Protocol session.
+   *
+   * @param threads Number of threads.
+   * @param session_factory Creates X Protocol sessions used by the threads.
+   */
+  void set_threads(int64_t threads, const Session_factory &session_factory) {
+    m_threads = threads;
+    m_session_factory = session_factory;
+  }
+
   void load_from(const shcore::Document_reader_options &options);
 
   void print_stats();
@@ -208,6 +229,11 @@ class Json_importer {
  private:
   void load_from(shcore::Buffered_input *input,
                  const shcore::Document_reader_options &options);
+  void load_in_parallel(const std::string &path,
+                        const shcore::Document_reader_options &options);
+  void import(shcore::Buffered_input *input,
+              const shcore::Document_reader_options &options,
+              const std::atomic<bool> &cancel);
   void put(const std::string &item);
   void recv_response(bool block = false);
   void flush();
@@ -287,6 +313,8 @@ class Json_importer {
 #endif
   int m_pending_response = 0;
   std::function<void(const std::string &)> m_print = nullptr;
+  /// Used by the worker threads to report the number of imported documents.
+  std::function<void(uint64_t)> m_progress = nullptr;
 
   struct {
     uint64_t items_processed = 0;
@@ -297,6 +325,9 @@ class Json_importer {
   } m_stats;
 
   std::string m_file_path;  //< Path to JSON document
+
+  int64_t m_threads = 1;
+  Session_factory m_session_factory;
 };
 
 }  // namespace mysqlsh
@@ -84,6 +84,13 @@ static constexpr const int k_supported_dump_version_minor = 0;
 // before we enable sub-chunking for it.
 static constexpr const auto k_chunk_size_overshoot_tolerance = 1.5;
 
+// amount of data per each thread used to recreate indexes of a table
+static constexpr const uint64_t k_index_bytes_per_thread = 10 * 1024 * 1024;
+
+// minimum and maximum values of innodb_ddl_buffer_size
+static constexpr const uint64_t k_min_ddl_buffer_size = 65536;
+static constexpr const uint64_t k_max_ddl_buffer_size = 4294967295;
+
 namespace {
 
 bool histograms_supported(const Version &version) {
@@ -925,6 +932,51 @@ bool Dump_loader::Worker::Index_recreation_task::execute(
     }
 
     try {
+      // number of threads used by the server was already accounted for by the
+      // scheduler (task's weight), make sure server uses the same number
+      auto &budget = loader->m_index_build_budget;
+      const auto ddl_threads = weight();
+      uint64_t buffer_size = 0;
+      bool ddl_settings_changed = false;
+
+      if (budget.tunable()) {
+        // each thread gets the default DDL buffer, build waits until memory
+        // used by the concurrent builds fits in the budget
+        buffer_size = budget.acquire_buffer(ddl_threads);
+
+        try {
+          Dump_loader::executef(session,
+                                "SET @@SESSION.innodb_ddl_threads=?, "
+                                "@@SESSION.innodb_parallel_read_threads=?, "
+                                "@@SESSION.innodb_ddl_buffer_size=?",
+                                ddl_threads, ddl_threads, buffer_size);
+          ddl_settings_changed = true;
+        } catch (const std::exception &e) {
+          // not fatal, server defaults are going to be used
+          log_warning("Failed to set DDL session settings for table %s: %s",
+                      key().c_str(), e.what());
+        }
+      }
+
+      shcore::on_leave_scope restore_ddl_settings([&session, &budget,
+                                                   buffer_size,
+                                                   ddl_settings_changed]() {
+        budget.release_buffer(buffer_size);
+
+        if (ddl_settings_changed) {
+          try {
+            Dump_loader::execute(
+                session,
+                "SET @@SESSION.innodb_ddl_threads=DEFAULT, "
+                "@@SESSION.innodb_parallel_read_threads=DEFAULT, "
+                "@@SESSION.innodb_ddl_buffer_size=DEFAULT");
+          } catch (const std::exception &e) {
+            log_warning("Failed to restore DDL session settings: %s",
+                        e.what());
+          }
+        }
+      });
+
       auto current = batches.begin();
       const auto end = batches.end();
 
@@ -1044,8 +1096,78 @@ void Dump_loader::Worker::schedule(std::unique_ptr<Task> task) {
 
 // ----
 
+Index_build_budget::Index_build_budget(uint64_t threads,
+                                       uint64_t threads_per_add_index,
+                                       uint64_t ddl_threads,
+                                       uint64_t ddl_buffer_size)
+    : m_threads(std::max<uint64_t>(threads, 1)),
+      m_threads_per_add_index(std::max<uint64_t>(threads_per_add_index, 1)),
+      m_ddl_threads(ddl_threads),
+      m_ddl_buffer_size(ddl_buffer_size) {
+  if (tunable()) {
+    m_memory_budget = m_ddl_buffer_size * m_threads;
+  }
+}
+
+uint64_t Index_build_budget::threads(uint64_t table_size) const {
+  uint64_t threads = m_threads_per_add_index;
+
+  if (table_size > 0) {
+    if (tunable()) {
+      // number of threads can be set per session: small tables use a single
+      // thread, so that indexes of many tables can be added in parallel,
+      // while the largest tables use innodb_ddl_threads threads
+      threads = std::clamp<uint64_t>(table_size / k_index_bytes_per_thread, 1,
+                                     m_ddl_threads);
+    } else if (threads > 1 &&
+               table_size / threads <= k_index_bytes_per_thread) {
+      // in case of small tables, we assume that they're not that impactful
+      threads = 1;
+    }
+  }  // else, we don't have the size info, just use the default weight
+
+  return std::min(threads, m_threads);
+}
+
+uint64_t Index_build_budget::acquire_buffer(uint64_t threads) {
+  // server divides the DDL buffer between the DDL threads, buffer is scaled,
+  // so that each thread gets the server's default size
+  const auto size =
+      std::clamp(m_ddl_buffer_size * std::max<uint64_t>(threads, 1),
+                 k_min_ddl_buffer_size, k_max_ddl_buffer_size);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  // a single build is always allowed, even if its buffer exceeds the budget
+  m_memory_released.wait(lock, [this, size]() {
+    return 0 == m_memory_used || m_memory_used + size <= m_memory_budget;
+  });
+
+  m_memory_used += size;
+
+  return size;
+}
+
+void Index_build_budget::release_buffer(uint64_t size) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert(m_memory_used >= size);
+    m_memory_used -= size;
+  }
+
+  m_memory_released.notify_all();
+}
+
+uint64_t Index_build_budget::memory_used() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_memory_used;
+}
+
 Dump_loader::Dump_loader(const Load_dump_options &options)
     : m_options(options),
+      m_index_build_budget(options.threads_count(),
+                           options.threads_per_add_index(),
+                           options.ddl_threads(), options.ddl_buffer_size()),
       m_num_threads_loading(0),
       m_num_threads_recreating_indexes(0),
       m_character_set(options.character_set()),
@@ -3304,19 +3426,8 @@ Dump_loader::Task_ptr Dump_loader::recreate_indexes(
   assert(!schema.empty());
   assert(!table.empty());
 
-  uint64_t weight = m_options.threads_per_add_index();
-
-  if (weight > 1) {
-    if (auto table_size = m_dump->table_data_size(schema, table)) {
-      // size per each thread
-      table_size /= weight;
-
-      // in case of small tables, we assume that they're not that impactful
-      if (table_size <= 10 * 1024 * 1024) {  // 10MiB
-        weight = 1;
-      }
-    }  // else, we don't have the size info, just use the default weight
-  }
+  uint64_t weight =
+      m_index_build_budget.threads(m_dump->table_data_size(schema, table));
 
   DBUG_EXECUTE_IF("dump_loader_force_index_weight", { weight = 4; });
 
@@ -25,8 +25,11 @@
 #define MODULES_UTIL_LOAD_DUMP_LOADER_H_
 
 #include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <regex>
 #include <set>
@@ -51,6 +54,79 @@
 
 namespace mysqlsh {
 
+/**
+ * Decides how many threads are used by the server to recreate the indexes of
+ * a table, and how large DDL buffer each of these index builds gets, keeping
+ * track of the memory used by all the concurrent builds.
+ */
+class Index_build_budget final {
+ public:
+  /**
+   * @param threads number of loader threads
+   * @param threads_per_add_index default number of threads used by the server
+   *        to execute ALTER TABLE ... ADD INDEX
+   * @param ddl_threads global value of innodb_ddl_threads, 0 if not supported
+   * @param ddl_buffer_size global value of innodb_ddl_buffer_size, 0 if not
+   *        supported
+   */
+  Index_build_budget(uint64_t threads, uint64_t threads_per_add_index,
+                     uint64_t ddl_threads, uint64_t ddl_buffer_size);
+
+  Index_build_budget(const Index_build_budget &) = delete;
+  Index_build_budget(Index_build_budget &&) = delete;
+
+  Index_build_budget &operator=(const Index_build_budget &) = delete;
+  Index_build_budget &operator=(Index_build_budget &&) = delete;
+
+  ~Index_build_budget() = default;
+
+  /**
+   * Whether number of DDL threads and DDL buffer size can be set per build.
+   */
+  bool tunable() const { return m_ddl_threads > 0 && m_ddl_buffer_size > 0; }
+
+  /**
+   * Number of threads used to recreate the indexes of a table, this is also
+   * the weight of the task.
+   *
+   * @param table_size size of the table data, 0 if not known
+   */
+  uint64_t threads(uint64_t table_size) const;
+
+  /**
+   * Reserves the DDL buffer for a build which uses the given number of
+   * threads, each thread gets innodb_ddl_buffer_size. Blocks until the
+   * buffer fits in the memory budget, unless there are no other builds.
+   *
+   * @returns size of the buffer
+   */
+  uint64_t acquire_buffer(uint64_t threads);
+
+  /**
+   * Releases the buffer, wakes up the builds waiting for memory.
+   */
+  void release_buffer(uint64_t size);
+
+  /**
+   * Memory which can be used by all the concurrent builds:
+   * innodb_ddl_buffer_size per each loader thread.
+   */
+  uint64_t memory_budget() const { return m_memory_budget; }
+
+  uint64_t memory_used() const;
+
+ private:
+  const uint64_t m_threads;
+  const uint64_t m_threads_per_add_index;
+  const uint64_t m_ddl_threads;
+  const uint64_t m_ddl_buffer_size;
+  uint64_t m_memory_budget = 0;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_memory_released;
+  uint64_t m_memory_used = 0;
+};
+
 class Dump_loader {
  public:
   Dump_loader() = delete;
@@ -538,6 +614,8 @@ class Dump_loader {
   Priority_queue m_pending_tasks;
   uint64_t m_current_weight = 0;
 
+  Index_build_budget m_index_build_budget;
+
   std::mutex m_tables_being_loaded_mutex;
   std::unordered_multimap<std::string, size_t> m_tables_being_loaded;
   std::atomic<size_t> m_num_threads_loading;
@@ -399,43 +399,48 @@ std::string Dump_reader::fetch_schema_script(const std::string &schema) const {
 // Thus, smaller tables must get fewer threads allocated so they take longer
 // to load, while bigger threads get more, with the hope that the total time
 // to load all tables is minimized.
-Dump_reader::Candidate Dump_reader::schedule_chunk_proportionally(
+Dump_reader::Table_data_info *
+Dump_reader::Tables_with_data::schedule_chunk_proportionally(
     const std::unordered_multimap<std::string, size_t> &tables_being_loaded,
-    std::unordered_set<Dump_reader::Table_data_info *> *tables_with_data,
-    uint64_t max_concurrent_tables) {
-  if (tables_with_data->empty()) return tables_with_data->end();
+    uint64_t max_concurrent_tables) const {
+  if (empty()) return nullptr;
 
-  std::vector<Candidate> tables_in_progress;
+  const auto not_being_loaded = [&tables_being_loaded](Table_data_info *t) {
+    return tables_being_loaded.find(t->key()) == tables_being_loaded.end();
+  };
 
-  // first check if there's any table that's not being loaded
+  // first check if there's any table that's not being loaded, tables that
+  // were previously scheduled have preference
   {
-    const auto end = tables_with_data->end();
-    auto best = end;
+    Table_data_info *best = nullptr;
+    size_t best_bytes = 0;
 
-    for (auto it = tables_with_data->begin(); it != end; ++it) {
-      if ((*it)->chunks_consumed) {
-        tables_in_progress.emplace_back(it);
-      }
+    for (const auto t : m_in_progress) {
+      if (not_being_loaded(t)) {
+        const auto bytes = t->bytes_available();
 
-      if (tables_being_loaded.find((*it)->key()) == tables_being_loaded.end()) {
-        // table is better if it's bigger and in the same state as the current
-        // best, or if it was previously scheduled and current best was not
-        if (best == end ||
-            ((*it)->bytes_available() > (*best)->bytes_available() &&
-             !(*it)->chunks_consumed == !(*best)->chunks_consumed) ||
-            ((*it)->chunks_consumed && !(*best)->chunks_consumed))
-          best = it;
+        if (!best || bytes > best_bytes) {
+          best = t;
+          best_bytes = bytes;
+        }
       }
     }
 
+    if (best) return best;
+
     // schedule a new table only if we're not exceeding the maximum number of
-    // concurrent tables that can be loaded at the same time
-    if (best != end && (tables_in_progress.size() < max_concurrent_tables ||
-                        (*best)->chunks_consumed)) {
-      return best;
+    // concurrent tables that can be loaded at the same time, biggest first
+    if (m_in_progress.size() < max_concurrent_tables) {
+      for (const auto &t : m_not_started) {
+        if (not_being_loaded(t.second)) {
+          return t.second;
+        }
+      }
     }
   }
 
+  if (m_in_progress.empty()) return nullptr;
+
   // if all available tables are already loaded, then schedule proportionally
   std::unordered_map<std::string, double> worker_weights;
 
@@ -455,31 +460,33 @@ Dump_reader::Candidate Dump_reader::schedule_chunk_proportionally(
     }
   }
 
-  std::vector<std::pair<Candidate, double>> candidate_weights;
+  std::vector<std::pair<Table_data_info *, double>> candidate_weights;
+  candidate_weights.reserve(m_in_progress.size());
 
   // calc ratio of data available per table / total data available
-  double total_bytes_available = std::accumulate(
-      tables_in_progress.begin(), tables_in_progress.end(),
-      static_cast<size_t>(0),
-      [](size_t size, auto it) { return size + (*it)->bytes_available(); });
+  double total_bytes_available = 0;
+
+  for (const auto t : m_in_progress) {
+    const auto bytes = t->bytes_available();
+    candidate_weights.emplace_back(t, bytes);
+    total_bytes_available += bytes;
+  }
+
   if (total_bytes_available > 0) {
-    for (auto it = tables_in_progress.begin(); it != tables_in_progress.end();
-         ++it) {
-      candidate_weights.emplace_back(
-          *it, static_cast<double>((**it)->bytes_available()) /
-                   total_bytes_available);
+    for (auto &cand : candidate_weights) {
+      cand.second /= total_bytes_available;
     }
   } else {
     assert(0);
-    return tables_in_progress.front();
+    return candidate_weights.front().first;
   }
 
   // pick a chunk from the table that has the biggest difference between both
   double best_diff = 0;
-  Candidate best = tables_in_progress.front();
+  auto best = candidate_weights.front().first;
 
   for (const auto &cand : candidate_weights) {
-    const auto it = worker_weights.find((*cand.first)->key());
+    const auto it = worker_weights.find(cand.first->key());
     const auto weight = it == worker_weights.end() ? 0.0 : it->second;
     const auto d = cand.second - weight;
 
@@ -492,35 +499,81 @@ Dump_reader::Candidate Dump_reader::schedule_chunk_proportionally(
   return best;
 }
 
+void Dump_reader::Tables_with_data::insert(Table_data_info *table) {
+  if (table->chunks_consumed) {
+    m_in_progress.emplace(table);
+  } else {
+    erase_not_started(table);
+
+    const auto bytes = table->bytes_available();
+    m_not_started.emplace(bytes, table);
+    m_not_started_bytes.emplace(table, bytes);
+  }
+}
+
+void Dump_reader::Tables_with_data::consume(Table_data_info *table) {
+  if (0 == table->chunks_consumed) {
+    erase_not_started(table);
+  }
+
+  ++table->chunks_consumed;
+
+  if (table->has_data_available()) {
+    m_in_progress.emplace(table);
+  } else {
+    m_in_progress.erase(table);
+  }
+}
+
+void Dump_reader::Tables_with_data::for_each(
+    const std::function<void(Table_data_info *)> &f) const {
+  for (const auto t : m_in_progress) {
+    f(t);
+  }
+
+  for (const auto &t : m_not_started) {
+    f(t.second);
+  }
+}
+
+void Dump_reader::Tables_with_data::erase_not_started(Table_data_info *table) {
+  const auto it = m_not_started_bytes.find(table);
+
+  if (m_not_started_bytes.end() != it) {
+    m_not_started.erase({it->second, table});
+    m_not_started_bytes.erase(it);
+  }
+}
+
 bool Dump_reader::next_table_chunk(
     const std::unordered_multimap<std::string, size_t> &tables_being_loaded,
     std::string *out_schema, std::string *out_table, std::string *out_partition,
     bool *out_chunked, size_t *out_chunk_index, size_t *out_chunks_total,
     std::unique_ptr<mysqlshdk::storage::IFile> *out_file,
     size_t *out_chunk_size, shcore::Dictionary_t *out_options) {
-  auto iter = schedule_chunk_proportionally(
-      tables_being_loaded, &m_tables_with_data, m_options.threads_count());
-
-  if (iter != m_tables_with_data.end()) {
-    *out_schema = (*iter)->owner->schema;
-    *out_table = (*iter)->owner->table;
-    *out_partition = (*iter)->partition;
-    *out_chunked = (*iter)->chunked;
-    *out_chunk_index = (*iter)->chunks_consumed;
-
-    if ((*iter)->last_chunk_seen) {
-      *out_chunks_total = (*iter)->available_chunks.size();
+  const auto table = m_tables_with_data.schedule_chunk_proportionally(
+      tables_being_loaded, m_options.threads_count());
+
+  if (table) {
+    *out_schema = table->owner->schema;
+    *out_table = table->owner->table;
+    *out_partition = table->partition;
+    *out_chunked = table->chunked;
+    *out_chunk_index = table->chunks_consumed;
+
+    if (table->last_chunk_seen) {
+      *out_chunks_total = table->available_chunks.size();
     } else {
       *out_chunks_total = 0;
     }
 
-    const auto &info = (*iter)->available_chunks[*out_chunk_index];
+    const auto &info = table->available_chunks[*out_chunk_index];
     *out_file = m_dir->file(info->name());
     *out_chunk_size = info->size();
-    *out_options = (*iter)->owner->options;
+    *out_options = table->owner->options;
 
-    (*iter)->chunks_consumed++;
-    if (!(*iter)->has_data_available()) m_tables_with_data.erase(iter);
+    m_tables_with_data.consume(table);
+    on_table_state_changed(table->owner);
 
     return true;
   }
@@ -531,52 +584,83 @@ bool Dump_reader::next_table_chunk(
 bool Dump_reader::next_deferred_index(
     std::string *out_schema, std::string *out_table,
     compatibility::Deferred_statements::Index_info **out_indexes) {
-  for (auto &schema : m_contents.schemas) {
-    for (auto &table : schema.second->tables) {
-      if ((!m_options.load_data() || table.second->all_data_loaded()) &&
-          !table.second->indexes_scheduled) {
-        table.second->indexes_scheduled = true;
-        *out_schema = schema.second->schema;
-        *out_table = table.second->table;
-        *out_indexes = &table.second->indexes;
-        return true;
-      }
+  while (!m_index_candidates.empty()) {
+    const auto table = m_index_candidates.top().second;
+    m_index_candidates.pop();
+
+    // state of the table could have changed since it was added to the list
+    if (ready_for_indexes(*table)) {
+      table->indexes_scheduled = true;
+      *out_schema = table->schema;
+      *out_table = table->table;
+      *out_indexes = &table->indexes;
+      on_table_state_changed(table);
+      return true;
     }
   }
+
   return false;
 }
 
 bool Dump_reader::next_table_analyze(std::string *out_schema,
                                      std::string *out_table,
                                      std::vector<Histogram> *out_histograms) {
-  for (auto &schema : m_contents.schemas) {
-    for (auto &table : schema.second->tables) {
-      if ((!m_options.load_data() || table.second->all_data_loaded()) &&
-          table.second->indexes_created && !table.second->analyze_scheduled) {
-        table.second->analyze_scheduled = true;
-        *out_schema = schema.second->schema;
-        *out_table = table.second->table;
-        *out_histograms = table.second->histograms;
-        return true;
-      }
+  while (!m_analyze_candidates.empty()) {
+    const auto table = m_analyze_candidates.front();
+    m_analyze_candidates.pop_front();
+
+    if (ready_for_analyze(*table)) {
+      table->analyze_scheduled = true;
+      *out_schema = table->schema;
+      *out_table = table->table;
+      *out_histograms = table->histograms;
+      on_table_state_changed(table);
+      return true;
     }
   }
+
   return false;
 }
 
 bool Dump_reader::data_available() const { return !m_tables_with_data.empty(); }
 
 bool Dump_reader::work_available() const {
-  for (auto &schema : m_contents.schemas) {
-    for (auto &table : schema.second->tables) {
-      if ((m_options.load_data() && !table.second->all_data_scheduled()) ||
-          !table.second->indexes_scheduled ||
-          !table.second->analyze_scheduled) {
-        return true;
-      }
+  return m_tables_with_pending_work > 0;
+}
+
+bool Dump_reader::ready_for_indexes(const Table_info &table) const {
+  return (!m_options.load_data() || table.all_data_loaded()) &&
+         !table.indexes_scheduled;
+}
+
+bool Dump_reader::ready_for_analyze(const Table_info &table) const {
+  return (!m_options.load_data() || table.all_data_loaded()) &&
+         table.indexes_created && !table.analyze_scheduled;
+}
+
+void Dump_reader::on_table_state_changed(Table_info *table) {
+  if (ready_for_indexes(*table)) {
+    m_index_candidates.emplace(table_data_size(table->schema, table->table),
+                               table);
+  }
+
+  if (ready_for_analyze(*table)) {
+    m_analyze_candidates.emplace_back(table);
+  }
+
+  const auto pending_work =
+      (m_options.load_data() && !table->all_data_scheduled()) ||
+      !table->indexes_scheduled || !table->analyze_scheduled;
+
+  if (pending_work != table->has_pending_work) {
+    table->has_pending_work = pending_work;
+
+    if (pending_work) {
+      ++m_tables_with_pending_work;
+    } else {
+      --m_tables_with_pending_work;
     }
   }
-  return false;
 }
 
 size_t Dump_reader::filtered_data_size() const {
@@ -678,6 +762,7 @@ uint64_t Dump_reader::add_deferred_statements(
   t->second->indexes_scheduled = t->second->indexes_created =
       !m_options.load_deferred_indexes() || stmts.index_info.empty();
   t->second->indexes = std::move(stmts.index_info);
+  on_table_state_changed(t->second.get());
 
   std::move(stmts.foreign_keys.begin(), stmts.foreign_keys.end(),
             std::back_inserter(s->second->foreign_key_queries));
@@ -715,10 +800,10 @@ void Dump_reader::replace_target_schema(const std::string &schema) {
     view.schema = schema;
   }
 
-  for (const auto &table : m_tables_with_data) {
+  m_tables_with_data.for_each([&schema](Table_data_info *table) {
     table->owner->schema = schema;
     table->owner->options->set("schema", shcore::Value(schema));
-  }
+  });
 }
 
 void Dump_reader::validate_options() {
@@ -870,6 +955,7 @@ void Dump_reader::Table_info::update_metadata(const std::string &data,
   }
 
   reader->on_table_metadata_parsed(*this);
+  reader->on_table_state_changed(this);
   md_done = true;
 }
 
@@ -975,7 +1061,10 @@ void Dump_reader::Table_data_info::rescan_data(const Files &files,
     }
   }
 
-  if (found_data) reader->m_tables_with_data.insert(this);
+  if (found_data) {
+    reader->m_tables_with_data.insert(this);
+    reader->on_table_state_changed(owner);
+  }
 }
 
 std::string Dump_reader::View_info::script_name() const {
@@ -1056,7 +1145,11 @@ void Dump_reader::Schema_info::update_metadata(const std::string &data,
             reader->m_options.analyze_tables() ==
             Load_dump_options::Analyze_table_mode::OFF;
 
-        tables.emplace(info->table, std::move(info));
+        const auto table = tables.emplace(info->table, std::move(info));
+
+        if (table.second) {
+          reader->on_table_state_changed(table.first->second.get());
+        }
       }
     }
     log_debug("%s has %zi tables", schema.c_str(), tables.size());
@@ -1434,6 +1527,7 @@ void Dump_reader::on_chunk_loaded(const std::string &schema,
   for (auto &tdi : t->data_info) {
     if (tdi.partition == partition) {
       ++tdi.chunks_loaded;
+      on_table_state_changed(t);
       return;
     }
   }
@@ -1445,7 +1539,9 @@ void Dump_reader::on_chunk_loaded(const std::string &schema,
 
 void Dump_reader::on_index_end(const std::string &schema,
                                const std::string &table) {
-  find_table(schema, table, "indexes were created")->indexes_created = true;
+  const auto t = find_table(schema, table, "indexes were created");
+  t->indexes_created = true;
+  on_table_state_changed(t);
 }
 
 void Dump_reader::on_analyze_end(const std::string &schema,
@@ -24,10 +24,13 @@
 #ifndef MODULES_UTIL_LOAD_DUMP_READER_H_
 #define MODULES_UTIL_LOAD_DUMP_READER_H_
 
+#include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <optional>
+#include <queue>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -333,6 +336,58 @@ class Dump_reader {
     mutable std::string m_key;
   };
 
+  /**
+   * Tables and partitions which have data ready to be loaded.
+   *
+   * Tables which were not scheduled yet are kept sorted by the size of the
+   * available data, tables which are in progress are kept separately, as the
+   * number of such tables is limited by the number of threads.
+   */
+  class Tables_with_data final {
+   public:
+    bool empty() const { return m_in_progress.empty() && m_not_started.empty(); }
+
+    size_t size() const { return m_in_progress.size() + m_not_started.size(); }
+
+    /**
+     * Adds a table, or updates it if new chunks became available.
+     */
+    void insert(Table_data_info *table);
+
+    /**
+     * Marks the next chunk of the given table as consumed.
+     */
+    void consume(Table_data_info *table);
+
+    void for_each(const std::function<void(Table_data_info *)> &f) const;
+
+    /**
+     * Selects the table whose next chunk should be loaded.
+     *
+     * @param tables_being_loaded tables which are being loaded, with the
+     *        number of bytes being loaded for each chunk
+     * @param max_concurrent_tables maximum number of tables which can be
+     *        loaded at the same time
+     *
+     * @returns selected table, nullptr if there's nothing to load
+     */
+    Table_data_info *schedule_chunk_proportionally(
+        const std::unordered_multimap<std::string, size_t>
+            &tables_being_loaded,
+        uint64_t max_concurrent_tables) const;
+
+   private:
+    void erase_not_started(Table_data_info *table);
+
+    // tables which have at least one chunk scheduled
+    std::unordered_set<Table_data_info *> m_in_progress;
+    // tables which were not scheduled yet, biggest first
+    std::set<std::pair<size_t, Table_data_info *>, std::greater<>>
+        m_not_started;
+    // bytes available for each of the tables in m_not_started
+    std::unordered_map<Table_data_info *, size_t> m_not_started_bytes;
+  };
+
   struct Table_info {
     std::string schema;
     std::string table;
@@ -353,6 +408,8 @@ class Dump_reader {
     bool analyze_scheduled = true;
     bool analyze_finished = true;
     bool has_triggers = false;
+    // whether there's still some work to be scheduled for this table
+    bool has_pending_work = false;
 
     std::vector<Table_data_info> data_info;
 
@@ -479,6 +536,16 @@ class Dump_reader {
   Table_info *find_table(const std::string &schema, const std::string &table,
                          const char *context);
 
+  /**
+   * Needs to be called each time state of the table changes, updates the
+   * lists of tables which are ready for further processing.
+   */
+  void on_table_state_changed(Table_info *table);
+
+  bool ready_for_indexes(const Table_info &table) const;
+
+  bool ready_for_analyze(const Table_info &table) const;
+
   std::unique_ptr<mysqlshdk::storage::IDirectory> m_dir;
 
   const Load_dump_options &m_options;
@@ -488,7 +555,16 @@ class Dump_reader {
   size_t m_filtered_data_size = 0;
 
   // Tables and partitions that are ready to be loaded
-  std::unordered_set<Table_data_info *> m_tables_with_data;
+  Tables_with_data m_tables_with_data;
+
+  // Tables which may be ready to have their indexes recreated, or analyzed,
+  // these can contain duplicates or tables which were already scheduled;
+  // indexes of the largest tables are recreated first, as they take longest
+  std::priority_queue<std::pair<size_t, Table_info *>> m_index_candidates;
+  std::deque<Table_info *> m_analyze_candidates;
+
+  // Tables which still have some work to be scheduled
+  uint64_t m_tables_with_pending_work = 0;
 
   // tables which have data to be loaded (possibly partitioned)
   std::atomic<uint64_t> m_tables_to_load{0};
@@ -504,17 +580,6 @@ class Dump_reader {
   // new schema name -> old schema name
   std::optional<std::pair<std::string, std::string>> m_schema_override;
 
-  using Candidate =
-      std::unordered_set<Dump_reader::Table_data_info *>::iterator;
-
-  static Candidate schedule_chunk_proportionally(
-      const std::unordered_multimap<std::string, size_t> &tables_being_loaded,
-      std::unordered_set<Dump_reader::Table_data_info *> *tables_with_data,
-      uint64_t max_concurrent_tables);
-
-#ifdef FRIEND_TEST
-  FRIEND_TEST(Dump_scheduler, load_scheduler);
-#endif
 };
 
 }  // namespace mysqlsh
@@ -432,12 +432,14 @@ void Load_dump_options::set_session(
     // innodb_ddl_threads threads are used during second and third stages, in
     // most cases first stage is executed before the rest, so we're using
     // maximum of these two values
-    m_threads_per_add_index =
-        query(
-            "SELECT GREATEST(@@innodb_parallel_read_threads, "
-            "@@innodb_ddl_threads)")
-            ->fetch_one_or_throw()
-            ->get_uint(0);
+    const auto row = query(
+                         "SELECT GREATEST(@@innodb_parallel_read_threads, "
+                         "@@innodb_ddl_threads), @@innodb_ddl_threads, "
+                         "@@innodb_ddl_buffer_size")
+                         ->fetch_one_or_throw();
+    m_threads_per_add_index = row->get_uint(0);
+    m_ddl_threads = row->get_uint(1);
+    m_ddl_buffer_size = row->get_uint(2);
   }
 }
 
@@ -127,6 +127,10 @@ class Load_dump_options {
 
   uint64_t threads_per_add_index() const { return m_threads_per_add_index; }
 
+  uint64_t ddl_threads() const { return m_ddl_threads; }
+
+  uint64_t ddl_buffer_size() const { return m_ddl_buffer_size; }
+
   uint64_t dump_wait_timeout_ms() const { return m_wait_dump_timeout_ms; }
 
   const std::string &character_set() const { return m_character_set; }
@@ -297,6 +301,12 @@ class Load_dump_options {
 
   // how many threads are used by the server per one ALTER TABLE ... ADD INDEX
   uint64_t m_threads_per_add_index = 1;
+
+  // global value of innodb_ddl_threads, 0 if not supported
+  uint64_t m_ddl_threads = 0;
+
+  // global value of innodb_ddl_buffer_size, 0 if not supported
+  uint64_t m_ddl_buffer_size = 0;
 };
 
 }  // namespace mysqlsh
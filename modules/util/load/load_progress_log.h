@@ -28,6 +28,7 @@
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -36,7 +37,9 @@
 #include "modules/util/load/load_errors.h"
 #include "mysqlshdk/include/scripting/types.h"
 #include "mysqlshdk/libs/storage/backend/memory_file.h"
+#include "mysqlshdk/libs/storage/idirectory.h"
 #include "mysqlshdk/libs/storage/ifile.h"
+#include "mysqlshdk/libs/utils/logger.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_json.h"
@@ -54,6 +57,11 @@ class Load_progress_log final {
     uint64_t raw_bytes_completed;
   };
 
+  static constexpr std::size_t k_default_segment_size = 64 * 1024;
+
+  explicit Load_progress_log(std::size_t segment_size = k_default_segment_size)
+      : m_segment_size(segment_size) {}
+
   Progress_status init(std::unique_ptr<mysqlshdk::storage::IFile> file,
                        bool dry_run, bool rewrite_on_flush) {
     mysqlshdk::storage::IFile *existing_file = file.get();
@@ -61,9 +69,18 @@ class Load_progress_log final {
     // rewrite_on_flush is meant for storage backends that do not support
     // neither appending nor flushing partially written contents (e.g. REST
     // based storage services). In that case, we write to an in-memory file
-    // and every time we need to flush, we rewrite the entire file remotely.
+    // and every time we need to flush, new entries are written to a numbered
+    // segment file (<name>.1, <name>.2, ...). Segment is rewritten until it
+    // reaches the segment size, then the next one is started. Segments are
+    // compacted into the main file only when the load is resumed and when it
+    // finishes, main file ends with a marker holding number of the first
+    // segment which needs to be replayed. This way a flush does not need to
+    // upload the whole file, and the main file is written at most twice per
+    // load attempt.
     if (rewrite_on_flush) {
       m_real_file = std::move(file);
+      m_segments_dir = m_real_file->parent();
+      m_use_segments = true;
       auto mem_file =
           std::make_unique<mysqlshdk::storage::backend::Memory_file>("");
       m_memfile_contents = &mem_file->content();
@@ -78,60 +95,32 @@ class Load_progress_log final {
     uint64_t raw_bytes_completed = 0;
 
     if (existing_file && existing_file->exists()) {
-      existing_file->open(mysqlshdk::storage::Mode::READ);
-      data = mysqlshdk::storage::read_file(existing_file);
-      existing_file->close();
-
-      try {
-        shcore::str_itersplit(
-            data,
-            [this, &bytes_completed,
-             &raw_bytes_completed](const std::string &line) -> bool {
-              if (!shcore::str_strip(line).empty()) {
-                shcore::Value doc = shcore::Value::parse(line);
-                shcore::Dictionary_t entry = doc.as_map();
-
-                bool done = entry->get_int("done") != 0;
-
-                std::string key = entry->get_string("op");
-
-                if (entry->has_key("schema"))
-                  key += ":`" + entry->get_string("schema") + "`";
+      // markers are dropped, a new one is written when file is compacted
+      parse(read_contents(existing_file), existing_file, &bytes_completed,
+            &raw_bytes_completed, &data);
+    }
 
-                if (entry->has_key("table"))
-                  key += ":`" + entry->get_string("table") + "`";
+    if (existing_file && m_replay_segments) {
+      const auto dir = existing_file->parent();
+      bool found = false;
 
-                if (entry->has_key("partition"))
-                  key += ":`" + entry->get_string("partition") + "`";
+      for (auto n = m_first_segment;; ++n) {
+        const auto segment = segment_file(dir.get(), *existing_file, n);
 
-                if (entry->has_key("chunk"))
-                  key += ":" + std::to_string(entry->get_int("chunk"));
+        if (!segment->exists()) break;
 
-                if (entry->has_key("subchunk"))
-                  key += ":" + std::to_string(entry->get_int("subchunk"));
+        const auto contents = read_contents(segment.get());
 
-                auto iter = m_last_state.find(key);
-                if (iter == m_last_state.end() || !done) {
-                  m_last_state.emplace(key, Status_details{Status::INTERRUPTED,
-                                                           std::move(entry)});
-                } else {
-                  if (entry->has_key("bytes"))
-                    bytes_completed += entry->get_uint("bytes");
+        if (contents.empty()) break;
 
-                  if (entry->has_key("raw_bytes"))
-                    raw_bytes_completed += entry->get_uint("raw_bytes");
+        parse(contents, segment.get(), &bytes_completed, &raw_bytes_completed);
+        data += contents;
 
-                  iter->second.status = Status::DONE;
-                  iter->second.details = std::move(entry);
-                }
-              }
-              return true;
-            },
-            "\n");
-      } catch (const std::exception &e) {
-        THROW_ERROR(SHERR_LOAD_PROGRESS_FILE_ERROR,
-                    existing_file->full_path().masked().c_str(), e.what());
+        m_segment = n;
+        found = true;
       }
+
+      m_segment_written = found;
     }
 
     status = m_last_state.empty() ? Status::PENDING : Status::INTERRUPTED;
@@ -139,11 +128,19 @@ class Load_progress_log final {
     if (dry_run) {
       m_file.reset();
       m_real_file.reset();
+      m_segments_dir.reset();
     } else {
       m_file->open(mysqlshdk::storage::Mode::WRITE);
       if (!data.empty()) {
         m_file->write(data.data(), data.size());
         m_file->write("\n", 1);  // separator for new attempt
+      }
+
+      if (m_real_file) {
+        // main file needs to have the marker before any segment is written,
+        // this also moves contents of the replayed segments to the main file
+        compact();
+      } else if (!data.empty()) {
         flush();
       }
     }
@@ -157,15 +154,19 @@ class Load_progress_log final {
 
       // m_real_file can be present only if m_file is present
       if (m_real_file) {
-        m_real_file->remove();
-
         auto mem_file =
             std::make_unique<mysqlshdk::storage::backend::Memory_file>("");
         m_memfile_contents = &mem_file->content();
         m_file = std::move(mem_file);
+        m_segment_offset = 0;
       }
 
       m_file->open(mysqlshdk::storage::Mode::WRITE);
+
+      if (m_real_file) {
+        // overwrites the main file and removes all the segments
+        compact();
+      }
     }
 
     m_last_state.clear();
@@ -174,11 +175,15 @@ class Load_progress_log final {
   void cleanup() {
     flush();
 
+    if (m_real_file && m_use_segments &&
+        (m_segment_written || m_first_segment != m_segment)) {
+      compact();
+    }
+
     if (m_file) {
       m_file->close();
     }
   }
-
   Status schema_ddl_status(const std::string &schema) const {
     auto it = m_last_state.find("SCHEMA-DDL:`" + schema + "`");
     if (it == m_last_state.end()) return Status::PENDING;
@@ -334,12 +339,127 @@ class Load_progress_log final {
     shcore::Dictionary_t details;
   };
 
+  static constexpr const char *k_segments_marker = "SEGMENTS";
+
+  // Version of the progress file format:
+  //  1 - entries only, no version is stored
+  //  2 - main file ends with the segments marker, which holds the version;
+  //      entries stored in the listed segments need to be replayed
+  // Versions prior to 2 read the "done" field of every entry as an integer,
+  // the marker stores a string there, so that these versions fail to parse
+  // the file and refuse to resume, rather than ignore the progress stored in
+  // the segments.
+  static constexpr uint64_t k_format_version = 2;
+  static constexpr const char *k_segments_marker_done = "segments";
+
   std::unique_ptr<mysqlshdk::storage::IFile> m_file;
   std::unique_ptr<mysqlshdk::storage::IFile> m_real_file;
   const std::string *m_memfile_contents = nullptr;
 
+  // segments are used only if m_real_file is set
+  std::size_t m_segment_size;
+  std::unique_ptr<mysqlshdk::storage::IDirectory> m_segments_dir;
+  bool m_use_segments = false;
+  // whether segments listed in the main file need to be replayed
+  bool m_replay_segments = false;
+  // first segment which was not compacted into the main file
+  uint64_t m_first_segment = 1;
+  // segment which is currently written
+  uint64_t m_segment = 1;
+  bool m_segment_written = false;
+  // offset of the current segment in m_memfile_contents
+  std::size_t m_segment_offset = 0;
+
   std::unordered_map<std::string, Status_details> m_last_state;
 
+  static std::string read_contents(mysqlshdk::storage::IFile *file) {
+    file->open(mysqlshdk::storage::Mode::READ);
+    auto data = mysqlshdk::storage::read_file(file);
+    file->close();
+    return data;
+  }
+
+  static std::unique_ptr<mysqlshdk::storage::IFile> segment_file(
+      const mysqlshdk::storage::IDirectory *dir,
+      const mysqlshdk::storage::IFile &file, uint64_t segment) {
+    return dir->file(file.filename() + "." + std::to_string(segment));
+  }
+
+  void parse(const std::string &data, mysqlshdk::storage::IFile *file,
+             uint64_t *bytes_completed, uint64_t *raw_bytes_completed,
+             std::string *entries = nullptr) {
+    try {
+      shcore::str_itersplit(
+          data,
+          [this, bytes_completed, raw_bytes_completed,
+           entries](const std::string &line) -> bool {
+            if (!shcore::str_strip(line).empty()) {
+              shcore::Value doc = shcore::Value::parse(line);
+              shcore::Dictionary_t entry = doc.as_map();
+
+              std::string key = entry->get_string("op");
+
+              if (k_segments_marker == key) {
+                const auto version = entry->get_uint("version");
+
+                if (version > k_format_version) {
+                  throw std::runtime_error(
+                      "unsupported format version " + std::to_string(version) +
+                      ", the file was written by a newer version of MySQL "
+                      "Shell");
+                }
+
+                // the last marker is the valid one
+                m_first_segment = m_segment = entry->get_uint("next");
+                m_replay_segments = entry->get_bool("active");
+                return true;
+              }
+
+              if (entries) {
+                entries->append(line).append("\n");
+              }
+
+              bool done = entry->get_int("done") != 0;
+
+              if (entry->has_key("schema"))
+                key += ":`" + entry->get_string("schema") + "`";
+
+              if (entry->has_key("table"))
+                key += ":`" + entry->get_string("table") + "`";
+
+              if (entry->has_key("partition"))
+                key += ":`" + entry->get_string("partition") + "`";
+
+              if (entry->has_key("chunk"))
+                key += ":" + std::to_string(entry->get_int("chunk"));
+
+              if (entry->has_key("subchunk"))
+                key += ":" + std::to_string(entry->get_int("subchunk"));
+
+              auto iter = m_last_state.find(key);
+              if (iter == m_last_state.end() || !done) {
+                m_last_state.emplace(key, Status_details{Status::INTERRUPTED,
+                                                         std::move(entry)});
+              } else {
+                if (entry->has_key("bytes"))
+                  *bytes_completed += entry->get_uint("bytes");
+
+                if (entry->has_key("raw_bytes"))
+                  *raw_bytes_completed += entry->get_uint("raw_bytes");
+
+                iter->second.status = Status::DONE;
+                iter->second.details = std::move(entry);
+              }
+            }
+            return true;
+          },
+          "\n");
+    } catch (const std::exception &e) {
+      THROW_ERROR(SHERR_LOAD_PROGRESS_FILE_ERROR,
+                  file->full_path().masked().c_str(), e.what());
+    }
+  }
+
   void log(bool end, const std::string &op, const std::string &schema = "",
            const std::string &table = "", const std::string &partition = "",
            const Callback &more = {}) {
@@ -440,10 +560,84 @@ class Load_progress_log final {
       m_file->flush();
     }
     if (m_real_file) {
-      m_real_file->open(mysqlshdk::storage::Mode::WRITE);
-      m_real_file->write(m_memfile_contents->data(),
-                         m_memfile_contents->size());
-      m_real_file->close();
+      if (m_use_segments) {
+        try {
+          write_segment();
+          return;
+        } catch (const std::exception &e) {
+          log_warning(
+              "Failed to write segment %s of the load progress file '%s', "
+              "whole file is going to be rewritten from now on: %s",
+              std::to_string(m_segment).c_str(),
+              m_real_file->full_path().masked().c_str(), e.what());
+          m_use_segments = false;
+        }
+      }
+
+      write_main_file();
+    }
+  }
+
+  void write_segment() {
+    const auto size = m_memfile_contents->size() - m_segment_offset;
+
+    if (0 == size) return;
+
+    const auto segment =
+        segment_file(m_segments_dir.get(), *m_real_file, m_segment);
+    segment->open(mysqlshdk::storage::Mode::WRITE);
+    segment->write(m_memfile_contents->data() + m_segment_offset, size);
+    segment->close();
+
+    m_segment_written = true;
+
+    if (size >= m_segment_size) {
+      // segment is full, it's not going to be modified anymore
+      ++m_segment;
+      m_segment_written = false;
+      m_segment_offset = m_memfile_contents->size();
+    }
+  }
+
+  void write_main_file() {
+    Dumper json;
+
+    json.start_object();
+    json.append_string("op", k_segments_marker);
+    json.append_string("done", k_segments_marker_done);
+    json.append_uint64("version", k_format_version);
+    // if segments are not used, skip the current one, it might have been
+    // partially written
+    json.append_uint64("next", m_use_segments ? m_segment : m_segment + 1);
+    json.append_bool("active", m_use_segments);
+    json.end_object();
+
+    const auto marker = json.str() + "\n";
+
+    m_real_file->open(mysqlshdk::storage::Mode::WRITE);
+    m_real_file->write(m_memfile_contents->data(), m_memfile_contents->size());
+    m_real_file->write(marker.data(), marker.size());
+    m_real_file->close();
+  }
+
+  void compact() {
+    const auto first = m_first_segment;
+    const auto last = m_segment_written ? m_segment : m_segment - 1;
+
+    m_first_segment = m_segment = last + 1;
+    m_segment_written = false;
+    m_segment_offset = m_memfile_contents->size();
+
+    // main file holds everything now, segments can be removed
+    write_main_file();
+
+    for (auto n = first; n <= last; ++n) {
+      try {
+        segment_file(m_segments_dir.get(), *m_real_file, n)->remove();
+      } catch (const std::exception &e) {
+        log_debug("Failed to remove segment %s of the load progress file: %s",
+                  std::to_string(n).c_str(), e.what());
+      }
     }
   }
 
@@ -214,6 +214,10 @@ REGISTER_HELP(
 REGISTER_HELP(UTIL_IMPORTJSON_DETAIL5,
               "@li tableColumn: string (default: \"doc\") - name of column in "
               "target table where the imported JSON documents will be stored.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL26,
+              "@li threads: int (default: 1) - Use N threads and X Protocol "
+              "sessions to import the documents. Only used when importing from "
+              "a regular file, which is split at document boundaries.");
 REGISTER_HELP(UTIL_IMPORTJSON_DETAIL6,
               "@li convertBsonTypes: bool (default: false) - enables the BSON "
               "data type conversion.");
@@ -320,6 +324,7 @@ const shcore::Option_pack_def<Import_json_options>
           .optional("collection", &Import_json_options::collection)
           .optional("table", &Import_json_options::table)
           .optional("tableColumn", &Import_json_options::table_column)
+          .optional("threads", &Import_json_options::threads)
           .include(&Import_json_options::doc_reader);
 
   return opts;
@@ -340,6 +345,7 @@ const shcore::Option_pack_def<Import_json_options>
  * $(UTIL_IMPORTJSON_DETAIL3)
  * $(UTIL_IMPORTJSON_DETAIL4)
  * $(UTIL_IMPORTJSON_DETAIL5)
+ * $(UTIL_IMPORTJSON_DETAIL26)
  * $(UTIL_IMPORTJSON_DETAIL6)
  * $(UTIL_IMPORTJSON_DETAIL7)
  * $(UTIL_IMPORTJSON_DETAIL8)
@@ -398,6 +404,11 @@ None Util::import_json(str file, dict options);
 void Util::import_json(
     const std::string &file,
     const shcore::Option_pack_ref<Import_json_options> &options) {
+  if (options->threads < 1) {
+    throw std::invalid_argument(
+        "The value of 'threads' option must be greater than 0.");
+  }
+
   auto shell_session = _shell_core.get_dev_session();
 
   if (!shell_session) {
@@ -465,6 +476,22 @@ void Util::import_json(
     mysqlsh::current_console()->print(msg);
   });
 
+  if (options->threads > 1) {
+    const auto trace_protocol = current_shell_options()->get().trace_protocol;
+
+    importer.set_threads(options->threads, [connection_options,
+                                            trace_protocol]() {
+      auto session = mysqlshdk::db::mysqlx::Session::create();
+
+      if (trace_protocol) {
+        session->enable_protocol_trace(true);
+      }
+
+      session->connect(connection_options);
+      return session;
+    });
+  }
+
   try {
     importer.load_from(options->doc_reader);
   } catch (...) {
@@ -50,6 +50,7 @@ struct Import_json_options {
   std::string table;
   std::string collection;
   std::string table_column;
+  int64_t threads = 1;
   shcore::Document_reader_options doc_reader;
 
   static const shcore::Option_pack_def<Import_json_options> &options();
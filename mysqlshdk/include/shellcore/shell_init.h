@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2019, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -45,7 +45,8 @@ void global_end();
 /**
  * This class is used for proper libmysqlclient data structures initialization
  * and deinitialization (using RAII) when connecting to MySQL Server from
- * threads.
+ * threads. Objects can be nested, only the outermost one initializes the
+ * thread.
  */
 class Mysql_thread final {
  public:
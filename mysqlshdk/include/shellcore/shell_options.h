@@ -32,6 +32,7 @@
 #define SHCORE_INTERACTIVE "interactive"
 #define SHCORE_SHOW_WARNINGS "showWarnings"
 #define SHCORE_BATCH_CONTINUE_ON_ERROR "batchContinueOnError"
+#define SHCORE_BULK_SOURCE "bulkSource"
 #define SHCORE_USE_WIZARDS "useWizards"
 
 #define SHCORE_SANDBOX_DIR "sandboxDir"
@@ -132,6 +133,7 @@ class Shell_options final : public shcore::Options {
     mysqlsh::SessionType session_type = mysqlsh::SessionType::Auto;
     bool default_session_type = true;
     bool force = false;
+    bool bulk_source = false;
     bool interactive = false;
     bool full_interactive = false;
     bool passwords_from_stdin = false;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015, 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2015, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -90,8 +90,9 @@ class Resultset_printer {
   virtual void raw_print(const std::string &s) = 0;
 };
 
-#define RESULTSET_DUMPER_FORMATS \
-  "table, tabbed, vertical, json, ndjson, json/raw, json/array, json/pretty"
+#define RESULTSET_DUMPER_FORMATS                                       \
+  "table, tabbed, csv, vertical, json, ndjson, json/raw, json/array, " \
+  "json/pretty"
 /**
  * Base dumper class which implements text-formatting logic for various output
  * formats. Has no public interface, making it essentially abstract, needs to
@@ -113,6 +114,7 @@ class Resultset_dumper_base {
                         const std::string &format);
 
   size_t dump_tabbed();
+  size_t dump_csv();
   size_t dump_table();
   size_t dump_vertical();
   size_t dump_documents(bool is_doc_result);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2014, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2014, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -97,6 +97,26 @@ class SHCORE_PUBLIC Shell_sql : public Shell_language {
     mysqlshdk::utils::Sql_splitter *old_splitter;
   };
 
+  // Statements which are sent to the server together in bulk source mode
+  struct Statement_batch {
+    std::string sql;
+    // offset in sql and line number of each statement
+    std::vector<std::pair<size_t, size_t>> statements;
+
+    bool empty() const { return statements.empty(); }
+
+    void add(const std::string &statement, size_t line_num) {
+      if (!empty()) sql.append(";\n");
+      statements.emplace_back(sql.size(), line_num);
+      sql.append(statement);
+    }
+
+    void clear() {
+      sql.clear();
+      statements.clear();
+    }
+  };
+
   std::string *m_buffer = nullptr;
   mysqlshdk::utils::Sql_splitter *m_splitter = nullptr;
   Context m_base_context;
@@ -109,6 +129,9 @@ class SHCORE_PUBLIC Shell_sql : public Shell_language {
                    std::shared_ptr<mysqlshdk::db::ISession> session,
                    mysqlshdk::utils::Sql_splitter *splitter);
 
+  bool execute_batch(Statement_batch *batch,
+                     const std::shared_ptr<mysqlshdk::db::ISession> &session);
+
   std::pair<size_t, bool> handle_command(const char *p, size_t len, bool bol);
 
   void cmd_process_file(const std::vector<std::string> &params);
@@ -245,6 +245,43 @@ const IRow *Result::fetch_one() {
   return nullptr;
 }
 
+std::size_t Result::fetch_batch(Row_batch *batch, std::size_t max_rows,
+                                std::size_t max_bytes) {
+  std::shared_ptr<MYSQL_RES> res = _result.lock();
+
+  if (!res || _pre_fetched || _pre_fetched_clear_at_end || !has_resultset()) {
+    return IResult::fetch_batch(batch, max_rows, max_bytes);
+  }
+
+  // copy the rows directly from the client library, avoids going through the
+  // IRow interface for each field
+  batch->reset(static_cast<uint32_t>(_metadata.size()));
+
+  while (batch->size() < max_rows && batch->data_size() < max_bytes) {
+    MYSQL_ROW mysql_row = mysql_fetch_row(res.get());
+
+    if (!mysql_row) {
+      _row.reset();
+
+      if (auto session = _session.lock()) {
+        int code = 0;
+        const char *state;
+        const char *err = session->get_last_error(&code, &state);
+        if (code != 0) throw mysqlshdk::db::Error(err, code, state);
+      }
+
+      break;
+    }
+
+    batch->append(mysql_row, mysql_fetch_lengths(res.get()));
+
+    // Each read row increases the count
+    _fetched_row_count++;
+  }
+
+  return batch->size();
+}
+
 bool Result::next_resultset() {
   bool ret_val = false;
 
@@ -52,6 +52,8 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
 
   // Data Retrieving
   virtual const IRow *fetch_one();
+  std::size_t fetch_batch(Row_batch *batch, std::size_t max_rows,
+                          std::size_t max_bytes) override;
   virtual bool next_resultset();
   virtual std::unique_ptr<Warning> fetch_one_warning();
 
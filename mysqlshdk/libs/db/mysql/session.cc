@@ -420,6 +420,64 @@ void Session_impl::execute(const char *sql, size_t len) {
   auto result = run_sql(sql, len, true, false);
 }
 
+void Session_impl::execute_batch(
+    const char *sql, size_t len, size_t *executed,
+    const std::function<void(const char *)> &on_executed) {
+  if (_mysql == nullptr) throw std::runtime_error("Not connected");
+  *executed = 0;
+
+  if (_prev_result) {
+    _prev_result.reset();
+  } else {
+    MYSQL_RES *unread_result = mysql_use_result(_mysql);
+    mysql_free_result(unread_result);
+  }
+
+  // Discards any pending result
+  while (mysql_next_result(_mysql) == 0) {
+    MYSQL_RES *trailing_result = mysql_use_result(_mysql);
+    mysql_free_result(trailing_result);
+  }
+
+  const auto throw_error = [this, sql, len]() {
+    auto err =
+        Error(mysql_error(_mysql), mysql_errno(_mysql), mysql_sqlstate(_mysql));
+    shcore::current_log_sql()->log(get_thread_id(), sql, len, err);
+    DBUG_LOG("sql", get_thread_id() << ": ERROR: " << err.format());
+    throw err;
+  };
+
+  // multi-statements are enabled only for the duration of the batch, so that
+  // regular queries keep being rejected if they contain several statements
+  if (mysql_set_server_option(_mysql, MYSQL_OPTION_MULTI_STATEMENTS_ON) != 0)
+    throw_error();
+
+  shcore::on_leave_scope disable_multi_statements([this]() {
+    mysql_set_server_option(_mysql, MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+  });
+
+  shcore::current_log_sql()->log(get_thread_id(), sql, len);
+
+  DBUG_LOG("sqlall", get_thread_id() << ": QUERY: " << std::string(sql, len));
+
+  int status = mysql_real_query(_mysql, sql, len);
+
+  while (status == 0) {
+    // statements in a batch are not expected to produce a result, if any of
+    // them does, it is discarded
+    MYSQL_RES *result = mysql_use_result(_mysql);
+    mysql_free_result(result);
+    ++*executed;
+
+    if (on_executed) on_executed(mysql_info(_mysql));
+
+    // 0 - more results, -1 - no more results, >0 - error
+    status = mysql_next_result(_mysql);
+  }
+
+  if (status > 0) throw_error();
+}
+
 std::shared_ptr<IResult> Session_impl::run_sql(const char *sql, size_t len,
                                                bool buffered, bool is_udf) {
   if (_mysql == nullptr) throw std::runtime_error("Not connected");
@@ -69,6 +69,9 @@ class Session_impl : public std::enable_shared_from_this<Session_impl> {
 
   inline void execute(const char *sql) { execute(sql, ::strlen(sql)); }
 
+  void execute_batch(const char *sql, size_t len, size_t *executed,
+                     const std::function<void(const char *)> &on_executed);
+
   void start_transaction();
   void commit();
   void rollback();
@@ -212,6 +215,27 @@ class SHCORE_PUBLIC Session : public ISession,
     _impl->execute(sql, len);
   }
 
+  /**
+   * Sends a batch of statements to the server in a single multi-statement
+   * packet, discarding their results.
+   *
+   * @param sql statements to be executed, separated with ';'
+   * @param len length of the SQL
+   * @param executed set to the number of statements which were executed
+   *        successfully
+   * @param on_executed called after each successful statement with its
+   *        information string (e.g. number of inserted records), which may be
+   *        nullptr
+   *
+   * @throws Error if any of the statements fails, execution stops at the
+   *         failed statement, which is the one at index *executed.
+   */
+  void execute_batch(
+      const char *sql, size_t len, size_t *executed,
+      const std::function<void(const char *)> &on_executed = {}) {
+    _impl->execute_batch(sql, len, executed, on_executed);
+  }
+
   const char *get_ssl_cipher() const override {
     return _impl->get_ssl_cipher();
   }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2017, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -32,6 +32,7 @@
 #include <vector>
 #include "mysqlshdk/libs/db/column.h"
 #include "mysqlshdk/libs/db/row.h"
+#include "mysqlshdk/libs/db/row_batch.h"
 #include "mysqlshdk/libs/db/row_by_name.h"
 #include "mysqlshdk_export.h"
 
@@ -71,6 +72,35 @@ class SHCORE_PUBLIC IResult {
     return row;
   }
 
+  /**
+   * Fetches multiple rows from the resultset, copying their data into the
+   * given batch. Previous contents of the batch are discarded.
+   *
+   * @param batch Receives the fetched rows.
+   * @param max_rows Maximum number of rows to fetch.
+   * @param max_bytes Fetching stops once the batch holds at least that many
+   *                  bytes of data.
+   *
+   * @return Number of fetched rows, 0 if there are no more rows.
+   *
+   * Rows fetched this way are counted by get_fetched_row_count() in the same
+   * way as rows fetched with fetch_one().
+   */
+  virtual std::size_t fetch_batch(Row_batch *batch, std::size_t max_rows,
+                                  std::size_t max_bytes) {
+    batch->reset(static_cast<uint32_t>(get_metadata().size()));
+
+    while (batch->size() < max_rows && batch->data_size() < max_bytes) {
+      const auto row = fetch_one();
+
+      if (!row) break;
+
+      batch->append(*row);
+    }
+
+    return batch->size();
+  }
+
   Row_ref_by_name fetch_one_named_or_throw() {
     return Row_ref_by_name(field_names(), fetch_one_or_throw());
   }
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/db/row_batch.h"
+
+#include <algorithm>
+
+namespace mysqlshdk {
+namespace db {
+
+void Row_batch::reset(uint32_t num_fields) {
+  m_num_fields = num_fields;
+  m_num_rows = 0;
+  m_fields.clear();
+  m_data_size = 0;
+}
+
+void Row_batch::append(const IRow &row) {
+  assert(row.num_fields() == m_num_fields);
+
+  std::vector<const char *> data(m_num_fields);
+  std::vector<std::size_t> lengths(m_num_fields);
+
+  for (uint32_t i = 0; i < m_num_fields; ++i) {
+    row.get_raw_data(i, &data[i], &lengths[i]);
+  }
+
+  append(data.data(), lengths.data());
+}
+
+std::size_t Row_batch::reserve_row(std::size_t data_size) {
+  const auto offset = m_data_size;
+  const auto requested_capacity = m_data_size + data_size;
+
+  if (requested_capacity > m_data_capacity) {
+    auto new_capacity = std::max<std::size_t>(m_data_capacity, 4096);
+
+    while (new_capacity < requested_capacity) {
+      new_capacity <<= 1;
+    }
+
+    auto new_data = std::make_unique<char[]>(new_capacity);
+
+    if (m_data_size > 0) {
+      memcpy(new_data.get(), m_data.get(), m_data_size);
+    }
+
+    m_data = std::move(new_data);
+    m_data_capacity = new_capacity;
+  }
+
+  m_data_size = requested_capacity;
+  m_fields.resize(m_fields.size() + m_num_fields);
+
+  return offset;
+}
+
+}  // namespace db
+}  // namespace mysqlshdk
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_DB_ROW_BATCH_H_
+#define MYSQLSHDK_LIBS_DB_ROW_BATCH_H_
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "mysqlshdk/libs/db/row.h"
+#include "mysqlshdk_export.h"
+
+namespace mysqlshdk {
+namespace db {
+
+/**
+ * A batch of rows fetched from a result, stored in a columnar-offset layout:
+ * data of all fields of all rows is kept in a single contiguous buffer, and
+ * each field is described by its offset and length within that buffer.
+ *
+ * Access to the fields is not virtual, which allows consumers processing large
+ * number of rows to avoid per-row and per-field dispatch of the IRow
+ * interface.
+ */
+class SHCORE_PUBLIC Row_batch final {
+ private:
+  struct Field {
+    std::size_t offset;
+    std::size_t length;
+  };
+
+  static constexpr std::size_t k_null_length =
+      std::numeric_limits<std::size_t>::max();
+
+ public:
+  /**
+   * Lightweight, non-owning reference to a single row in the batch. Valid as
+   * long as the batch is not modified.
+   */
+  class Row_ref final {
+   public:
+    Row_ref(const Row_batch *batch, std::size_t row)
+        : m_batch(batch),
+          m_fields(batch->m_fields.data() + row * batch->m_num_fields) {}
+
+    inline uint32_t num_fields() const noexcept {
+      return m_batch->m_num_fields;
+    }
+
+    inline bool is_null(uint32_t index) const noexcept {
+      assert(index < num_fields());
+      return k_null_length == m_fields[index].length;
+    }
+
+    /**
+     * Same semantics as IRow::get_raw_data(), NULL values are reported as
+     * nullptr data.
+     */
+    inline void get_raw_data(uint32_t index, const char **out_data,
+                             std::size_t *out_size) const noexcept {
+      assert(index < num_fields());
+      const auto &field = m_fields[index];
+
+      if (k_null_length == field.length) {
+        *out_data = nullptr;
+        *out_size = 0;
+      } else {
+        *out_data = m_batch->m_data.get() + field.offset;
+        *out_size = field.length;
+      }
+    }
+
+   private:
+    const Row_batch *m_batch;
+    const Field *m_fields;
+  };
+
+  Row_batch() = default;
+
+  Row_batch(const Row_batch &) = delete;
+  Row_batch(Row_batch &&) = default;
+
+  Row_batch &operator=(const Row_batch &) = delete;
+  Row_batch &operator=(Row_batch &&) = default;
+
+  ~Row_batch() = default;
+
+  /**
+   * Removes all rows, keeping the allocated memory, sets the number of fields
+   * of the subsequently added rows.
+   */
+  void reset(uint32_t num_fields);
+
+  inline uint32_t num_fields() const noexcept { return m_num_fields; }
+
+  inline std::size_t size() const noexcept { return m_num_rows; }
+
+  inline bool empty() const noexcept { return 0 == m_num_rows; }
+
+  /**
+   * Total number of bytes of data held by the fields of all rows.
+   */
+  inline std::size_t data_size() const noexcept { return m_data_size; }
+
+  inline Row_ref row(std::size_t index) const noexcept {
+    assert(index < m_num_rows);
+    return Row_ref(this, index);
+  }
+
+  /**
+   * Copies a row of raw data, as returned by the client library.
+   *
+   * @param data Array of num_fields() pointers to field data, nullptr is NULL.
+   * @param lengths Array of num_fields() lengths of the fields.
+   */
+  template <typename Length>
+  void append(const char *const *data, const Length *lengths) {
+    std::size_t total = 0;
+
+    for (uint32_t i = 0; i < m_num_fields; ++i) {
+      if (data[i]) total += lengths[i];
+    }
+
+    const auto offset = reserve_row(total);
+    auto fields = m_fields.data() + m_num_rows * m_num_fields;
+    auto out = m_data.get() + offset;
+    std::size_t position = offset;
+
+    for (uint32_t i = 0; i < m_num_fields; ++i) {
+      if (data[i]) {
+        const std::size_t length = lengths[i];
+        memcpy(out, data[i], length);
+        out += length;
+
+        fields[i].offset = position;
+        fields[i].length = length;
+
+        position += length;
+      } else {
+        fields[i].offset = position;
+        fields[i].length = k_null_length;
+      }
+    }
+
+    ++m_num_rows;
+  }
+
+  /**
+   * Copies the raw data of the given row.
+   */
+  void append(const IRow &row);
+
+ private:
+  /**
+   * Reserves space for a new row holding the given number of data bytes,
+   * returns offset to the data of the new row.
+   */
+  std::size_t reserve_row(std::size_t data_size);
+
+  uint32_t m_num_fields = 0;
+  std::size_t m_num_rows = 0;
+  std::vector<Field> m_fields;
+  std::unique_ptr<char[]> m_data;
+  std::size_t m_data_size = 0;
+  std::size_t m_data_capacity = 0;
+};
+
+}  // namespace db
+}  // namespace mysqlshdk
+
+#endif  // MYSQLSHDK_LIBS_DB_ROW_BATCH_H_
@@ -51,35 +51,38 @@ namespace db {
 
 #define GET_VALIDATE_TYPE(index, TYPE_CHECK)                                  \
   if (index >= num_fields()) throw FIELD_ERROR(index, "index out of bounds"); \
-  if (_data->fields[index] == nullptr)                                        \
+  if (_data->fields[index].null)                                              \
     throw FIELD_ERROR(index, "field is NULL");                                \
   ftype = get_type(index);                                                    \
   if (!(TYPE_CHECK))                                                          \
     throw FIELD_ERROR1(index, "field type is %s", to_string(ftype).c_str());
 
 Row_copy::Row_copy(const IRow &row) {
+  const auto num_fields = row.num_fields();
+
   _data = std::make_shared<Data>();
-  _data->types.reserve(row.num_fields());
-  _data->fields.reserve(row.num_fields());
+  _data->fields.reserve(num_fields);
 
-  for (uint32_t c = row.num_fields(), i = 0; i < c; i++) {
-    _data->types.emplace_back(row.get_type(i));
+  for (uint32_t i = 0; i < num_fields; i++) {
+    _data->fields.emplace_back(row.get_type(i));
 
     if (row.is_null(i)) {
-      _data->fields.emplace_back(nullptr);
       continue;
     }
 
-    switch (row.get_type(i)) {
+    auto &f = _data->fields.back();
+
+    switch (f.type) {
       case Type::Null:
-        _data->fields.emplace_back(nullptr);
         break;
 
       case Type::Decimal:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<std::string>>(row.get_as_string(i)));
+      case Type::Bit:
+        set_string(i, row.get_as_string(i));
         break;
 
+      case Type::String:
+      case Type::Bytes:
       case Type::Date:
       case Type::DateTime:
       case Type::Time:
@@ -87,55 +90,49 @@ Row_copy::Row_copy(const IRow &row) {
       case Type::Json:
       case Type::Enum:
       case Type::Set:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<std::string>>(row.get_string(i)));
-        break;
-
-      case Type::String:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<std::string>>(row.get_string(i)));
-        break;
-
-      case Type::Bytes:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<std::string>>(row.get_string(i)));
+        set_string(i, row.get_string(i));
         break;
 
       case Type::Integer:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<int64_t>>(row.get_int(i)));
+        f.int_value = row.get_int(i);
+        f.null = false;
         break;
 
       case Type::UInteger:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<uint64_t>>(row.get_uint(i)));
+        f.uint_value = row.get_uint(i);
+        f.null = false;
         break;
 
       case Type::Float:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<float>>(row.get_float(i)));
+        f.float_value = row.get_float(i);
+        f.null = false;
         break;
 
       case Type::Double:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<double>>(row.get_double(i)));
-        break;
-
-      case Type::Bit:
-        _data->fields.emplace_back(
-            std::make_unique<Field_data<std::string>>(row.get_as_string(i)));
+        f.double_value = row.get_double(i);
+        f.null = false;
         break;
     }
   }
 }
 
+void Mem_row::set_string(uint32_t index, std::string_view value) {
+  auto &f = _data->fields[index];
+
+  f.offset = _data->buffer.size();
+  f.length = value.size();
+  f.null = false;
+
+  _data->buffer.append(value.data(), value.size());
+}
+
 Type Mem_row::get_type(uint32_t index) const {
   VALIDATE_INDEX(index);
-  return _data->types[index];
+  return _data->fields[index].type;
 }
 
 uint32_t Mem_row::num_fields() const {
-  return static_cast<uint32_t>(_data->types.size());
+  return static_cast<uint32_t>(_data->fields.size());
 }
 
 std::string Mem_row::get_as_string(uint32_t index) const {
@@ -149,7 +146,7 @@ std::string Mem_row::get_as_string(uint32_t index) const {
 
     case Type::String:
     case Type::Bytes:
-      return get<std::string>(index);
+      return std::string(string_value(index));
 
     case Type::Decimal:
     case Type::Date:
@@ -159,22 +156,22 @@ std::string Mem_row::get_as_string(uint32_t index) const {
     case Type::Json:
     case Type::Enum:
     case Type::Set:
-      return get<std::string>(index);
+      return std::string(string_value(index));
 
     case Type::Integer:
-      return std::to_string(get<int64_t>(index));
+      return std::to_string(field(index).int_value);
 
     case Type::UInteger:
-      return std::to_string(get<uint64_t>(index));
+      return std::to_string(field(index).uint_value);
 
     case Type::Float:
-      return std::to_string(get<float>(index));
+      return std::to_string(field(index).float_value);
 
     case Type::Double:
-      return std::to_string(get<double>(index));
+      return std::to_string(field(index).double_value);
 
     case Type::Bit:
-      return get<std::string>(index);
+      return std::string(string_value(index));
   }
   throw std::invalid_argument("Unknown type in field");
 }
@@ -184,11 +181,11 @@ int64_t Mem_row::get_int(uint32_t index) const {
   std::string dec;
   GET_VALIDATE_TYPE(index, (ftype == Type::Integer || ftype == Type::UInteger ||
                             (ftype == Type::Decimal &&
-                             (dec = get<std::string>(index)).find('.') ==
+                             (dec = std::string(string_value(index))).find('.') ==
                                  std::string::npos)));
 
   if (ftype == Type::UInteger) {
-    uint64_t u = get<uint64_t>(index);
+    uint64_t u = field(index).uint_value;
     if (u > LLONG_MAX) {
       throw FIELD_ERROR(index, "field value out of the allowed range");
     }
@@ -196,7 +193,7 @@ int64_t Mem_row::get_int(uint32_t index) const {
   } else if (ftype == Type::Decimal) {
     return std::stoll(dec);
   }
-  return get<int64_t>(index);
+  return field(index).int_value;
 }
 
 uint64_t Mem_row::get_uint(uint32_t index) const {
@@ -204,11 +201,11 @@ uint64_t Mem_row::get_uint(uint32_t index) const {
   std::string dec;
   GET_VALIDATE_TYPE(index, (ftype == Type::Integer || ftype == Type::UInteger ||
                             (ftype == Type::Decimal &&
-                             (dec = get<std::string>(index)).find('.') ==
+                             (dec = std::string(string_value(index))).find('.') ==
                                  std::string::npos)));
 
   if (ftype == Type::Integer) {
-    int64_t i = get<int64_t>(index);
+    int64_t i = field(index).int_value;
     if (i < 0) {
       throw FIELD_ERROR(index, "field value out of the allowed range");
     }
@@ -219,20 +216,19 @@ uint64_t Mem_row::get_uint(uint32_t index) const {
     }
     return std::stoull(dec);
   }
-  return get<uint64_t>(index);
+  return field(index).uint_value;
 }
 
 std::string Mem_row::get_string(uint32_t index) const {
   Type ftype;
   GET_VALIDATE_TYPE(index, (is_string_type(ftype)));
-  return get<std::string>(index);
+  return std::string(string_value(index));
 }
 
 std::pair<const char *, size_t> Mem_row::get_string_data(uint32_t index) const {
   Type ftype;
   GET_VALIDATE_TYPE(index, (ftype == Type::String || ftype == Type::Bytes));
-  const auto &s =
-      static_cast<Field_data<std::string> *>(_data->fields[index].get())->value;
+  const auto s = string_value(index);
   return {s.data(), s.size()};
 }
 
@@ -241,10 +237,16 @@ void Mem_row::get_raw_data(uint32_t index, const char **out_data,
   if (is_null(index)) {
     *out_data = nullptr;
     *out_size = 0;
-  } else {
+  } else if (const auto type = get_type(index);
+             type >= Type::Integer && type <= Type::Double) {
     m_raw_data_cache = get_as_string(index);
     *out_data = m_raw_data_cache.c_str();
     *out_size = m_raw_data_cache.length();
+  } else {
+    // all other values are stored as strings, no need to copy them
+    const auto s = string_value(index);
+    *out_data = s.data();
+    *out_size = s.size();
   }
 }
 
@@ -255,14 +257,14 @@ float Mem_row::get_float(uint32_t index) const {
   switch (ftype) {
     case Type::Decimal:
       try {
-        return std::stof(get<std::string>(index));
+        return std::stof(std::string(string_value(index)));
       } catch (...) {
         throw FIELD_ERROR(index, "float value out of the allowed range");
       }
     case Type::Double:
-      return static_cast<float>(get<double>(index));
+      return static_cast<float>(field(index).double_value);
     case Type::Float:
-      return get<float>(index);
+      return field(index).float_value;
     default:
       throw std::logic_error("internal error");
   }
@@ -275,14 +277,14 @@ double Mem_row::get_double(uint32_t index) const {
   switch (ftype) {
     case Type::Decimal:
       try {
-        return std::stod(get<std::string>(index));
+        return std::stod(std::string(string_value(index)));
       } catch (const std::exception &e) {
         throw FIELD_ERROR(index, "double value out of the allowed range");
       }
     case Type::Float:
-      return static_cast<double>(get<float>(index));
+      return static_cast<double>(field(index).float_value);
     case Type::Double:
-      return get<double>(index);
+      return field(index).double_value;
     default:
       throw std::logic_error("internal error");
   }
@@ -291,25 +293,23 @@ double Mem_row::get_double(uint32_t index) const {
 std::tuple<uint64_t, int> Mem_row::get_bit(uint32_t index) const {
   Type ftype;
   GET_VALIDATE_TYPE(index, (ftype == Type::Bit));
-  return shcore::string_to_bits(get<std::string>(index));
+  return shcore::string_to_bits(std::string(string_value(index)));
 }
 
 bool Mem_row::is_null(uint32_t index) const {
   VALIDATE_INDEX(index);
-  return _data->fields[index] == nullptr;
+  return _data->fields[index].null;
 }
 
 void Mem_row::add_field(Type type, uint32_t offset) {
-  if (offset > _data->types.size())
+  if (offset > _data->fields.size())
     throw std::invalid_argument("Attempt to insert column past row size");
 
-  _data->types.insert(_data->types.begin() + offset, type);
-  _data->fields.insert(_data->fields.begin() + offset, nullptr);
+  _data->fields.insert(_data->fields.begin() + offset, Field{type});
 }
 
 void Mem_row::add_field(Type type) {
-  _data->types.push_back(type);
-  _data->fields.push_back(nullptr);
+  _data->fields.emplace_back(type);
 }
 
 }  // namespace db
@@ -30,6 +30,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include "mysqlshdk/include/mysqlshdk_export.h"
@@ -74,32 +75,48 @@ class SHCORE_PUBLIC Mem_row : public IRow {
   void add_field(Type type, uint32_t offset);
 
  protected:
-  struct Field_data_ {
-    virtual ~Field_data_() = default;
-  };
+  struct Field {
+    explicit Field(Type t) : type(t) {}
+
+    Type type;
+    bool null = true;
+
+    union {
+      int64_t int_value = 0;
+      uint64_t uint_value;
+      float float_value;
+      double double_value;
+      size_t offset;  //< offset of the string value in Data::buffer
+    };
 
-  template <typename T>
-  struct Field_data : public Field_data_ {
-    explicit Field_data(const T &v) : value(v) {}
-    explicit Field_data(T &&v) noexcept : value(std::move(v)) {}
-    T value;
+    size_t length = 0;  //< length of the string value
   };
 
-  template <typename T>
-  const T &get(size_t field) const {
-    assert(field < _data->fields.size());
-    if (field >= _data->fields.size())
+  const Field &field(uint32_t index) const {
+    assert(index < _data->fields.size());
+    if (index >= _data->fields.size())
       throw std::invalid_argument("Attempt to access invalid field");
-    return static_cast<Field_data<T> *>(_data->fields[field].get())->value;
+    return _data->fields[index];
+  }
+
+  std::string_view string_value(uint32_t index) const {
+    const auto &f = field(index);
+    return {_data->buffer.data() + f.offset, f.length};
   }
 
+  /**
+   * Appends the value to the string buffer of the row and sets the field to
+   * refer to it. Previous value of the field, if any, is not reclaimed.
+   */
+  void set_string(uint32_t index, std::string_view value);
+
   struct Data {
-    std::vector<Type> types;
-    std::vector<std::unique_ptr<Field_data_>> fields;
+    std::vector<Field> fields;
+    std::string buffer;  //< storage of all the string values in the row
 
     Data() = default;
-    explicit Data(std::vector<Type> types_)
-        : types(std::move(types_)), fields(types.size()) {}
+    explicit Data(const std::vector<Type> &types)
+        : fields(types.begin(), types.end()) {}
   };
   std::shared_ptr<Data> _data;
   mutable std::string m_raw_data_cache;
@@ -110,6 +127,9 @@ class SHCORE_PUBLIC Mem_row : public IRow {
  * mysql::Row or mysqlx::Row which are references to data owned by the
  * underlying client library.
  *
+ * Fields are stored in a packed form: numeric values are held in place, while
+ * all the string values share a single buffer allocated for the whole row.
+ *
  * Can be created from the copy-constructor, from any instance of IRow.
  */
 class SHCORE_PUBLIC Row_copy : public Mem_row {
@@ -134,45 +154,47 @@ class SHCORE_PUBLIC Mutable_row : public Mem_row {
   template <class T>
   typename std::enable_if<std::is_integral<T>::value>::type set_field(
       uint32_t index, T &&arg) {
-    if (_data->types[index] == Type::Integer)
-      _data->fields[index] = std::unique_ptr<Field_data_>(
-          new Field_data<int64_t>(std::forward<T>(arg)));
-    else if (_data->types[index] == Type::UInteger)
-      _data->fields[index] = std::unique_ptr<Field_data_>(
-          new Field_data<uint64_t>(std::forward<T>(arg)));
+    auto &f = _data->fields[index];
+    if (f.type == Type::Integer)
+      f.int_value = static_cast<int64_t>(arg);
+    else if (f.type == Type::UInteger)
+      f.uint_value = static_cast<uint64_t>(arg);
     else
       throw std::invalid_argument(
           "Attempt to write integer value to non integer field");
+    f.null = false;
   }
 
   template <class T>
   typename std::enable_if<std::is_floating_point<T>::value>::type set_field(
       uint32_t index, T &&arg) {
-    if (_data->types[index] != Type::Float &&
-        _data->types[index] != Type::Double)
+    auto &f = _data->fields[index];
+    if (f.type == Type::Float)
+      f.float_value = static_cast<float>(arg);
+    else if (f.type == Type::Double)
+      f.double_value = static_cast<double>(arg);
+    else
       throw std::invalid_argument(
           "Attempt to write floating point number to not neither float or "
           "double field.");
-    _data->fields[index] =
-        std::make_unique<Field_data<T>>(std::forward<T>(arg));
+    f.null = false;
   }
 
   template <class T>
   typename std::enable_if<std::is_same<T, std::nullptr_t>::value>::type
   set_field(uint32_t index, T && /*arg*/) {
-    _data->fields[index] = nullptr;
+    _data->fields[index].null = true;
   }
 
   template <class T>
   typename std::enable_if<!std::is_arithmetic<T>::value &&
                           !std::is_same<T, std::nullptr_t>::value>::type
   set_field(uint32_t index, T &&arg) {
-    if (_data->types[index] >= Type::Integer &&
-        _data->types[index] <= Type::Double)
+    if (_data->fields[index].type >= Type::Integer &&
+        _data->fields[index].type <= Type::Double)
       throw std::invalid_argument(
           "Attempt to write arithmetic type to non arithmetic field");
-    _data->fields[index] = std::unique_ptr<Field_data_>(
-        new Field_data<std::string>(std::string(std::forward<T>(arg))));
+    set_string(index, std::string_view(arg));
   }
 
  private:
@@ -24,6 +24,7 @@
 #include "mysqlshdk/libs/rest/rest_service.h"
 
 #include <curl/curl.h>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -49,6 +50,47 @@ static constexpr auto k_application_json = "application/json";
 
 std::string get_user_agent() { return "mysqlsh/" MYSH_VERSION; }
 
+/**
+ * DNS cache and TLS sessions shared by all the REST services. Each thread uses
+ * its own service (and connections), this allows new connections to the same
+ * host to skip the name resolution and to resume the TLS session instead of
+ * performing the full handshake.
+ *
+ * Connection cache is not shared, as libcurl does not support sharing it
+ * between concurrent threads.
+ */
+class Shared_handle final {
+ public:
+  static CURLSH *get() {
+    static Shared_handle s_instance;
+    return s_instance.m_handle.get();
+  }
+
+ private:
+  Shared_handle() : m_handle(curl_share_init(), &curl_share_cleanup) {
+    if (const auto handle = m_handle.get()) {
+      curl_share_setopt(handle, CURLSHOPT_LOCKFUNC, lock);
+      curl_share_setopt(handle, CURLSHOPT_UNLOCKFUNC, unlock);
+      curl_share_setopt(handle, CURLSHOPT_USERDATA, this);
+      curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+      curl_share_setopt(handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    }
+  }
+
+  static void lock(CURL *, curl_lock_data data, curl_lock_access,
+                   void *user_ptr) {
+    static_cast<Shared_handle *>(user_ptr)->m_mutexes[data].lock();
+  }
+
+  static void unlock(CURL *, curl_lock_data data, void *user_ptr) {
+    static_cast<Shared_handle *>(user_ptr)->m_mutexes[data].unlock();
+  }
+
+  std::mutex m_mutexes[CURL_LOCK_DATA_LAST];
+  // needs to be destroyed before the mutexes
+  std::unique_ptr<CURLSH, CURLSHcode (*)(CURLSH *)> m_handle;
+};
+
 size_t request_callback(char *, size_t, size_t, void *) {
   // some older versions of CURL may call this callback when performing
   // POST-like request with Content-Length set to 0
@@ -225,6 +267,9 @@ class Rest_service::Impl {
     // called
     curl_easy_setopt(m_handle.get(), CURLOPT_ERRORBUFFER, m_error_buffer);
 
+    // reuse DNS cache and TLS sessions of other services
+    curl_easy_setopt(m_handle.get(), CURLOPT_SHARE, Shared_handle::get());
+
     verify_ssl(verify);
 
     // Default timeout for HEAD/DELETE: 30000 milliseconds
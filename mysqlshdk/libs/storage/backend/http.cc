@@ -69,6 +69,33 @@ Rest_service *get_rest_service(const Masked_string &base) {
   return service.get();
 }
 
+std::size_t read_range(const Masked_string &base, const std::string &path,
+                       bool use_retry, std::size_t first, std::size_t last,
+                       char *buffer) {
+  const std::string range =
+      "bytes=" + std::to_string(first) + "-" + std::to_string(last);
+  Headers h{{"range", range}};
+
+  auto request = Http_request(path, use_retry, std::move(h));
+  auto response = get_rest_service(base)->get(&request);
+
+  if (Response::Status_code::PARTIAL_CONTENT == response.status) {
+    const auto &content = response.buffer;
+    if (last - first + 1 < content.size()) {
+      throw std::runtime_error("Got more data than expected");
+    }
+    std::copy(content.data(), content.data() + content.size(),
+              reinterpret_cast<uint8_t *>(buffer));
+    return content.size();
+  } else if (Response::Status_code::OK == response.status) {
+    throw std::runtime_error("Range requests are not supported.");
+  } else if (Response::Status_code::RANGE_NOT_SATISFIABLE == response.status) {
+    throw std::runtime_error("Range request " + std::to_string(first) + "-" +
+                             std::to_string(last) + " is out of bounds.");
+  }
+  return 0;
+}
+
 std::size_t span_uri_base(const std::string &uri) {
   if (uri.empty()) {
     throw std::logic_error("URI is empty");
@@ -159,6 +186,7 @@ void Http_object::open(Mode m) {
 
   m_offset = 0;
   m_open_mode = m;
+  m_read_ahead.reset();
 }
 
 bool Http_object::is_open() const { return m_open_mode.has_value(); }
@@ -219,6 +247,7 @@ void Http_object::close() {
 
   m_open_mode.reset();
   m_exists = false;
+  m_read_ahead.reset();
 }
 
 size_t Http_object::file_size() const {
@@ -248,33 +277,25 @@ ssize_t Http_object::read(void *buffer, size_t length) {
   const off64_t fsize = file_size();
   if (m_offset >= fsize) return 0;
 
-  const size_t first = m_offset;
-  const size_t last_unbounded = m_offset + length - 1;
-  // http range request is both sides inclusive
-  const size_t last = std::min(file_size() - 1, last_unbounded);
-  const std::string range =
-      "bytes=" + std::to_string(first) + "-" + std::to_string(last);
-  Headers h{{"range", range}};
-
-  auto request = Http_request(m_path, m_use_retry, std::move(h));
-  auto response = get_rest_service(m_base)->get(&request);
-
-  if (Response::Status_code::PARTIAL_CONTENT == response.status) {
-    const auto &content = response.buffer;
-    if (length < content.size()) {
-      throw std::runtime_error("Got more data than expected");
-    }
-    std::copy(content.data(), content.data() + content.size(),
-              reinterpret_cast<uint8_t *>(buffer));
-    m_offset += content.size();
-    return content.size();
-  } else if (Response::Status_code::OK == response.status) {
-    throw std::runtime_error("Range requests are not supported.");
-  } else if (Response::Status_code::RANGE_NOT_SATISFIABLE == response.status) {
-    throw std::runtime_error("Range request " + std::to_string(first) + "-" +
-                             std::to_string(last) + " is out of bounds.");
+  if (!m_read_ahead) {
+    // REST services are thread-local, data can be fetched by any thread and
+    // the (shared) fetch threads reuse their connections
+    m_read_ahead = std::make_unique<Read_ahead>(
+        [base = m_base, path = m_path,
+         use_retry = m_use_retry]() -> Read_ahead::Fetch {
+          return [base, path, use_retry](off64_t offset, size_t size,
+                                         char *out) {
+            // http range request is both sides inclusive
+            return read_range(base, path, use_retry, offset, offset + size - 1,
+                              out);
+          };
+        },
+        fsize);
   }
-  return 0;
+
+  const auto read = m_read_ahead->read(m_offset, buffer, length);
+  m_offset += read;
+  return read;
 }
 
 ssize_t Http_object::write(const void *buffer, size_t length) {
@@ -32,6 +32,7 @@
 #include "mysqlshdk/libs/rest/rest_service.h"
 #include "mysqlshdk/libs/storage/idirectory.h"
 #include "mysqlshdk/libs/storage/ifile.h"
+#include "mysqlshdk/libs/storage/read_ahead.h"
 
 namespace mysqlshdk {
 namespace storage {
@@ -123,6 +124,7 @@ class Http_object : public IFile {
   bool m_use_retry = false;
   std::string m_buffer;
   Config_ptr m_parent_config;
+  std::unique_ptr<Read_ahead> m_read_ahead;
 };
 
 class Http_directory : public IDirectory {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -25,6 +25,7 @@
 
 #include <iterator>
 #include <string>
+#include <utility>
 
 namespace mysqlshdk {
 namespace storage {
@@ -111,6 +112,8 @@ void Memory_file::remove() {}
 
 void Memory_file::set_content(const std::string &s) { m_content = s; }
 
+void Memory_file::set_content(std::string &&s) { m_content = std::move(s); }
+
 }  // namespace backend
 }  // namespace storage
 }  // namespace mysqlshdk
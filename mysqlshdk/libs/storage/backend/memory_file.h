@@ -74,6 +74,7 @@ class Memory_file : public IFile {
   bool is_local() const override { return true; }
 
   void set_content(const std::string &s);
+  void set_content(std::string &&s);
   const std::string &content() const { return m_content; }
 
  private:
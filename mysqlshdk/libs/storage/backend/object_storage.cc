@@ -23,6 +23,9 @@
 
 #include "mysqlshdk/libs/storage/backend/object_storage.h"
 
+#include <algorithm>
+#include <cassert>
+
 #include "mysqlshdk/libs/rest/error_codes.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 
@@ -31,6 +34,61 @@ namespace storage {
 namespace backend {
 namespace object_storage {
 
+Upload_memory &Upload_memory::instance() {
+  static Upload_memory s_instance;
+  return s_instance;
+}
+
+void Upload_memory::reserve_for(std::size_t part_size,
+                                std::size_t upload_threads) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // all threads are uploading, one more part is being filled
+    m_limit = std::max(m_limit, part_size * (upload_threads + 1));
+  }
+
+  m_cv.notify_all();
+}
+
+void Upload_memory::acquire(std::size_t size,
+                            const std::function<bool()> &can_proceed) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  m_cv.wait(lock, [this, size, &can_proceed]() {
+    return 0 == m_used || m_used + size <= m_limit ||
+           (can_proceed && can_proceed());
+  });
+
+  m_used += size;
+}
+
+void Upload_memory::force_acquire(std::size_t size) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_used += size;
+}
+
+void Upload_memory::release(std::size_t size) {
+  if (0 == size) return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    assert(m_used >= size);
+    m_used -= size;
+  }
+
+  m_cv.notify_all();
+}
+
+std::size_t Upload_memory::used() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_used;
+}
+
+std::size_t Upload_memory::limit() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_limit;
+}
+
 Directory::Directory(const Config_ptr &config, const std::string &name)
     : m_name(name), m_bucket(config->bucket()), m_created(false) {}
 
@@ -305,8 +363,15 @@ void Object::rename(const std::string &new_name) {
 
 void Object::remove() { m_bucket->delete_object(full_path().real()); }
 
+bool Object::flush() {
+  if (m_writer) m_writer->flush();
+  return true;
+}
+
 Object::Writer::Writer(Object *owner, Multipart_object *object)
-    : File_handler(owner), m_is_multipart(false) {
+    : File_handler(owner),
+      m_is_multipart(false),
+      m_uploads(upload_pool()->create_group()) {
   // This is the writer for an already started multipart object
   if (object) {
     m_multipart = *object;
@@ -320,22 +385,38 @@ Object::Writer::Writer(Object *owner, Multipart_object *object)
 
     for (const auto &part : m_parts) {
       m_size += part.size;
+      m_next_part_num = std::max(m_next_part_num, part.part_num + 1);
     }
+
+    Upload_memory::instance().reserve_for(m_object->m_max_part_size,
+                                          k_max_upload_threads);
   }
 }
 
 Object::Writer::~Writer() {
+  stop_uploads();
+  release_buffer();
+
   // if there's a pending multipart upload (in other words multipart upload was
   // started, but close() was not called before writer has been destroyed),
   // attempt to cancel it
   abort_multipart_upload("unexpected inner state");
 }
 
+mysqlshdk::utils::Worker_pool *Object::Writer::upload_pool() {
+  // intentionally leaked, idle threads finish on their own
+  static const auto pool = new mysqlshdk::utils::Worker_pool(k_upload_threads);
+  return pool;
+}
+
 off64_t Object::Writer::seek(off64_t /*offset*/) { return 0; }
 
 off64_t Object::Writer::tell() const { return size(); }
 
 ssize_t Object::Writer::write(const void *buffer, size_t length) {
+  // fail early if any of the background uploads has failed
+  check_upload_error();
+
   const size_t MY_MAX_PART_SIZE = m_object->m_max_part_size;
   size_t to_send = m_buffer.size() + length;
 
@@ -349,60 +430,65 @@ ssize_t Object::Writer::write(const void *buffer, size_t length) {
     }
 
     m_is_multipart = true;
+
+    Upload_memory::instance().reserve_for(MY_MAX_PART_SIZE,
+                                          k_max_upload_threads);
   }
 
   size_t incoming_offset = 0;
   auto incoming = reinterpret_cast<char *>(const_cast<void *>(buffer));
 
-  // This loops handles the upload of N number of chunks of size
-  // MY_MAX_PART_SIZE including the buffered data and the incoming data
+  // This loops schedules the upload of N number of chunks of size
+  // MY_MAX_PART_SIZE including the buffered data and the incoming data, data
+  // is copied, as the parts are uploaded in the background
   while (to_send > MY_MAX_PART_SIZE) {
-    const char *part = nullptr;
+    const auto buffer_space = MY_MAX_PART_SIZE - m_buffer.size();
+    allocate_buffer();
+    m_buffer.append(incoming + incoming_offset, buffer_space);
+    account_buffer();
+    incoming_offset += buffer_space;
 
-    if (!m_buffer.empty()) {
-      // BUFFERED DATA: fills the buffer and sends it
-      const auto buffer_space = MY_MAX_PART_SIZE - m_buffer.size();
-      m_buffer.append(incoming + incoming_offset, buffer_space);
+    upload_buffer();
 
-      part = m_buffer.data();
-      incoming_offset += buffer_space;
-    } else {
-      // NO BUFFERED DATA: sends the data directly from the incoming buffer
-      part = incoming + incoming_offset;
-      incoming_offset += MY_MAX_PART_SIZE;
-    }
-
-    try {
-      m_parts.push_back(m_object->m_bucket->upload_part(
-          m_multipart, m_parts.size() + 1, part, MY_MAX_PART_SIZE));
-    } catch (const rest::Response_error &error) {
-      abort_multipart_upload("failure uploading part", error.format());
-      throw rest::to_exception(error);
-    }
-
-    m_buffer.clear();
     to_send -= MY_MAX_PART_SIZE;
   }
 
   // REMAINING DATA: gets buffered again
   const auto remaining_input = length - incoming_offset;
-  if (remaining_input)
+  if (remaining_input) {
+    allocate_buffer();
     m_buffer.append(incoming + incoming_offset, remaining_input);
+    account_buffer();
+  }
 
   m_size += length;
 
   return length;
 }
 
+void Object::Writer::flush() {
+  wait_for_uploads();
+  check_upload_error();
+}
+
 void Object::Writer::close() {
   if (m_is_multipart) {
-    // MULTIPART UPLOAD STARTED: Sends last part if any and commits the upload
-    try {
-      if (!m_buffer.empty()) {
-        m_parts.push_back(m_object->m_bucket->upload_part(
-            m_multipart, m_parts.size() + 1, m_buffer.data(), m_buffer.size()));
-      }
+    // MULTIPART UPLOAD STARTED: Sends last part if any, waits for all parts
+    // to be uploaded and commits the upload
+    if (!m_buffer.empty()) {
+      upload_buffer();
+    }
+
+    finish_uploads();
+
+    // parts were uploaded out of order
+    std::sort(m_parts.begin(), m_parts.end(),
+              [](const Multipart_object_part &l,
+                 const Multipart_object_part &r) {
+                return l.part_num < r.part_num;
+              });
 
+    try {
       m_object->m_bucket->commit_multipart_upload(m_multipart, m_parts);
     } catch (const rest::Response_error &error) {
       abort_multipart_upload("failure completing the upload", error.format());
@@ -431,8 +517,210 @@ void Object::Writer::close() {
 void Object::Writer::reset() {
   // clean up
   m_is_multipart = false;
-  m_buffer.clear();
+  release_buffer();
   m_parts.clear();
+  m_next_part_num = 1;
+}
+
+void Object::Writer::account_buffer() {
+  const auto capacity = m_buffer.capacity();
+
+  // this memory is already allocated, it's not possible to wait for it
+  if (capacity > m_buffer_memory) {
+    Upload_memory::instance().force_acquire(capacity - m_buffer_memory);
+    m_buffer_memory = capacity;
+  }
+}
+
+void Object::Writer::allocate_buffer() {
+  // buffer of a single part upload grows as needed
+  if (!m_is_multipart || m_buffer_memory > 0) return;
+
+  // blocks if too much memory is used, but only as long as some of our own
+  // parts are being uploaded, otherwise writers which hold the memory could
+  // wait for each other
+  const auto part_size = m_object->m_max_part_size;
+  Upload_memory::instance().acquire(
+      part_size, [this]() { return 0 == m_parts_in_flight; });
+  m_buffer_memory = part_size;
+
+  m_buffer.reserve(part_size);
+  account_buffer();
+}
+
+void Object::Writer::release_buffer() {
+  m_buffer = {};
+  Upload_memory::instance().release(m_buffer_memory);
+  m_buffer_memory = 0;
+}
+
+void Object::Writer::upload_buffer() {
+  bool start_job = false;
+
+  {
+    std::lock_guard<std::mutex> lock(m_upload_mutex);
+
+    // memory of the buffer is now owned by the part
+    m_pending_parts.push_back(
+        {m_next_part_num++, std::move(m_buffer), m_buffer_memory});
+    ++m_parts_in_flight;
+
+    // running jobs take the new part once they're done with the current one,
+    // start another one if limit is not reached yet
+    if (m_upload_jobs < k_max_upload_threads) {
+      ++m_upload_jobs;
+      start_job = true;
+    }
+  }
+
+  if (start_job) {
+    // writer waits for its jobs before it's destroyed
+    upload_pool()->submit(
+        m_uploads, [this]() { upload_parts(); },
+        [this]() {
+          // job was skipped
+          {
+            std::lock_guard<std::mutex> lock(m_upload_mutex);
+            --m_upload_jobs;
+          }
+
+          m_upload_cv.notify_all();
+        });
+  }
+
+  m_buffer = {};
+  m_buffer_memory = 0;
+}
+
+void Object::Writer::upload_parts() {
+  while (true) {
+    Part part;
+
+    {
+      std::lock_guard<std::mutex> lock(m_upload_mutex);
+
+      if (m_pending_parts.empty()) {
+        // done under the same lock which is held when parts are scheduled, a
+        // new part either is taken by this job or starts a new one
+        --m_upload_jobs;
+        break;
+      }
+
+      part = std::move(m_pending_parts.front());
+      m_pending_parts.pop_front();
+    }
+
+    const auto size = part.data.size();
+    Multipart_object_part uploaded;
+    std::exception_ptr error;
+    std::string error_message;
+
+    try {
+      // Bucket can be used by multiple threads, each one uses its own
+      // connection, kept by the pool thread
+      uploaded = m_object->m_bucket->upload_part(m_multipart, part.number,
+                                                 part.data.data(), size);
+    } catch (const rest::Response_error &e) {
+      error_message = e.format();
+      error = std::make_exception_ptr(rest::to_exception(e));
+    } catch (const rest::Connection_error &e) {
+      error_message = e.what();
+      error = std::make_exception_ptr(
+          shcore::Exception::runtime_error(error_message));
+    } catch (const std::exception &e) {
+      error_message = e.what();
+      error = std::current_exception();
+    }
+
+    part.data = {};
+
+    {
+      std::lock_guard<std::mutex> lock(m_upload_mutex);
+
+      --m_parts_in_flight;
+
+      if (error) {
+        if (!m_upload_error) {
+          m_upload_error = error;
+          m_upload_error_message = std::move(error_message);
+        }
+
+        // upload is going to be aborted, remaining parts are not needed
+        discard_pending_parts();
+      } else {
+        m_parts.emplace_back(std::move(uploaded));
+      }
+    }
+
+    // released once part is no longer in flight, so that a writer waiting for
+    // its own parts notices that
+    Upload_memory::instance().release(part.memory);
+
+    m_upload_cv.notify_all();
+  }
+
+  // writer may wait for the jobs to finish
+  m_upload_cv.notify_all();
+}
+
+void Object::Writer::discard_pending_parts() {
+  for (const auto &part : m_pending_parts) {
+    --m_parts_in_flight;
+    Upload_memory::instance().release(part.memory);
+  }
+
+  m_pending_parts.clear();
+}
+
+void Object::Writer::wait_for_uploads() {
+  std::unique_lock<std::mutex> lock(m_upload_mutex);
+
+  // jobs finish once there are no more parts to upload
+  m_upload_cv.wait(lock, [this]() { return 0 == m_upload_jobs; });
+}
+
+void Object::Writer::finish_uploads() {
+  wait_for_uploads();
+  stop_uploads();
+  check_upload_error();
+}
+
+void Object::Writer::stop_uploads() {
+  {
+    std::lock_guard<std::mutex> lock(m_upload_mutex);
+
+    // running jobs finish once they're done with the current part
+    discard_pending_parts();
+  }
+
+  m_uploads->cancel();
+
+  try {
+    m_uploads->wait();
+  } catch (...) {
+    // errors are reported by check_upload_error()
+  }
+
+  // cancelled group cannot be reused
+  m_uploads = upload_pool()->create_group();
+}
+
+void Object::Writer::check_upload_error() {
+  std::exception_ptr error;
+
+  {
+    std::lock_guard<std::mutex> lock(m_upload_mutex);
+
+    if (!m_upload_error) return;
+
+    std::swap(error, m_upload_error);
+  }
+
+  stop_uploads();
+  abort_multipart_upload("failure uploading part", m_upload_error_message);
+  m_upload_error_message.clear();
+
+  std::rethrow_exception(error);
 }
 
 void Object::Writer::abort_multipart_upload(const char *context,
@@ -483,6 +771,25 @@ Object::Reader::Reader(Object *owner) : File_handler(owner), m_offset(0) {
   } catch (const rest::Connection_error &error) {
     throw shcore::Exception::runtime_error(error.what());
   }
+
+  // Bucket outlives the reader and can be shared by the fetch threads, each
+  // one uses its own connection
+  m_read_ahead = std::make_unique<Read_ahead>(
+      [bucket = m_object->m_bucket.get(),
+       name = m_object->full_path().real()]() -> Read_ahead::Fetch {
+        return [bucket, name](off64_t offset, size_t length, char *buffer) {
+          // Creates a response buffer that writes data directly to buffer
+          rest::Static_char_ref_buffer rbuffer(buffer, length);
+
+          try {
+            return bucket->get_object(name, &rbuffer, offset,
+                                      offset + length - 1);
+          } catch (const rest::Response_error &error) {
+            throw rest::to_exception(error);
+          }
+        };
+      },
+      m_size);
 }
 
 off64_t Object::Reader::seek(off64_t offset) {
@@ -496,25 +803,7 @@ off64_t Object::Reader::tell() const {
 }
 
 ssize_t Object::Reader::read(void *buffer, size_t length) {
-  const size_t first = m_offset;
-  const size_t last_unbounded = m_offset + length - 1;
-  const off64_t fsize = m_size;
-
-  if (m_offset >= fsize) return 0;
-
-  const size_t last = std::min(m_size - 1, last_unbounded);
-
-  // Creates a response buffer that writes data directly to buffer
-  rest::Static_char_ref_buffer rbuffer(reinterpret_cast<char *>(buffer),
-                                       length);
-
-  size_t read = 0;
-  try {
-    read = m_object->m_bucket->get_object(m_object->full_path().real(),
-                                          &rbuffer, first, last);
-  } catch (const rest::Response_error &error) {
-    throw rest::to_exception(error);
-  }
+  const auto read = m_read_ahead->read(m_offset, buffer, length);
 
   m_offset += read;
 
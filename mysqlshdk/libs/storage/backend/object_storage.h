@@ -24,11 +24,21 @@
 #ifndef MYSQLSHDK_LIBS_STORAGE_BACKEND_OBJECT_STORAGE_H_
 #define MYSQLSHDK_LIBS_STORAGE_BACKEND_OBJECT_STORAGE_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "mysqlshdk/libs/storage/idirectory.h"
 #include "mysqlshdk/libs/storage/ifile.h"
+#include "mysqlshdk/libs/storage/read_ahead.h"
+#include "mysqlshdk/libs/utils/worker_pool.h"
 
 #include "mysqlshdk/libs/storage/backend/object_storage_bucket.h"
 
@@ -43,6 +53,66 @@ namespace object_storage {
 
 class Config;
 
+/**
+ * Limits the memory used by the buffers of the multipart uploads, shared by
+ * all the writers.
+ *
+ * The limit is at least k_min_limit, and it grows so that each writer is able
+ * to fill a part while all of its upload threads are busy.
+ */
+class Upload_memory final {
+ public:
+  static constexpr std::size_t k_min_limit = 256 * 1024 * 1024;
+
+  explicit Upload_memory(std::size_t limit = k_min_limit) : m_limit(limit) {}
+
+  Upload_memory(const Upload_memory &) = delete;
+  Upload_memory(Upload_memory &&) = delete;
+
+  Upload_memory &operator=(const Upload_memory &) = delete;
+  Upload_memory &operator=(Upload_memory &&) = delete;
+
+  ~Upload_memory() = default;
+
+  /**
+   * Memory limit shared by all the object storage writers.
+   */
+  static Upload_memory &instance();
+
+  /**
+   * Raises the limit (if needed) to allow for a part of the given size being
+   * filled while the given number of parts is being uploaded.
+   */
+  void reserve_for(std::size_t part_size, std::size_t upload_threads);
+
+  /**
+   * Acquires the given amount of memory, blocks if this would exceed the limit.
+   * Memory is acquired regardless of the limit if nothing is used, or if
+   * can_proceed is given and returns true (it's checked each time memory is
+   * released).
+   */
+  void acquire(std::size_t size,
+               const std::function<bool()> &can_proceed = nullptr);
+
+  /**
+   * Acquires the given amount of memory without blocking, used for memory
+   * which was already allocated.
+   */
+  void force_acquire(std::size_t size);
+
+  void release(std::size_t size);
+
+  std::size_t used() const;
+
+  std::size_t limit() const;
+
+ private:
+  mutable std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::size_t m_limit;
+  std::size_t m_used = 0;
+};
+
 /**
  * Emulates a directory behaviour in a Bucket.
  */
@@ -250,9 +320,10 @@ class Object : public mysqlshdk::storage::IFile {
   void remove() override;
 
   /**
-   * Does NOTHING
+   * If the object was opened in WRITE or APPEND mode, waits for the parts
+   * which are being uploaded in the background, otherwise does NOTHING.
    */
-  bool flush() override { return true; }
+  bool flush() override;
 
   bool is_local() const override { return false; }
 
@@ -286,6 +357,14 @@ class Object : public mysqlshdk::storage::IFile {
 
   /**
    * Handler for write operations on an Object
+   *
+   * Parts of a multipart upload are uploaded in the background, by the
+   * threads of a pool shared by all the writers, at most k_max_upload_threads
+   * parts of an object are uploaded at once. All buffers (the one being
+   * filled and the ones waiting to be uploaded) are accounted for in
+   * Upload_memory, the writing thread blocks before allocating a new buffer
+   * if this would exceed the limit, until memory is released or all of its
+   * own parts are uploaded.
    */
   class Writer : public File_handler {
    public:
@@ -295,22 +374,111 @@ class Object : public mysqlshdk::storage::IFile {
     off64_t seek(off64_t offset);
     off64_t tell() const;
     ssize_t write(const void *incoming, size_t length);
+    void flush();
     void close();
 
+    static constexpr std::size_t k_max_upload_threads = 4;
+    static constexpr std::size_t k_upload_threads = 16;
+
+    /**
+     * Pool of k_upload_threads threads shared by all the writers.
+     */
+    static mysqlshdk::utils::Worker_pool *upload_pool();
+
    private:
+    struct Part {
+      std::size_t number;
+      std::string data;
+      // memory acquired for this part
+      std::size_t memory;
+    };
+
     void reset();
 
+    /**
+     * Allocates a buffer for the next part of a multipart upload, blocks if
+     * memory limit is exceeded.
+     */
+    void allocate_buffer();
+
+    /**
+     * Accounts for the memory allocated by the buffer.
+     */
+    void account_buffer();
+
+    /**
+     * Releases the buffer and its memory.
+     */
+    void release_buffer();
+
+    /**
+     * Discards the parts which were not uploaded yet, must be called with the
+     * m_upload_mutex held.
+     */
+    void discard_pending_parts();
+
+    /**
+     * Waits for all the scheduled parts to be uploaded.
+     */
+    void wait_for_uploads();
+
     void abort_multipart_upload(const char *context,
                                 const std::string &error = {});
 
+    /**
+     * Schedules upload of the buffered data as the next part.
+     */
+    void upload_buffer();
+
+    /**
+     * Uploads the scheduled parts until there are none left, executed by the
+     * upload jobs.
+     */
+    void upload_parts();
+
+    /**
+     * Waits for all scheduled parts to be uploaded and stops the upload
+     * jobs. If any of the uploads has failed, multipart upload is aborted
+     * and the error is rethrown.
+     */
+    void finish_uploads();
+
+    /**
+     * Stops the upload jobs, parts which were not uploaded yet are
+     * discarded.
+     */
+    void stop_uploads();
+
+    /**
+     * If any of the uploads has failed, aborts the multipart upload and
+     * rethrows the error.
+     */
+    void check_upload_error();
+
     std::string m_buffer;
+    // memory acquired for m_buffer
+    std::size_t m_buffer_memory = 0;
     bool m_is_multipart;
     Multipart_object m_multipart;
     std::vector<Multipart_object_part> m_parts;
+    std::size_t m_next_part_num = 1;
+
+    // guards the members below, and m_parts while uploads are in progress
+    std::mutex m_upload_mutex;
+    std::condition_variable m_upload_cv;
+    std::deque<Part> m_pending_parts;
+    // parts which are scheduled and not yet uploaded or discarded
+    std::atomic<std::size_t> m_parts_in_flight{0};
+    // jobs which upload the parts of this object
+    std::shared_ptr<mysqlshdk::utils::Worker_pool::Job_group> m_uploads;
+    std::size_t m_upload_jobs = 0;
+    std::exception_ptr m_upload_error;
+    std::string m_upload_error_message;
   };
 
   /**
-   * Handler for read operations on an Object
+   * Handler for read operations on an Object, sequential reads are served by
+   * the read-ahead buffer.
    */
   class Reader : public File_handler {
    public:
@@ -323,6 +491,7 @@ class Object : public mysqlshdk::storage::IFile {
 
    private:
     off64_t m_offset;
+    std::unique_ptr<Read_ahead> m_read_ahead;
   };
 
   std::unique_ptr<Writer> m_writer;
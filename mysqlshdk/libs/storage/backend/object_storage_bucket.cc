@@ -53,6 +53,9 @@ FI_DEFINE(os_put_object, ([](const mysqlshdk::utils::FI::Args &args) {
 
 Bucket::Bucket(const Config_ptr &config) : m_config(config) {
   assert(m_config && m_config->valid());
+  // hash is computed on the first use, do it now, so that threads which
+  // share this instance only read it
+  m_config->hash();
 }
 
 std::vector<Object_details> Bucket::list_objects(
@@ -353,30 +356,19 @@ void Bucket::abort_multipart_upload(const Multipart_object &object) {
 }
 
 rest::Signed_rest_service *Bucket::ensure_connection() {
+  // each thread uses its own REST service, this instance does not hold it, so
+  // it can be used by multiple threads at once
   static thread_local std::unordered_map<
       std::string, std::unique_ptr<rest::Signed_rest_service>>
       services;
 
-  // need to detect when this instance was passed to another thread and replace
-  // the REST service, or we may end up sharing it across multiple threads
-  const auto current_thread = std::this_thread::get_id();
+  auto &service = services[m_config->hash()];
 
-  if (current_thread != m_rest_service_thread) {
-    m_rest_service = nullptr;
+  if (!service) {
+    service = std::make_unique<rest::Signed_rest_service>(*m_config);
   }
 
-  if (!m_rest_service) {
-    auto &service = services[m_config->hash()];
-
-    if (!service) {
-      service = std::make_unique<rest::Signed_rest_service>(*m_config);
-    }
-
-    m_rest_service = service.get();
-    m_rest_service_thread = current_thread;
-  }
-
-  return m_rest_service;
+  return service.get();
 }
 
 }  // namespace object_storage
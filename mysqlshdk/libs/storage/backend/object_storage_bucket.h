@@ -66,6 +66,10 @@ struct Object_details {
   std::string time_created;
 };
 
+/**
+ * Instances can be used by multiple threads at once, each thread uses its own
+ * REST service (and connection).
+ */
 class Bucket {
  public:
   Bucket() = delete;
@@ -299,8 +303,6 @@ class Bucket {
       const Multipart_object &object) = 0;
 
   Config_ptr m_config;
-  rest::Signed_rest_service *m_rest_service = nullptr;
-  std::thread::id m_rest_service_thread;
 };
 
 }  // namespace object_storage
@@ -124,6 +124,11 @@ Compression from_extension(const std::string &e) {
 }
 
 std::unique_ptr<IFile> make_file(std::unique_ptr<IFile> file, Compression c) {
+  return make_file(std::move(file), c, {});
+}
+
+std::unique_ptr<IFile> make_file(std::unique_ptr<IFile> file, Compression c,
+                                 const Compression_options &options) {
   std::unique_ptr<IFile> result;
 
   switch (c) {
@@ -132,11 +137,12 @@ std::unique_ptr<IFile> make_file(std::unique_ptr<IFile> file, Compression c) {
       break;
 
     case Compression::GZIP:
-      result = std::make_unique<compression::Gz_file>(std::move(file));
+      result = std::make_unique<compression::Gz_file>(std::move(file), options);
       break;
 
     case Compression::ZSTD:
-      result = std::make_unique<compression::Zstd_file>(std::move(file));
+      result =
+          std::make_unique<compression::Zstd_file>(std::move(file), options);
       break;
 
     default:
@@ -34,6 +34,27 @@ namespace storage {
 
 enum class Compression { NONE, GZIP, ZSTD };
 
+struct Compression_options {
+  /**
+   * Number of background threads which compress the data, if 0, compression
+   * is performed by the thread which writes the file. Ignored if compression
+   * algorithm does not support multi-threaded compression.
+   *
+   * zstd compressed data is split into independent frames, gzip compressed
+   * data is written as a single gzip member made of independently compressed
+   * deflate blocks.
+   */
+  int threads = 0;
+
+  /**
+   * If non-zero, data is split into independent frames holding at most this
+   * number of uncompressed bytes, and a seek table is appended to the file,
+   * which allows to seek() within the file when reading it. Ignored if
+   * compression algorithm does not support it.
+   */
+  size_t frame_size = 0;
+};
+
 class Compressed_file : public IFile {
  public:
   Compressed_file() = delete;
@@ -64,6 +85,12 @@ class Compressed_file : public IFile {
 
   IFile *file() const { return m_file.get(); }
   bool is_compressed() const override { return true; }
+
+  /**
+   * @returns number of background threads which have compressed the data of
+   *          the most recently written file
+   */
+  virtual std::size_t compression_threads_used() const { return 0; }
   bool is_local() const override;
 
  private:
@@ -79,6 +106,9 @@ Compression from_extension(const std::string &e);
 
 std::unique_ptr<IFile> make_file(std::unique_ptr<IFile> file, Compression c);
 
+std::unique_ptr<IFile> make_file(std::unique_ptr<IFile> file, Compression c,
+                                 const Compression_options &options);
+
 }  // namespace storage
 }  // namespace mysqlshdk
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -33,9 +33,95 @@ namespace mysqlshdk {
 namespace storage {
 namespace compression {
 
+namespace {
+
+constexpr int k_compression_level = 1;
+constexpr int k_mem_level = 8;
+constexpr int k_window_bits = 15;
+constexpr std::size_t k_window_size = 1 << k_window_bits;
+
+// gzip header: magic number, deflate, no flags, no modification time, no extra
+// flags, Unix
+constexpr uint8_t k_gzip_header[] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 3};
+
+// empty, final, fixed Huffman deflate block, ends the deflate stream
+constexpr uint8_t k_final_block[] = {0x03, 0x00};
+
+void write_le32(uint32_t value, uint8_t *out) {
+  out[0] = value & 0xFF;
+  out[1] = (value >> 8) & 0xFF;
+  out[2] = (value >> 16) & 0xFF;
+  out[3] = (value >> 24) & 0xFF;
+}
+
+/**
+ * Compresses the block as a raw deflate stream, primed with the end of the
+ * previous block. Output is byte-aligned (sync flush) and does not have the
+ * final bit set, so the compressed blocks can be concatenated into a single
+ * deflate stream. Called in a background thread.
+ */
+void deflate_block(Parallel_compressor::Block *block) {
+  z_stream stream;
+  stream.zalloc = nullptr;
+  stream.zfree = nullptr;
+  stream.opaque = nullptr;
+
+  if (Z_OK != deflateInit2(&stream, k_compression_level, Z_DEFLATED,
+                           -k_window_bits, k_mem_level, Z_DEFAULT_STRATEGY)) {
+    throw std::runtime_error(std::string("deflate init failed: ") +
+                             (stream.msg ? stream.msg : "unknown error"));
+  }
+
+  int result = Z_OK;
+
+  if (!block->prefix.empty()) {
+    result = deflateSetDictionary(&stream, block->prefix.data(),
+                                  block->prefix.size());
+  }
+
+  if (Z_OK == result) {
+    auto &output = block->output;
+    // sync flush marker is not included in the bound
+    output.resize(deflateBound(&stream, block->input.size()) + 16);
+
+    stream.next_in = block->input.data();
+    stream.avail_in = block->input.size();
+    size_t produced = 0;
+
+    do {
+      if (produced == output.size()) {
+        output.resize(2 * output.size());
+      }
+
+      stream.next_out = output.data() + produced;
+      stream.avail_out = output.size() - produced;
+
+      result = deflate(&stream, Z_SYNC_FLUSH);
+      produced = output.size() - stream.avail_out;
+    } while (Z_OK == result && 0 == stream.avail_out);
+
+    output.resize(produced);
+  }
+
+  deflateEnd(&stream);
+
+  if (Z_OK != result && Z_BUF_ERROR != result) {
+    throw std::runtime_error("deflate: stream error (" +
+                             std::to_string(result) + ")");
+  }
+
+  block->checksum = crc32(0L, block->input.data(), block->input.size());
+}
+
+}  // namespace
+
 Gz_file::Gz_file(std::unique_ptr<IFile> file)
     : Compressed_file(std::move(file)) {}
 
+Gz_file::Gz_file(std::unique_ptr<IFile> file,
+                 const Compression_options &options)
+    : Compressed_file(std::move(file)), m_threads(options.threads) {}
+
 Gz_file::~Gz_file() {
   try {
     if (is_open()) do_close();
@@ -89,10 +175,119 @@ ssize_t Gz_file::read(void *buffer, size_t length) {
 }
 
 ssize_t Gz_file::write(const void *buffer, size_t length) {
+  if (m_parallel) {
+    auto data = static_cast<const uint8_t *>(buffer);
+    auto left = length;
+
+    while (left > 0) {
+      const auto size =
+          std::min(left, Parallel_compressor::k_default_block_size -
+                             m_pending_block.size());
+
+      m_pending_block.insert(m_pending_block.end(), data, data + size);
+      data += size;
+      left -= size;
+
+      if (m_pending_block.size() == Parallel_compressor::k_default_block_size) {
+        submit_block();
+      }
+    }
+
+    m_uncompressed_bytes += length;
+
+    return length;
+  }
+
   return do_write(static_cast<Bytef *>(const_cast<void *>(buffer)), length,
                   Z_NO_FLUSH);
 }
 
+bool Gz_file::flush() {
+  if (m_parallel) {
+    if (!m_pending_block.empty()) {
+      submit_block();
+    }
+
+    m_compressor->finish();
+  }
+
+  return file()->flush();
+}
+
+std::size_t Gz_file::compression_threads_used() const {
+  return m_compressor ? m_compressor->threads_used() : m_threads_used;
+}
+
+void Gz_file::init_parallel_write() {
+  // blocks are compressed independently by the background threads and
+  // written in order by the thread which owns the file, as a single gzip
+  // member, which can be read by any gzip decompressor
+  m_parallel = true;
+  m_pending_block.clear();
+  m_pending_block.reserve(Parallel_compressor::k_default_block_size);
+  m_dictionary.clear();
+  m_crc = crc32(0L, Z_NULL, 0);
+  m_written_bytes = 0;
+  m_uncompressed_bytes = 0;
+  m_threads_used = 0;
+
+  m_compressor = std::make_unique<Parallel_compressor>(
+      m_threads, &deflate_block,
+      [this](const Parallel_compressor::Block &block) { write_block(block); });
+
+  write_raw(k_gzip_header, sizeof(k_gzip_header));
+}
+
+void Gz_file::submit_block() {
+  Parallel_compressor::Block block;
+  block.prefix = std::move(m_dictionary);
+
+  const auto size = m_pending_block.size();
+  const auto window = std::min(size, k_window_size);
+  m_dictionary.assign(m_pending_block.end() - window, m_pending_block.end());
+
+  block.input = std::move(m_pending_block);
+  m_pending_block.clear();
+  m_pending_block.reserve(Parallel_compressor::k_default_block_size);
+
+  m_compressor->submit(std::move(block));
+}
+
+void Gz_file::write_block(const Parallel_compressor::Block &block) {
+  write_raw(block.output.data(), block.output.size());
+
+  m_crc = crc32_combine(m_crc, block.checksum, block.input.size());
+  m_written_bytes += block.input.size();
+}
+
+void Gz_file::write_parallel_finish() {
+  if (!m_pending_block.empty()) {
+    submit_block();
+  }
+
+  m_compressor->finish();
+  m_threads_used = m_compressor->threads_used();
+
+  log_debug("Data of gzip compressed file %s was compressed using %zu threads",
+            full_path().masked().c_str(), m_threads_used);
+
+  write_raw(k_final_block, sizeof(k_final_block));
+
+  uint8_t trailer[8];
+  write_le32(m_crc, trailer);
+  // size modulo 2^32
+  write_le32(static_cast<uint32_t>(m_written_bytes), trailer + 4);
+  write_raw(trailer, sizeof(trailer));
+}
+
+void Gz_file::write_raw(const void *buffer, size_t length) {
+  const auto bytes = file()->write(buffer, length);
+
+  if (bytes < 0 || static_cast<size_t>(bytes) != length) {
+    throw std::runtime_error("deflate: cannot write");
+  }
+}
+
 void Gz_file::write_finish() {
   // deflate() may return Z_STREAM_ERROR if next_in is NULL
   char c = 0;
@@ -117,6 +312,11 @@ void Gz_file::init_read() {
 }
 
 void Gz_file::init_write() {
+  if (m_threads > 0) {
+    init_parallel_write();
+    return;
+  }
+
   m_stream.zalloc = nullptr;
   m_stream.zfree = nullptr;
   m_stream.opaque = nullptr;
@@ -167,12 +367,30 @@ void Gz_file::do_close() {
       (void)result;
       assert(result == Z_OK);
     } break;
-    case Mode::WRITE: {
-      write_finish();
-      auto result = deflateEnd(&m_stream);
-      (void)result;
-      assert(result == Z_OK);
-    } break;
+    case Mode::WRITE:
+      if (m_parallel) {
+        m_parallel = false;
+
+        try {
+          write_parallel_finish();
+        } catch (...) {
+          m_compressor.reset();
+          m_pending_block = {};
+          m_open_mode.reset();
+          file()->close();
+          throw;
+        }
+
+        m_compressor.reset();
+        m_pending_block = {};
+        m_dictionary = {};
+      } else {
+        write_finish();
+        auto result = deflateEnd(&m_stream);
+        (void)result;
+        assert(result == Z_OK);
+      }
+      break;
     case Mode::APPEND:
       break;
   }
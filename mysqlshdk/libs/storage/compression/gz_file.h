@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "mysqlshdk/libs/storage/compressed_file.h"
+#include "mysqlshdk/libs/storage/compression/parallel_compressor.h"
 #include "mysqlshdk/libs/utils/nullable.h"
 
 namespace mysqlshdk {
@@ -46,6 +47,8 @@ class Gz_file : public Compressed_file {
 
   explicit Gz_file(std::unique_ptr<IFile> file);
 
+  Gz_file(std::unique_ptr<IFile> file, const Compression_options &options);
+
   Gz_file(const Gz_file &other) = delete;
   Gz_file(Gz_file &&other) = default;
 
@@ -63,12 +66,18 @@ class Gz_file : public Compressed_file {
   }
 
   off64_t tell() const override {
+    if (m_parallel) return m_uncompressed_bytes;
+
     return std::max(m_stream.total_in, m_stream.total_out);
   }
 
   ssize_t read(void *buffer, size_t length) override;
   ssize_t write(const void *buffer, size_t length) override;
 
+  bool flush() override;
+
+  std::size_t compression_threads_used() const override;
+
  private:
   struct Buf_view {
     uint8_t *ptr;
@@ -97,6 +106,12 @@ class Gz_file : public Compressed_file {
   void write_finish();
   void do_close();
 
+  void init_parallel_write();
+  void submit_block();
+  void write_block(const Parallel_compressor::Block &block);
+  void write_parallel_finish();
+  void write_raw(const void *buffer, size_t length);
+
   inline Buf_view peek(const size_t length);
 
   void consume(const size_t length) {
@@ -105,6 +120,22 @@ class Gz_file : public Compressed_file {
 
   z_stream m_stream;
   std::vector<uint8_t> m_source;
+  // number of background threads used when compressing
+  int m_threads = 0;
+  // whether data is compressed by the background threads
+  bool m_parallel = false;
+  std::unique_ptr<Parallel_compressor> m_compressor;
+  // uncompressed data of the block which is going to be submitted next
+  std::vector<uint8_t> m_pending_block;
+  // end of the previously submitted block, used as a dictionary
+  std::vector<uint8_t> m_dictionary;
+  // checksum and size of the uncompressed data written out so far
+  uLong m_crc = 0;
+  uint64_t m_written_bytes = 0;
+  // number of uncompressed bytes accepted so far
+  uint64_t m_uncompressed_bytes = 0;
+  // number of threads used to compress the last file
+  std::size_t m_threads_used = 0;
   mysqlshdk::utils::nullable<Mode> m_open_mode{nullptr};
 };
 
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include "mysqlshdk/libs/storage/compression/parallel_compressor.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mysqlshdk {
+namespace storage {
+namespace compression {
+
+namespace {
+
+// number of blocks per thread which can be compressed or waiting to be written
+constexpr std::size_t k_pending_blocks_per_thread = 2;
+
+}  // namespace
+
+Parallel_compressor::Parallel_compressor(int threads, Compress compress,
+                                         Write write)
+    : m_compress(std::move(compress)),
+      m_write(std::move(write)),
+      m_max_pending(std::max(threads, 1) * k_pending_blocks_per_thread),
+      m_pool(std::max(threads, 1)),
+      m_group(m_pool.create_group()) {}
+
+Parallel_compressor::~Parallel_compressor() {
+  // jobs which did not start yet are skipped, the running ones are going to
+  // finish before the pool is destroyed
+  m_group->cancel();
+}
+
+void Parallel_compressor::submit(Block block) {
+  m_jobs.emplace_back(std::make_unique<Job>());
+
+  const auto job = m_jobs.back().get();
+  job->block = std::move(block);
+
+  const auto on_done = [this, job](std::exception_ptr error) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      job->error = std::move(error);
+      job->done = true;
+    }
+
+    m_job_done.notify_one();
+  };
+
+  m_pool.submit(
+      m_group,
+      [this, job, on_done]() {
+        std::exception_ptr error;
+
+        try {
+          m_compress(&job->block);
+        } catch (...) {
+          error = std::current_exception();
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_threads.emplace(std::this_thread::get_id());
+        }
+
+        on_done(std::move(error));
+      },
+      [on_done]() {
+        on_done(std::make_exception_ptr(
+            std::runtime_error("Compression was cancelled")));
+      });
+
+  write_completed(m_max_pending);
+}
+
+void Parallel_compressor::finish() { write_completed(0); }
+
+std::size_t Parallel_compressor::threads_used() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_threads.size();
+}
+
+void Parallel_compressor::write_completed(std::size_t max_pending) {
+  while (!m_jobs.empty()) {
+    const auto job = m_jobs.front().get();
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      if (m_jobs.size() > max_pending) {
+        m_job_done.wait(lock, [job]() { return job->done; });
+      } else if (!job->done) {
+        // oldest block is still being compressed, the rest is written later
+        return;
+      }
+    }
+
+    // job is removed from the queue before its exception is rethrown, other
+    // jobs remain valid
+    const auto finished = std::move(m_jobs.front());
+    m_jobs.pop_front();
+
+    if (finished->error) std::rethrow_exception(finished->error);
+
+    m_write(finished->block);
+  }
+}
+
+}  // namespace compression
+}  // namespace storage
+}  // namespace mysqlshdk
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef MYSQLSHDK_LIBS_STORAGE_COMPRESSION_PARALLEL_COMPRESSOR_H_
+#define MYSQLSHDK_LIBS_STORAGE_COMPRESSION_PARALLEL_COMPRESSOR_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "mysqlshdk/libs/utils/worker_pool.h"
+
+namespace mysqlshdk {
+namespace storage {
+namespace compression {
+
+/**
+ * Compresses independent blocks of data using background threads. Compressed
+ * blocks are handed back to the owner in the order in which they were
+ * submitted.
+ *
+ * This class is not thread-safe, it is meant to be used by a single thread
+ * which owns the compressed file.
+ */
+class Parallel_compressor final {
+ public:
+  struct Block {
+    // uncompressed data
+    std::vector<uint8_t> input;
+    // data preceding the input, can be used as a dictionary
+    std::vector<uint8_t> prefix;
+    // compressed data
+    std::vector<uint8_t> output;
+    // checksum of the uncompressed data, if used by the compression algorithm
+    uint32_t checksum = 0;
+  };
+
+  /**
+   * Compresses the input of a block, called in one of the background threads.
+   */
+  using Compress = std::function<void(Block *)>;
+
+  /**
+   * Writes a compressed block, called by the thread which submits the blocks.
+   */
+  using Write = std::function<void(const Block &)>;
+
+  /**
+   * Default size of the uncompressed block.
+   */
+  static constexpr std::size_t k_default_block_size = 1024 * 1024;
+
+  Parallel_compressor() = delete;
+
+  /**
+   * @param threads number of background threads
+   * @param compress compression function
+   * @param write called with each compressed block
+   */
+  Parallel_compressor(int threads, Compress compress, Write write);
+
+  Parallel_compressor(const Parallel_compressor &) = delete;
+  Parallel_compressor(Parallel_compressor &&) = delete;
+
+  Parallel_compressor &operator=(const Parallel_compressor &) = delete;
+  Parallel_compressor &operator=(Parallel_compressor &&) = delete;
+
+  /**
+   * Discards all blocks which were not written yet.
+   */
+  ~Parallel_compressor();
+
+  /**
+   * Schedules compression of the given block. Blocks which are already
+   * compressed are written out. If there are too many blocks in flight, waits
+   * for the oldest one to be compressed.
+   *
+   * @throws any exception reported by the compression or write function
+   */
+  void submit(Block block);
+
+  /**
+   * Waits until all blocks are compressed and written out.
+   *
+   * @throws any exception reported by the compression or write function
+   */
+  void finish();
+
+  /**
+   * @returns number of distinct threads which have compressed data so far
+   */
+  std::size_t threads_used() const;
+
+ private:
+  struct Job {
+    Block block;
+    bool done = false;
+    std::exception_ptr error;
+  };
+
+  void write_completed(std::size_t max_pending);
+
+  Compress m_compress;
+  Write m_write;
+  std::size_t m_max_pending;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_job_done;
+  std::set<std::thread::id> m_threads;
+
+  std::deque<std::unique_ptr<Job>> m_jobs;
+
+  // declared last, destroyed first, all jobs are finished before the rest of
+  // the members is destroyed
+  mysqlshdk::utils::Worker_pool m_pool;
+  std::shared_ptr<mysqlshdk::utils::Worker_pool::Job_group> m_group;
+};
+
+}  // namespace compression
+}  // namespace storage
+}  // namespace mysqlshdk
+
+#endif  // MYSQLSHDK_LIBS_STORAGE_COMPRESSION_PARALLEL_COMPRESSOR_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -24,6 +24,7 @@
 #include "mysqlshdk/libs/storage/compression/zstd_file.h"
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
 #include <utility>
 
@@ -34,9 +35,75 @@ namespace mysqlshdk {
 namespace storage {
 namespace compression {
 
+namespace {
+
+// seek table is stored using the zstd seekable format: a skippable frame at
+// the end of the file, which is ignored by the regular decompressors
+constexpr uint32_t k_skippable_magic_number = 0x184D2A5E;
+constexpr uint32_t k_seekable_magic_number = 0x8F92EAB1;
+constexpr size_t k_skippable_header_size = 8;
+constexpr size_t k_seek_table_entry_size = 8;
+constexpr size_t k_seek_table_checksum_size = 4;
+constexpr size_t k_seek_table_footer_size = 9;
+constexpr uint8_t k_seek_table_checksum_flag = 0x80;
+
+// sizes of the frames are stored as 32-bit values
+constexpr size_t k_max_frame_size = 1 << 30;
+
+void write_le32(uint32_t value, uint8_t *out) {
+  out[0] = value & 0xFF;
+  out[1] = (value >> 8) & 0xFF;
+  out[2] = (value >> 16) & 0xFF;
+  out[3] = (value >> 24) & 0xFF;
+}
+
+uint32_t read_le32(const uint8_t *in) {
+  return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+         (static_cast<uint32_t>(in[2]) << 16) |
+         (static_cast<uint32_t>(in[3]) << 24);
+}
+
+/**
+ * Compresses the block as a single, independent frame. Called in a background
+ * thread, each thread uses its own compression context.
+ */
+void compress_frame(Parallel_compressor::Block *block, int level) {
+  thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> cctx{
+      nullptr, &ZSTD_freeCCtx};
+
+  if (!cctx) {
+    cctx.reset(ZSTD_createCCtx());
+
+    if (!cctx) {
+      throw std::runtime_error("zstd compression context init failed");
+    }
+  }
+
+  block->output.resize(ZSTD_compressBound(block->input.size()));
+
+  const auto size = ZSTD_compressCCtx(
+      cctx.get(), block->output.data(), block->output.size(),
+      block->input.data(), block->input.size(), level);
+
+  if (ZSTD_isError(size)) {
+    throw std::runtime_error(std::string("zstd.write: ") +
+                             ZSTD_getErrorName(size));
+  }
+
+  block->output.resize(size);
+}
+
+}  // namespace
+
 Zstd_file::Zstd_file(std::unique_ptr<IFile> file)
     : Compressed_file(std::move(file)) {}
 
+Zstd_file::Zstd_file(std::unique_ptr<IFile> file,
+                     const Compression_options &options)
+    : Compressed_file(std::move(file)),
+      m_threads(options.threads),
+      m_frame_size(std::min(options.frame_size, k_max_frame_size)) {}
+
 Zstd_file::~Zstd_file() {
   try {
     if (is_open()) do_close();
@@ -57,6 +124,7 @@ Zstd_file::Buf_view Zstd_file::peek(const size_t length) {
       m_buffer.resize(avail);  // revert extent_to_fit
     } else {
       m_buffer.resize(avail + bytes_read);
+      m_read_position += bytes_read;
     }
   }
   return Buf_view{m_buffer.data(), m_buffer.size()};
@@ -125,6 +193,156 @@ ssize_t Zstd_file::do_read_mmap(ZSTD_outBuffer *obuf) {
   return obuf->pos;
 }
 
+off64_t Zstd_file::seek(off64_t offset) {
+  if (m_open_mode.is_null() || Mode::READ != *m_open_mode) {
+    throw std::logic_error("Zstd_file::seek() - file is not open for reading");
+  }
+
+  if (!load_seek_table()) {
+    throw std::logic_error("Zstd_file::seek() - file has no seek table");
+  }
+
+  const uint64_t target = std::max<off64_t>(offset, 0);
+  // last frame which starts at or before the target offset, first frame
+  // always starts at 0
+  auto frame = std::upper_bound(m_frames.begin(), m_frames.end(), target,
+                                [](uint64_t o, const Frame &f) {
+                                  return o < f.decompressed_offset;
+                                });
+  --frame;
+
+  file()->seek(frame->compressed_offset);
+  m_read_position = frame->compressed_offset;
+  m_buffer.clear();
+
+  const auto status = ZSTD_DCtx_reset(m_dctx, ZSTD_reset_session_only);
+
+  if (ZSTD_isError(status)) {
+    throw std::runtime_error(std::string("zstd.seek: ") +
+                             ZSTD_getErrorName(status));
+  }
+
+  m_offset = frame->decompressed_offset;
+
+  // decompress the beginning of the frame, up to the target offset
+  if (m_offset < target) {
+    std::vector<uint8_t> discard(
+        std::min<uint64_t>(target - m_offset, ZSTD_DStreamOutSize()));
+
+    while (m_offset < target) {
+      const auto bytes = read(
+          discard.data(), std::min<uint64_t>(target - m_offset, discard.size()));
+
+      if (bytes <= 0) {
+        break;
+      }
+    }
+  }
+
+  return 0;
+}
+
+bool Zstd_file::load_seek_table() {
+  if (m_seek_table_loaded) {
+    return !m_frames.empty();
+  }
+
+  m_seek_table_loaded = true;
+  m_frames.clear();
+
+  const uint64_t file_size = file()->file_size();
+
+  if (file_size < k_skippable_header_size + k_seek_table_footer_size) {
+    return false;
+  }
+
+  uint8_t footer[k_seek_table_footer_size];
+  read_raw(file_size - sizeof(footer), footer, sizeof(footer));
+
+  if (k_seekable_magic_number != read_le32(footer + 5)) {
+    return false;
+  }
+
+  const uint64_t frames = read_le32(footer);
+  const uint64_t entry_size =
+      k_seek_table_entry_size +
+      ((footer[4] & k_seek_table_checksum_flag) ? k_seek_table_checksum_size
+                                                : 0);
+  const uint64_t table_size =
+      k_skippable_header_size + frames * entry_size + k_seek_table_footer_size;
+
+  if (file_size < table_size) {
+    log_warning("Seek table of zstd compressed file %s is corrupted",
+                full_path().masked().c_str());
+    return false;
+  }
+
+  std::vector<uint8_t> table(table_size);
+  read_raw(file_size - table_size, table.data(), table.size());
+
+  if (k_skippable_magic_number != read_le32(&table[0]) ||
+      table_size - k_skippable_header_size != read_le32(&table[4])) {
+    log_warning("Seek table of zstd compressed file %s is corrupted",
+                full_path().masked().c_str());
+    return false;
+  }
+
+  m_frames.reserve(frames + 1);
+  m_frames.emplace_back(Frame{0, 0});
+
+  for (auto entry = &table[k_skippable_header_size];
+       entry < &table[table_size - k_seek_table_footer_size];
+       entry += entry_size) {
+    const auto &last = m_frames.back();
+    m_frames.emplace_back(
+        Frame{last.compressed_offset + read_le32(entry),
+              last.decompressed_offset + read_le32(entry + 4)});
+  }
+
+  if (file_size - table_size != m_frames.back().compressed_offset) {
+    log_warning("Seek table of zstd compressed file %s is corrupted",
+                full_path().masked().c_str());
+    m_frames.clear();
+    return false;
+  }
+
+  return true;
+}
+
+void Zstd_file::read_raw(uint64_t offset, void *buffer, size_t length) {
+  if (&Zstd_file::do_read_mmap == m_read_f) {
+    // read directly from the mapped memory, read position is not affected
+    auto *mfile = static_cast<backend::File *>(file());
+    size_t avail = 0;
+    const auto data = mfile->mmap_will_read(&avail);
+    const uint64_t position = mfile->tell();
+
+    if (!data || offset + length > position + avail) {
+      throw std::runtime_error("zstd.read: error reading seek table");
+    }
+
+    memcpy(buffer, data - position + offset, length);
+  } else {
+    file()->seek(offset);
+
+    auto out = static_cast<uint8_t *>(buffer);
+
+    while (length > 0) {
+      const auto bytes = file()->read(out, length);
+
+      if (bytes <= 0) {
+        file()->seek(m_read_position);
+        throw std::runtime_error("zstd.read: error reading seek table");
+      }
+
+      out += bytes;
+      length -= bytes;
+    }
+
+    file()->seek(m_read_position);
+  }
+}
+
 ssize_t Zstd_file::write(const void *buffer, size_t length) {
   ZSTD_inBuffer ibuf;
   ibuf.size = length;
@@ -133,10 +351,64 @@ ssize_t Zstd_file::write(const void *buffer, size_t length) {
 
   m_offset += length;
 
-  return (*this.*m_write_f)(&ibuf, ZSTD_e_continue);
+  if (m_compressor) {
+    auto data = static_cast<const uint8_t *>(buffer);
+    auto left = length;
+
+    while (left > 0) {
+      const auto size =
+          std::min(left, m_parallel_frame_size - m_pending_frame.size());
+
+      m_pending_frame.insert(m_pending_frame.end(), data, data + size);
+      data += size;
+      left -= size;
+
+      if (m_pending_frame.size() == m_parallel_frame_size) {
+        submit_frame();
+      }
+    }
+
+    return length;
+  }
+
+  if (0 == m_frame_size) {
+    return (*this.*m_write_f)(&ibuf, ZSTD_e_continue);
+  }
+
+  auto data = static_cast<const uint8_t *>(buffer);
+  auto left = length;
+
+  while (left > 0) {
+    ibuf.size = std::min(left, m_frame_size - m_frame_bytes);
+    ibuf.pos = 0;
+    ibuf.src = data;
+
+    (*this.*m_write_f)(&ibuf, ZSTD_e_continue);
+
+    data += ibuf.size;
+    left -= ibuf.size;
+    m_frame_bytes += ibuf.size;
+
+    if (m_frame_bytes == m_frame_size) {
+      end_frame();
+    }
+  }
+
+  return length;
 }
 
 bool Zstd_file::flush() {
+  if (m_compressor) {
+    // the pending data is written as a shorter frame
+    if (!m_pending_frame.empty()) {
+      submit_frame();
+    }
+
+    m_compressor->finish();
+
+    return file()->flush();
+  }
+
   ZSTD_inBuffer ibuf;
   ibuf.size = 0;
   ibuf.pos = 0;
@@ -148,12 +420,120 @@ bool Zstd_file::flush() {
 }
 
 void Zstd_file::write_finish() {
+  if (m_compressor) {
+    // file always holds at least one frame
+    if (!m_pending_frame.empty() || 0 == m_offset) {
+      submit_frame();
+    }
+
+    m_compressor->finish();
+    m_threads_used = m_compressor->threads_used();
+
+    log_debug("Data of zstd compressed file %s was compressed using %zu threads",
+              full_path().masked().c_str(), m_threads_used);
+
+    if (m_frame_size > 0) {
+      write_seek_table();
+    }
+
+    return;
+  }
+
+  if (0 == m_frame_size) {
+    end_frame();
+    return;
+  }
+
+  // file always holds at least one frame
+  if (m_frame_bytes > 0 || 1 == m_frames.size()) {
+    end_frame();
+  }
+
+  write_seek_table();
+}
+
+void Zstd_file::end_frame() {
   ZSTD_inBuffer ibuf;
   ibuf.size = 0;
   ibuf.pos = 0;
   ibuf.src = nullptr;
 
   (*this.*m_write_f)(&ibuf, ZSTD_e_end);
+
+  if (m_frame_size > 0) {
+    write_frame_entry(m_frame_bytes);
+    m_frame_bytes = 0;
+  }
+}
+
+std::size_t Zstd_file::compression_threads_used() const {
+  return m_compressor ? m_compressor->threads_used() : m_threads_used;
+}
+
+void Zstd_file::submit_frame() {
+  Parallel_compressor::Block block;
+  block.input = std::move(m_pending_frame);
+
+  m_pending_frame.clear();
+  m_pending_frame.reserve(m_parallel_frame_size);
+
+  m_compressor->submit(std::move(block));
+}
+
+void Zstd_file::write_frame_entry(size_t decompressed_size) {
+  const auto &last = m_frames.back();
+  m_frames.emplace_back(Frame{m_compressed_bytes,
+                              last.decompressed_offset + decompressed_size});
+}
+
+void Zstd_file::write_seek_table() {
+  const auto frames = m_frames.size() - 1;
+  std::vector<uint8_t> table(k_skippable_header_size +
+                             frames * k_seek_table_entry_size +
+                             k_seek_table_footer_size);
+  auto out = table.data();
+
+  write_le32(k_skippable_magic_number, out);
+  out += 4;
+  write_le32(table.size() - k_skippable_header_size, out);
+  out += 4;
+
+  for (std::size_t i = 1; i <= frames; ++i) {
+    write_le32(m_frames[i].compressed_offset - m_frames[i - 1].compressed_offset,
+               out);
+    out += 4;
+    write_le32(
+        m_frames[i].decompressed_offset - m_frames[i - 1].decompressed_offset,
+        out);
+    out += 4;
+  }
+
+  write_le32(frames, out);
+  out += 4;
+  // no checksums
+  *out++ = 0;
+  write_le32(k_seekable_magic_number, out);
+
+  write_raw(table.data(), table.size());
+}
+
+void Zstd_file::write_raw(const void *buffer, size_t length) {
+  if (&Zstd_file::do_write_mmap == m_write_f) {
+    auto *mfile = static_cast<backend::File *>(file());
+    const auto data = mfile->mmap_will_write(length, nullptr);
+
+    if (!data) {
+      throw std::runtime_error(
+          std::string("Error reserving space on mmapped file"));
+    }
+
+    memcpy(data, buffer, length);
+    mfile->mmap_did_write(length, nullptr);
+  } else if (file()->write(buffer, length) < 0) {
+    throw std::runtime_error("zstd.write: error writing compressed data");
+  }
+
+  m_compressed_bytes += length;
 }
 
 ssize_t Zstd_file::do_write(ZSTD_inBuffer *ibuf, ZSTD_EndDirective op) {
@@ -178,6 +558,7 @@ ssize_t Zstd_file::do_write(ZSTD_inBuffer *ibuf, ZSTD_EndDirective op) {
       if (r < 0)
         throw std::runtime_error("zstd.write: error writing compressed data");
 
+      m_compressed_bytes += obuf.pos;
       obuf.pos = 0;
     }
     // make sure the whole input buffer is consumed
@@ -209,6 +590,7 @@ ssize_t Zstd_file::do_write_mmap(ZSTD_inBuffer *ibuf, ZSTD_EndDirective op) {
                                ZSTD_getErrorName(status));
     } else {
       obuf.dst = mfile->mmap_did_write(obuf.pos, &obuf.size);
+      m_compressed_bytes += obuf.pos;
       obuf.pos = 0;
     }
     // make sure the whole input buffer is consumed
@@ -219,6 +601,38 @@ ssize_t Zstd_file::do_write_mmap(ZSTD_inBuffer *ibuf, ZSTD_EndDirective op) {
 }
 
 void Zstd_file::init_write() {
+  m_frame_bytes = 0;
+  m_compressed_bytes = 0;
+  m_frames.assign(1, Frame{0, 0});
+  m_threads_used = 0;
+
+  if (m_threads > 0) {
+    // frames are compressed independently by the background threads, the
+    // compressed output is written in order by the thread which owns the file
+    m_parallel_frame_size =
+        m_frame_size > 0
+            ? std::min(m_frame_size, Parallel_compressor::k_default_block_size)
+            : Parallel_compressor::k_default_block_size;
+    m_pending_frame.clear();
+    m_pending_frame.reserve(m_parallel_frame_size);
+
+    const auto level = m_clevel;
+
+    m_compressor = std::make_unique<Parallel_compressor>(
+        m_threads,
+        [level](Parallel_compressor::Block *block) {
+          compress_frame(block, level);
+        },
+        [this](const Parallel_compressor::Block &block) {
+          write_raw(block.output.data(), block.output.size());
+          write_frame_entry(block.input.size());
+        });
+
+    m_write_f = &Zstd_file::do_write;
+
+    return;
+  }
+
   if (!m_cctx) {
     m_cctx = ZSTD_createCStream();
     if (!m_cctx) {
@@ -241,6 +655,10 @@ void Zstd_file::init_write() {
 }
 
 void Zstd_file::init_read() {
+  m_seek_table_loaded = false;
+  m_frames.clear();
+  m_read_position = 0;
+
   if (!m_dctx) {
     m_dctx = ZSTD_createDStream();
     if (!m_dctx) {
@@ -295,7 +713,18 @@ void Zstd_file::do_close() {
       break;
 
     case Mode::WRITE:
-      write_finish();
+      try {
+        write_finish();
+      } catch (...) {
+        m_compressor.reset();
+        m_pending_frame = {};
+        m_open_mode.reset();
+        file()->close();
+        throw;
+      }
+
+      m_compressor.reset();
+      m_pending_frame = {};
       if (m_cctx) ZSTD_freeCStream(m_cctx);
       m_cctx = nullptr;
       m_write_f = nullptr;
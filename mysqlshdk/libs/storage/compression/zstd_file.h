@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -34,6 +34,7 @@
 #include <vector>
 
 #include "mysqlshdk/libs/storage/compressed_file.h"
+#include "mysqlshdk/libs/storage/compression/parallel_compressor.h"
 #include "mysqlshdk/libs/utils/nullable.h"
 
 namespace mysqlshdk {
@@ -46,6 +47,8 @@ class Zstd_file : public Compressed_file {
 
   explicit Zstd_file(std::unique_ptr<IFile> file);
 
+  Zstd_file(std::unique_ptr<IFile> file, const Compression_options &options);
+
   Zstd_file(const Zstd_file &other) = delete;
   Zstd_file(Zstd_file &&other) = default;
 
@@ -58,9 +61,12 @@ class Zstd_file : public Compressed_file {
   bool is_open() const override;
   void close() override;
 
-  off64_t seek(off64_t) override {
-    throw std::logic_error("Zstd_file::seek() - not supported");
-  }
+  /**
+   * Moves the read position to the given uncompressed offset. Supported only
+   * if file was written with a seek table, std::logic_error is thrown
+   * otherwise.
+   */
+  off64_t seek(off64_t offset) override;
 
   off64_t tell() const override { return m_offset; }
 
@@ -69,12 +75,21 @@ class Zstd_file : public Compressed_file {
   ssize_t read(void *buffer, size_t length) override;
   ssize_t write(const void *buffer, size_t length) override;
 
+  std::size_t compression_threads_used() const override;
+
  private:
   struct Buf_view {
     uint8_t *ptr;
     size_t length;
   };
 
+  // Offsets at which a frame begins, the last entry in the seek table marks
+  // the end of data.
+  struct Frame {
+    uint64_t compressed_offset;
+    uint64_t decompressed_offset;
+  };
+
   static constexpr const size_t CHUNK = 1 << 15;
 
   static constexpr bool is_power_of_2(size_t x) {
@@ -101,6 +116,15 @@ class Zstd_file : public Compressed_file {
   void init_write();
   void write_finish();
 
+  void end_frame();
+  void submit_frame();
+  void write_frame_entry(size_t decompressed_size);
+  void write_seek_table();
+  void write_raw(const void *buffer, size_t length);
+
+  bool load_seek_table();
+  void read_raw(uint64_t offset, void *buffer, size_t length);
+
   void do_close();
 
   ssize_t do_write(ZSTD_inBuffer *ibuf, ZSTD_EndDirective op);
@@ -117,6 +141,28 @@ class Zstd_file : public Compressed_file {
   ZSTD_CStream *m_cctx = nullptr;
   ZSTD_DStream *m_dctx = nullptr;
   int m_clevel = 1;
+  // number of background threads used when compressing
+  int m_threads = 0;
+  // compresses frames in the background if m_threads is set
+  std::unique_ptr<Parallel_compressor> m_compressor;
+  // uncompressed data of the frame which is going to be submitted next
+  std::vector<uint8_t> m_pending_frame;
+  // maximum size of a frame compressed in the background
+  size_t m_parallel_frame_size = 0;
+  // number of threads used to compress the last file
+  std::size_t m_threads_used = 0;
+  // maximum number of uncompressed bytes in a single frame, 0 if data is
+  // written as a single frame without a seek table
+  size_t m_frame_size = 0;
+  // number of uncompressed bytes written to the current frame
+  size_t m_frame_bytes = 0;
+  // total number of compressed bytes written so far
+  uint64_t m_compressed_bytes = 0;
+  // seek table, offsets of all frames written or read so far
+  std::vector<Frame> m_frames;
+  bool m_seek_table_loaded = false;
+  // position in the underlying file, used when reading without mmap
+  uint64_t m_read_position = 0;
   std::vector<uint8_t> m_buffer;
   size_t m_decompress_read_size = 0;
   mysqlshdk::utils::nullable<Mode> m_open_mode{nullptr};
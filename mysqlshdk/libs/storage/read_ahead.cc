@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/storage/read_ahead.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace mysqlshdk {
+namespace storage {
+
+Read_ahead::Read_ahead(Fetch_factory factory, std::size_t file_size,
+                       std::size_t block_size, std::size_t max_blocks,
+                       utils::Worker_pool *pool)
+    : m_factory(std::move(factory)),
+      m_file_size(file_size),
+      m_block_size(std::max<std::size_t>(block_size, 1)),
+      m_max_blocks(std::max<std::size_t>(max_blocks, 1)),
+      m_pool(pool ? pool : fetch_pool()),
+      m_fetches(m_pool->create_group()) {}
+
+Read_ahead::~Read_ahead() {
+  discard();
+  m_fetches->cancel();
+
+  try {
+    m_fetches->wait();
+  } catch (...) {
+    // fetch errors are reported by read()
+  }
+}
+
+utils::Worker_pool *Read_ahead::fetch_pool() {
+  // intentionally leaked, idle threads finish on their own
+  static const auto pool = new utils::Worker_pool(k_fetch_threads);
+  return pool;
+}
+
+std::size_t Read_ahead::read(off64_t offset, void *buffer,
+                             std::size_t length) {
+  const off64_t fsize = m_file_size;
+
+  if (offset >= fsize || 0 == length) return 0;
+
+  length = std::min<std::size_t>(length, fsize - offset);
+
+  const auto sequential = offset == m_next_offset;
+
+  if (!sequential) {
+    discard();
+  }
+
+  if (m_blocks.empty()) {
+    // start prefetching the data only if the previous read was sequential and
+    // there's more than one block remaining
+    if (!sequential || m_first_read ||
+        static_cast<std::size_t>(fsize - offset) <= m_block_size) {
+      m_first_read = false;
+
+      if (!m_fetch) m_fetch = m_factory();
+
+      const auto read = m_fetch(offset, length, static_cast<char *>(buffer));
+      m_next_offset = offset + read;
+
+      return read;
+    }
+
+    m_next_block = offset;
+    schedule();
+  }
+
+  std::size_t total = 0;
+  auto out = static_cast<char *>(buffer);
+
+  while (length > 0 && !m_blocks.empty()) {
+    const auto block = m_blocks.front();
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [&block]() { return block->ready; });
+    }
+
+    if (block->error) {
+      discard();
+      std::rethrow_exception(block->error);
+    }
+
+    const std::size_t begin = m_next_offset - block->offset;
+    const auto available = block->data.size() - begin;
+    const auto size = std::min(length, available);
+
+    ::memcpy(out, block->data.data() + begin, size);
+
+    out += size;
+    total += size;
+    length -= size;
+    m_next_offset += size;
+
+    if (size == available) {
+      m_blocks.pop_front();
+
+      if (block->data.size() < block->length) {
+        // got less data than expected, remaining data will be fetched directly
+        discard();
+        break;
+      }
+
+      schedule();
+    }
+  }
+
+  return total;
+}
+
+void Read_ahead::schedule() {
+  const off64_t fsize = m_file_size;
+  std::vector<std::shared_ptr<Block>> scheduled;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    while (m_blocks.size() < m_max_blocks && m_next_block < fsize) {
+      auto block = std::make_shared<Block>();
+      block->offset = m_next_block;
+      block->length = std::min<std::size_t>(m_block_size, fsize - m_next_block);
+
+      m_next_block += block->length;
+
+      m_blocks.emplace_back(block);
+      scheduled.emplace_back(std::move(block));
+    }
+  }
+
+  // destructor waits for the fetches, they can safely refer to this object
+  for (auto &block : scheduled) {
+    m_pool->submit(m_fetches, [this, block = std::move(block)]() {
+      fetch_block(block.get());
+    });
+  }
+}
+
+void Read_ahead::discard() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // blocks which were not fetched yet are skipped by the fetch threads
+  for (const auto &block : m_blocks) {
+    block->discarded = true;
+  }
+
+  m_blocks.clear();
+}
+
+void Read_ahead::fetch_block(Block *block) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (block->discarded) return;
+  }
+
+  std::exception_ptr error;
+
+  try {
+    // fetch threads keep their connections, a new callback does not mean a
+    // new connection
+    const auto fetch = m_factory();
+
+    block->data.resize(block->length);
+    block->data.resize(fetch(block->offset, block->length, &block->data[0]));
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    block->error = std::move(error);
+    block->ready = true;
+  }
+
+  m_cv.notify_all();
+}
+
+}  // namespace storage
+}  // namespace mysqlshdk
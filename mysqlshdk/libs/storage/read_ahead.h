@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_H_
+#define MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_H_
+
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "mysqlshdk/libs/utils/worker_pool.h"
+
+namespace mysqlshdk {
+namespace storage {
+
+/**
+ * Serves sequential reads of a remote file from memory, fetching the
+ * consecutive blocks of the file in background threads.
+ *
+ * Blocks are fetched by a bounded pool of threads shared by all the readers,
+ * these threads outlive the readers, which allows them to reuse their
+ * connections.
+ *
+ * Read-ahead is started once file is read sequentially, reads at an unexpected
+ * offset (i.e. after a seek) discard the prefetched data and are served
+ * directly.
+ */
+class Read_ahead final {
+ public:
+  static constexpr std::size_t k_default_block_size = 4 * 1024 * 1024;
+  static constexpr std::size_t k_default_max_blocks = 4;
+  static constexpr std::size_t k_fetch_threads = 16;
+
+  /**
+   * Fetches at most length bytes at the given offset into the buffer, returns
+   * number of bytes fetched.
+   */
+  using Fetch = std::function<std::size_t(off64_t offset, std::size_t length,
+                                          char *buffer)>;
+
+  /**
+   * Creates the Fetch callback, called in the thread which is going to fetch
+   * the data: once by the thread which reads the file directly, and for each
+   * prefetched block by the fetch thread.
+   */
+  using Fetch_factory = std::function<Fetch()>;
+
+  Read_ahead() = delete;
+
+  /**
+   * @param factory creates the fetch callbacks
+   * @param file_size size of the remote file
+   * @param block_size size of a prefetched block
+   * @param max_blocks maximum number of blocks prefetched at once
+   * @param pool fetches the blocks, if not set fetch_pool() is used
+   */
+  Read_ahead(Fetch_factory factory, std::size_t file_size,
+             std::size_t block_size = k_default_block_size,
+             std::size_t max_blocks = k_default_max_blocks,
+             utils::Worker_pool *pool = nullptr);
+
+  Read_ahead(const Read_ahead &) = delete;
+  Read_ahead(Read_ahead &&) = delete;
+
+  Read_ahead &operator=(const Read_ahead &) = delete;
+  Read_ahead &operator=(Read_ahead &&) = delete;
+
+  /**
+   * Blocks which were not fetched yet are discarded, waits for the ones which
+   * are being fetched.
+   */
+  ~Read_ahead();
+
+  /**
+   * Pool of k_fetch_threads threads shared by all the readers.
+   */
+  static utils::Worker_pool *fetch_pool();
+
+  /**
+   * Reads at most length bytes at the given offset.
+   *
+   * @returns number of bytes read, 0 if offset is past the end of file
+   */
+  std::size_t read(off64_t offset, void *buffer, std::size_t length);
+
+ private:
+  struct Block {
+    off64_t offset;
+    std::size_t length;
+    std::string data;
+    bool ready = false;
+    // block is no longer needed
+    bool discarded = false;
+    std::exception_ptr error;
+  };
+
+  void schedule();
+
+  void discard();
+
+  void fetch_block(Block *block);
+
+  const Fetch_factory m_factory;
+  const std::size_t m_file_size;
+  const std::size_t m_block_size;
+  const std::size_t m_max_blocks;
+
+  // used to serve the reads which are not prefetched
+  Fetch m_fetch;
+
+  // offset of the next sequential read
+  off64_t m_next_offset = 0;
+  // offset of the next block to be scheduled
+  off64_t m_next_block = 0;
+  bool m_first_read = true;
+
+  utils::Worker_pool *m_pool;
+  std::shared_ptr<utils::Worker_pool::Job_group> m_fetches;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  // blocks which are being prefetched, in order
+  std::deque<std::shared_ptr<Block>> m_blocks;
+};
+
+}  // namespace storage
+}  // namespace mysqlshdk
+
+#endif  // MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_H_
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/storage/read_ahead_file.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "mysqlshdk/include/shellcore/scoped_contexts.h"
+#include "mysqlshdk/libs/storage/idirectory.h"
+
+namespace mysqlshdk {
+namespace storage {
+
+Read_ahead_file::Read_ahead_file(std::unique_ptr<IFile> file,
+                                 std::size_t block_size)
+    : m_file(std::move(file)), m_block_size(block_size) {}
+
+Read_ahead_file::~Read_ahead_file() { stop(); }
+
+void Read_ahead_file::open(Mode m) {
+  stop();
+  discard();
+  m_file->open(m);
+  m_offset = 0;
+}
+
+bool Read_ahead_file::is_open() const { return m_file->is_open(); }
+
+int Read_ahead_file::error() const { return m_file->error(); }
+
+void Read_ahead_file::close() {
+  stop();
+  discard();
+  m_file->close();
+}
+
+size_t Read_ahead_file::file_size() const { return m_file->file_size(); }
+
+Masked_string Read_ahead_file::full_path() const { return m_file->full_path(); }
+
+std::string Read_ahead_file::filename() const { return m_file->filename(); }
+
+bool Read_ahead_file::exists() const { return m_file->exists(); }
+
+std::unique_ptr<IDirectory> Read_ahead_file::parent() const {
+  return m_file->parent();
+}
+
+off64_t Read_ahead_file::seek(off64_t offset) {
+  stop();
+  // if seek() fails, data which was read ahead is still valid and reading
+  // can continue
+  m_file->seek(offset);
+  discard();
+  // some backends do not return the new offset
+  m_offset = m_file->tell();
+  return m_offset;
+}
+
+off64_t Read_ahead_file::tell() const { return m_offset; }
+
+ssize_t Read_ahead_file::read(void *buffer, size_t length) {
+  if (!m_running && !m_eof) {
+    start();
+  }
+
+  const auto out = static_cast<char *>(buffer);
+  std::size_t bytes = 0;
+
+  while (bytes < length) {
+    if (m_current_offset == m_current.size()) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      m_cv.wait(lock, [this]() { return !m_ready.empty() || m_eof; });
+
+      if (m_ready.empty()) {
+        // return the data which was already read, report errors in the next
+        // call
+        if (bytes > 0) break;
+
+        if (m_error) std::rethrow_exception(m_error);
+        if (m_failed) return -1;
+
+        break;
+      }
+
+      m_current.clear();
+      m_free.emplace_back(std::move(m_current));
+      m_current = std::move(m_ready.front());
+      m_ready.pop_front();
+      m_current_offset = 0;
+
+      m_cv.notify_all();
+    }
+
+    const auto n = std::min(length - bytes, m_current.size() - m_current_offset);
+    ::memcpy(out + bytes, m_current.data() + m_current_offset, n);
+    m_current_offset += n;
+    bytes += n;
+  }
+
+  m_offset += bytes;
+
+  return bytes;
+}
+
+ssize_t Read_ahead_file::write(const void *buffer, size_t length) {
+  return m_file->write(buffer, length);
+}
+
+bool Read_ahead_file::flush() { return m_file->flush(); }
+
+bool Read_ahead_file::is_compressed() const { return m_file->is_compressed(); }
+
+bool Read_ahead_file::is_local() const { return m_file->is_local(); }
+
+void Read_ahead_file::rename(const std::string &new_name) {
+  m_file->rename(new_name);
+}
+
+void Read_ahead_file::remove() { m_file->remove(); }
+
+void Read_ahead_file::start() {
+  m_running = true;
+  m_thread = mysqlsh::spawn_scoped_thread([this]() { read_blocks(); });
+}
+
+void Read_ahead_file::stop() {
+  if (!m_running) return;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+
+  m_cv.notify_all();
+  m_thread.join();
+
+  m_running = false;
+  m_stop = false;
+}
+
+void Read_ahead_file::discard() {
+  m_eof = false;
+  m_failed = false;
+  m_error = nullptr;
+  m_ready.clear();
+  m_current.clear();
+  m_current_offset = 0;
+}
+
+void Read_ahead_file::read_blocks() {
+  while (true) {
+    std::string block;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      m_cv.wait(lock,
+                [this]() { return m_stop || m_ready.size() < k_max_blocks; });
+
+      if (m_stop) return;
+
+      if (!m_free.empty()) {
+        block = std::move(m_free.back());
+        m_free.pop_back();
+      }
+    }
+
+    block.resize(m_block_size);
+
+    std::size_t size = 0;
+    bool eof = false;
+    bool failed = false;
+    std::exception_ptr error;
+
+    try {
+      while (size < m_block_size) {
+        const auto bytes = m_file->read(&block[size], m_block_size - size);
+
+        if (bytes < 0) {
+          failed = true;
+          break;
+        } else if (0 == bytes) {
+          eof = true;
+          break;
+        }
+
+        size += bytes;
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    block.resize(size);
+
+    const auto done = eof || failed || error;
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      if (size > 0) {
+        m_ready.emplace_back(std::move(block));
+      }
+
+      if (done) {
+        m_eof = true;
+        m_failed = failed;
+        m_error = std::move(error);
+      }
+    }
+
+    m_cv.notify_all();
+
+    if (done) return;
+  }
+}
+
+}  // namespace storage
+}  // namespace mysqlshdk
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_FILE_H_
+#define MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_FILE_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mysqlshdk/libs/storage/ifile.h"
+
+namespace mysqlshdk {
+namespace storage {
+
+/**
+ * Reads the wrapped file sequentially in a background thread, so that e.g.
+ * decompression of the next block overlaps with processing of the current
+ * one. Background thread is started by the first read(), at most
+ * k_max_blocks are read ahead. seek() discards the data which was read ahead.
+ *
+ * Only one thread can use this file at a time, reads should not be mixed with
+ * writes.
+ */
+class Read_ahead_file : public IFile {
+ public:
+  static constexpr std::size_t k_default_block_size = 1024 * 1024;
+  static constexpr std::size_t k_max_blocks = 2;
+
+  Read_ahead_file() = delete;
+
+  explicit Read_ahead_file(std::unique_ptr<IFile> file,
+                           std::size_t block_size = k_default_block_size);
+
+  Read_ahead_file(const Read_ahead_file &other) = delete;
+  Read_ahead_file(Read_ahead_file &&other) = delete;
+
+  Read_ahead_file &operator=(const Read_ahead_file &other) = delete;
+  Read_ahead_file &operator=(Read_ahead_file &&other) = delete;
+
+  ~Read_ahead_file() override;
+
+  void open(Mode m) override;
+  bool is_open() const override;
+  int error() const override;
+  void close() override;
+
+  size_t file_size() const override;
+  Masked_string full_path() const override;
+  std::string filename() const override;
+  bool exists() const override;
+  std::unique_ptr<IDirectory> parent() const override;
+
+  off64_t seek(off64_t offset) override;
+  off64_t tell() const override;
+  ssize_t read(void *buffer, size_t length) override;
+  ssize_t write(const void *buffer, size_t length) override;
+  bool flush() override;
+
+  bool is_compressed() const override;
+  bool is_local() const override;
+
+  void rename(const std::string &new_name) override;
+  void remove() override;
+
+  IFile *file() const { return m_file.get(); }
+
+ private:
+  void start();
+
+  void stop();
+
+  void discard();
+
+  void read_blocks();
+
+  std::unique_ptr<IFile> m_file;
+  const std::size_t m_block_size;
+
+  // logical offset, wrapped file is ahead of it when reading in background
+  off64_t m_offset = 0;
+
+  // block which is currently being consumed
+  std::string m_current;
+  std::size_t m_current_offset = 0;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::string> m_ready;
+  // consumed blocks, reused to avoid allocations
+  std::vector<std::string> m_free;
+  std::thread m_thread;
+  bool m_running = false;
+  bool m_stop = false;
+  bool m_eof = false;
+  bool m_failed = false;
+  std::exception_ptr m_error;
+};
+
+}  // namespace storage
+}  // namespace mysqlshdk
+
+#endif  // MYSQLSHDK_LIBS_STORAGE_READ_AHEAD_FILE_H_
@@ -34,7 +34,8 @@
 #include <unistd.h>
 #endif
 
-#include <deque>
+#include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <mutex>
 #include <string>
@@ -160,11 +161,16 @@ bool Document_reader_options::ignore_type(Bson_type type) const {
 }
 
 std::string Json_reader::next() {
-  std::deque<char> context;
   m_source->skip_whitespaces();
 
+  std::string document;
+  document.reserve(m_document_size_hint + m_document_size_hint / 4);
+
   Json_document_parser parser(m_source, m_options);
-  return parser.parse();
+  parser.parse(&document);
+
+  m_document_size_hint = document.size();
+  return document;
 }
 
 void Json_reader::parse_bom() {
@@ -342,8 +348,7 @@ void Json_document_parser::parse(std::string *document) {
       get_string(m_document);
       m_last_attribute_end = m_document->size() - 1;
 
-      if (m_options.convert_bson_types.get_safe(false) ||
-          m_options.convert_bson_id.get_safe(false)) {
+      if (m_convert_bson) {
         auto type = get_bson_type();
         // If the first field is a mongo special field
         // The original document is translated based on
@@ -854,32 +859,74 @@ void Json_document_parser::get_string(std::string *target,
 
   get_char(target);
 
-  // Count holds the count of the characters read between the quotes
-  int count = 0;
-  bool done = false;
-  while (!m_source->eof() && !done) {
-    switch (m_source->peek()) {
-      case '\\':
-        get_char(target);
-        get_char(target);
-        break;
+  // Only the closing quote and the escape sequences need special handling,
+  // everything in between is located using memchr() and copied in bulk. The
+  // position of the next quote is remembered as an offset from the beginning
+  // of the input, so that it's not searched for again after each escape
+  // sequence, it remains valid until it's consumed or the buffer is refilled.
+  bool quote_found = false;
+  size_t quote_offset = 0;
 
-      case '"':
-        get_char(target);
-        done = true;
-        break;
+  while (true) {
+    m_source->peek();
 
-      default:
+    if (m_source->eof()) throw_premature_end();
+
+    const auto begin = m_source->pos();
+    const auto end = m_source->end();
+    const auto offset = m_source->offset();
+
+    if (!quote_found || quote_offset < offset) {
+      const auto quote = memchr(begin, '"', end - begin);
+      quote_found = nullptr != quote;
+
+      if (quote_found) {
+        quote_offset =
+            offset + (static_cast<const unsigned char *>(quote) - begin);
+      }
+    }
+
+    const auto limit = quote_found ? begin + (quote_offset - offset) : end;
+    const auto escape = memchr(begin, '\\', limit - begin);
+    const auto stop =
+        escape ? begin + (static_cast<const unsigned char *>(escape) - begin)
+               : limit;
+
+    // control characters have to be escaped, a raw line break in a string
+    // would also break the search for the document boundaries when a file is
+    // imported in parallel
+    const auto control = std::find_if(
+        begin, stop, [](unsigned char c) { return c < 0x20; });
+
+    if (control != stop) {
+      throw invalid_json("Unescaped control character in a string",
+                         offset + (control - begin));
+    }
+
+    if (escape) {
+      m_source->get(static_cast<const unsigned char *>(escape), target);
+      get_char(target);
+      get_char(target);
+    } else {
+      m_source->get(limit, target);
+
+      if (quote_found) {
         get_char(target);
+        break;
+      }
     }
-    if (!done) count++;
   }
-
-  if (!done) throw_premature_end();
 }
 
 void Json_document_parser::get_whitespaces(std::string *target) {
-  while (!m_source->eof() && ::isspace(m_source->peek())) get_char(target);
+  while (!m_source->eof() && ::isspace(m_source->peek())) {
+    auto pos = m_source->pos();
+    const auto end = m_source->end();
+
+    while (pos < end && ::isspace(*pos)) ++pos;
+
+    m_source->get(pos, target);
+  }
 }
 
 void Json_document_parser::get_value(std::string *target) {
@@ -891,7 +938,8 @@ void Json_document_parser::get_value(std::string *target) {
 
     case '{': {
       std::string context;
-      if (!m_as_array) {
+      // context is only used when reporting BSON conversion issues
+      if (!m_as_array && m_convert_bson) {
         size_t size = m_last_attribute_end - m_last_attribute_start;
         context = m_document->substr(m_last_attribute_start, size);
       }
@@ -915,9 +963,18 @@ void Json_document_parser::get_value(std::string *target) {
       throw invalid_json("Unexpected ']'", m_source->offset());
       break;
     default: {
-      while (m_source->peek() != ',' &&
-             m_source->peek() != (m_as_array ? ']' : '}'))
-        get_char(target);
+      const auto closing = m_as_array ? ']' : '}';
+
+      while (m_source->peek() != ',' && m_source->peek() != closing) {
+        if (m_source->eof()) throw_premature_end();
+
+        auto pos = m_source->pos();
+        const auto end = m_source->end();
+
+        while (pos < end && *pos != ',' && *pos != closing) ++pos;
+
+        m_source->get(pos, target);
+      }
     }
   }
 }
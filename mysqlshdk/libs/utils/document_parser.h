@@ -108,6 +108,11 @@ class Json_reader final : public Document_reader {
       : Document_reader(input, options) {}
   std::string next() override;
   void parse_bom();
+
+ private:
+  // Documents in a file tend to be of similar size, capacity of the next
+  // document is reserved based on the size of the previous one.
+  size_t m_document_size_hint = 0;
 };
 
 /**
@@ -148,13 +153,21 @@ class Json_document_parser : public Document_parser {
   Json_document_parser(Buffered_input *input,
                        const Document_reader_options &options, size_t depth = 0,
                        bool as_array = false, const std::string &context = "")
-      : Document_parser(input, options, depth, as_array, context) {}
+      : Document_parser(input, options, depth, as_array, context),
+        m_convert_bson(options.convert_bson_types.get_safe(false) ||
+                       options.convert_bson_id.get_safe(false)) {}
 
   /**
    * Parses a single JSON document from the Buffered_input.
    */
   std::string parse() override;
 
+  /**
+   * Parses a single JSON document from the Buffered_input, appending it to the
+   * given string.
+   */
+  void parse(std::string *document);
+
   struct Bson_token {
     Bson_token(char atype, const std::string &astring = "",
                std::string *string_ptr = nullptr, double *number = nullptr,
@@ -174,14 +187,13 @@ class Json_document_parser : public Document_parser {
  private:
   std::string *m_document = nullptr;
   size_t m_document_start_offset = 0;
+  const bool m_convert_bson;
 
   // Helper variables, identify the position in m_document
   // for the last parsed attribute.
   size_t m_last_attribute_start = 0;
   size_t m_last_attribute_end = 0;
 
-  void parse(std::string *document);
-
   void get_char(std::string *target) {
     assert(target);
     (*target) += m_source->get();
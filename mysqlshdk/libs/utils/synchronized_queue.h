@@ -25,13 +25,16 @@
 #define MYSQLSHDK_LIBS_UTILS_SYNCHRONIZED_QUEUE_H_
 
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <stdexcept>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -39,8 +42,167 @@ namespace shcore {
 
 enum class Queue_priority { LOW = 1, MEDIUM, HIGH };
 
+namespace detail {
+
+/**
+ * Bounded, lock-free, multiple producer, multiple consumer FIFO queue.
+ *
+ * Based on the bounded MPMC queue by Dmitry Vyukov, each cell holds a sequence
+ * number which tells whether it's ready to be written or read.
+ */
+template <class T, std::size_t N>
+class Bounded_queue final {
+  static_assert(N >= 2 && 0 == (N & (N - 1)), "N must be a power of two");
+
+ public:
+  Bounded_queue() : m_cells(std::make_unique<Cell[]>(N)) {
+    for (std::size_t i = 0; i < N; ++i) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  Bounded_queue(const Bounded_queue &other) = delete;
+  Bounded_queue(Bounded_queue &&other) = delete;
+
+  Bounded_queue &operator=(const Bounded_queue &other) = delete;
+  Bounded_queue &operator=(Bounded_queue &&other) = delete;
+
+  ~Bounded_queue() = default;
+
+  /**
+   * Pushes the value, argument is not modified if queue is full.
+   *
+   * @returns false if queue is full
+   */
+  template <class U>
+  bool try_push(U &&u) {
+    Cell *cell;
+    auto pos = m_push_pos.load(std::memory_order_relaxed);
+
+    while (true) {
+      cell = &m_cells[pos & k_mask];
+      const auto seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+      if (0 == diff) {
+        if (m_push_pos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_push_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->value = std::forward<U>(u);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * @returns false if queue is empty
+   */
+  bool try_pop(T *out) {
+    Cell *cell;
+    auto pos = m_pop_pos.load(std::memory_order_relaxed);
+
+    while (true) {
+      cell = &m_cells[pos & k_mask];
+      const auto seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::intptr_t>(seq) -
+                        static_cast<std::intptr_t>(pos + 1);
+
+      if (0 == diff) {
+        if (m_pop_pos.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_pop_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    *out = std::move(cell->value);
+    // release any resources held by the moved-from value
+    cell->value = T();
+    cell->sequence.store(pos + N, std::memory_order_release);
+
+    return true;
+  }
+
+ private:
+  static constexpr std::size_t k_mask = N - 1;
+
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> m_cells;
+  alignas(64) std::atomic<std::size_t> m_push_pos{0};
+  alignas(64) std::atomic<std::size_t> m_pop_pos{0};
+};
+
+/**
+ * Unbounded FIFO queue, uses the lock-free queue until it's full, the
+ * remaining values are stored in a synchronized overflow queue. Once overflow
+ * queue is used, all the values are pushed there until it's empty, in order to
+ * preserve the order of values pushed by a single producer.
+ */
+template <class T>
+class Lane final {
+ public:
+  template <class U>
+  void push(U &&u) {
+    if (!m_use_overflow.load() && m_queue.try_push(std::forward<U>(u))) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_overflow_mutex);
+    m_overflow.emplace_back(std::forward<U>(u));
+    m_use_overflow = true;
+  }
+
+  bool try_pop(T *out) {
+    if (m_queue.try_pop(out)) return true;
+
+    if (!m_use_overflow.load()) return false;
+
+    std::lock_guard<std::mutex> lock(m_overflow_mutex);
+
+    if (m_overflow.empty()) return false;
+
+    *out = std::move(m_overflow.front());
+    m_overflow.pop_front();
+
+    if (m_overflow.empty()) m_use_overflow = false;
+
+    return true;
+  }
+
+ private:
+  static constexpr std::size_t k_capacity = 256;
+
+  Bounded_queue<T, k_capacity> m_queue;
+  std::atomic<bool> m_use_overflow{false};
+  std::mutex m_overflow_mutex;
+  std::deque<T> m_overflow;
+};
+
+}  // namespace detail
+
 /**
  * Multiple producer, multiple consumer synchronized FIFO queue.
+ *
+ * Values are stored in lock-free queues (one for each priority), consumers
+ * claim a value using an atomic counter, the mutex is used only to wait for
+ * the values when queue is empty.
  */
 template <class T>
 class Synchronized_queue final {
@@ -56,26 +218,34 @@ class Synchronized_queue final {
 
   template <class U = T>
   void push(U &&r, Queue_priority p = Queue_priority::MEDIUM) {
-    {
-      std::lock_guard<std::mutex> lock(m_queue_mutex);
-      unsynchronized_push(std::forward<U>(r), map_priority(p));
-    }
-    m_task_ready.notify_one();
+    unsynchronized_push(std::forward<U>(r), map_priority(p));
+    ++m_size;
+    notify(false);
   }
 
   T pop() {
-    std::unique_lock<std::mutex> lock(m_queue_mutex);
-    m_task_ready.wait(lock, [this]() { return !unsynchronized_empty(); });
+    if (!try_claim()) {
+      std::unique_lock<std::mutex> lock(m_wait_mutex);
+      ++m_waiting;
+      m_task_ready.wait(lock, [this]() { return try_claim(); });
+      --m_waiting;
+    }
+
     return unsynchronized_pop();
   }
 
   std::optional<T> try_pop(std::chrono::milliseconds timeout) {
-    std::unique_lock<std::mutex> lock(m_queue_mutex);
-    if (m_task_ready.wait_for(lock, timeout,
-                              [this]() { return !unsynchronized_empty(); })) {
-      return unsynchronized_pop();
+    if (!try_claim()) {
+      std::unique_lock<std::mutex> lock(m_wait_mutex);
+      ++m_waiting;
+      const auto claimed = m_task_ready.wait_for(
+          lock, timeout, [this]() { return try_claim(); });
+      --m_waiting;
+
+      if (!claimed) return {};
     }
-    return {};
+
+    return unsynchronized_pop();
   }
 
   /**
@@ -85,12 +255,12 @@ class Synchronized_queue final {
    * @param n number of consumer threads.
    */
   void shutdown(int64_t n) {
-    {
-      std::lock_guard<std::mutex> lock(m_queue_mutex);
-      for (int64_t i = 0; i < n; i++)
-        unsynchronized_push(T(), k_shutdown_priority);
+    for (int64_t i = 0; i < n; i++) {
+      unsynchronized_push(T(), k_shutdown_priority);
     }
-    m_task_ready.notify_all();
+
+    m_size += n;
+    notify(true);
   }
 
   size_t size() const { return m_size; }
@@ -104,33 +274,72 @@ class Synchronized_queue final {
 
   template <class U>
   inline void unsynchronized_push(U &&u, Priority_t p) {
-    m_queues[k_max_priority - p].emplace_back(std::forward<U>(u));
-    ++m_size;
+    m_queues[k_max_priority - p].push(std::forward<U>(u));
   }
 
+  /**
+   * Pops a value, value needs to be claimed first.
+   */
   inline T unsynchronized_pop() {
-    for (auto &queue : m_queues) {
-      if (!queue.empty()) {
-        auto r = std::move(queue.front());
-        queue.pop_front();
-        --m_size;
-        return r;
+    T r;
+
+    // claimed value is guaranteed to be available, but it may have been taken
+    // from a higher priority queue by another consumer, in which case the
+    // value claimed by that consumer is going to appear in one of the queues
+    while (true) {
+      for (auto &queue : m_queues) {
+        if (queue.try_pop(&r)) {
+          return r;
+        }
+      }
+
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * Claims one of the pushed values.
+   *
+   * @returns false if queue is empty
+   */
+  inline bool try_claim() {
+    auto size = m_size.load();
+
+    while (size > 0) {
+      if (m_size.compare_exchange_weak(size, size - 1)) {
+        return true;
       }
     }
 
-    throw std::logic_error("Trying to pop from an empty queue.");
+    return false;
   }
 
-  inline bool unsynchronized_empty() const { return 0 == m_size; }
+  inline void notify(bool all) {
+    // size is incremented before the number of waiting threads is checked,
+    // waiting thread increments the counter before checking the size, at least
+    // one of them is going to notice the change
+    if (m_waiting.load() > 0) {
+      // wait until consumer is blocked on the condition variable
+      { std::lock_guard<std::mutex> lock(m_wait_mutex); }
+
+      if (all) {
+        m_task_ready.notify_all();
+      } else {
+        m_task_ready.notify_one();
+      }
+    }
+  }
 
   static constexpr Priority_t k_shutdown_priority = 0;
   static constexpr Priority_t k_max_priority =
       map_priority(Queue_priority::HIGH);
 
-  mutable std::mutex m_queue_mutex;
-  std::condition_variable m_task_ready;
-  std::array<std::deque<T>, 4> m_queues;
+  std::array<detail::Lane<T>, 4> m_queues;
   std::atomic<std::size_t> m_size{0};
+
+  std::mutex m_wait_mutex;
+  std::condition_variable m_task_ready;
+  std::atomic<std::size_t> m_waiting{0};
 };
 }  // namespace shcore
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -22,15 +22,58 @@
  */
 
 #include "mysqlshdk/libs/utils/threads.h"
+
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <utility>
+
+#include "mysqlshdk/include/shellcore/shell_init.h"
 
 namespace mysqlshdk {
 namespace utils {
 
+namespace {
+
+constexpr size_t k_default_worker_pool_size = 16;
+
+std::mutex g_default_worker_pool_mutex;
+
+// intentionally leaked if not shut down, workers may still be running when
+// static objects are destroyed at exit
+Worker_pool *g_default_worker_pool = nullptr;
+
+}  // namespace
+
 bool in_main_thread() {
   static std::thread::id main_thread_id = std::this_thread::get_id();
   return main_thread_id == std::this_thread::get_id();
 }
 
+Worker_pool *default_worker_pool() {
+  std::lock_guard<std::mutex> lock(g_default_worker_pool_mutex);
+
+  if (!g_default_worker_pool) {
+    g_default_worker_pool = new Worker_pool(k_default_worker_pool_size, []() {
+      return std::make_shared<mysqlsh::Mysql_thread>();
+    });
+  }
+
+  return g_default_worker_pool;
+}
+
+void shutdown_default_worker_pool() {
+  Worker_pool *pool = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(g_default_worker_pool_mutex);
+    pool = std::exchange(g_default_worker_pool, nullptr);
+  }
+
+  // waits for the pending jobs and joins the workers, which releases their
+  // MySQL thread contexts
+  delete pool;
+}
+
 }  // namespace utils
 }  // namespace mysqlshdk
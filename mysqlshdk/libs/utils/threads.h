@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, 2020 Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2019, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -24,59 +24,191 @@
 #ifndef MYSQLSHDK_LIBS_UTILS_THREADS_H_
 #define MYSQLSHDK_LIBS_UTILS_THREADS_H_
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 #include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/worker_pool.h"
 
 namespace mysqlshdk {
 namespace utils {
 
 bool in_main_thread();
 
+/**
+ * Pool shared by all parallel operations which don't use a dedicated one.
+ * Worker threads are initialized to use the MySQL client library.
+ */
+Worker_pool *default_worker_pool();
+
+/**
+ * Stops the default pool and waits for its worker threads to finish. Needs to
+ * be called before the MySQL client library is deinitialized, as idle workers
+ * keep their thread contexts alive. A new pool is created if it's used again.
+ */
+void shutdown_default_worker_pool();
+
+namespace detail {
+
+/**
+ * Pops a value from the queue. If called from a worker thread, executes the
+ * pending jobs while waiting, as the value may be produced by one of them.
+ */
+template <class T>
+T pop_result(shcore::Synchronized_queue<T> *queue, Worker_pool *pool) {
+  if (!pool->in_worker_thread()) return queue->pop();
+
+  while (true) {
+    if (auto r = queue->try_pop(std::chrono::milliseconds::zero())) {
+      return std::move(*r);
+    }
+
+    if (!pool->run_pending_job()) {
+      if (auto r = queue->try_pop(std::chrono::milliseconds(10))) {
+        return std::move(*r);
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
 /**
  * Executes the map function on each value of the given list in parallel and
  * return the aggregation of their results, as computed by the reduce function.
  *
- * map is called in a worker thread, while reduce is called in the callers
- * thread.
+ * map is called in a worker thread of the given pool, while reduce is called
+ * in the callers thread.
+ *
+ * @throws any exception thrown by the map function, once all values were
+ *         processed
  */
 template <class OutputT, class IntermediateT, class InputIter, class MapF,
           class ReduceF>
-OutputT map_reduce(InputIter begin, InputIter end, MapF map, ReduceF reduce) {
-  shcore::Synchronized_queue<std::pair<size_t, IntermediateT>> results;
-  std::vector<std::thread> workers;
-
-  auto iter = begin;
-  // start computation in threads
-  while (iter != end) {
-    size_t index = workers.size();
-    workers.push_back(
-        mysqlsh::spawn_scoped_thread([&results, map, iter, index]() {
-          results.push({index, map(*iter)});
-        }));
-    ++iter;
+OutputT map_reduce(InputIter begin, InputIter end, MapF map, ReduceF reduce,
+                   Worker_pool *pool) {
+  shcore::Synchronized_queue<std::optional<IntermediateT>> results;
+  const auto group = pool->create_group();
+  size_t count = 0;
+
+  // jobs use the queue, if reduce throws they need to finish before it goes
+  // out of scope
+  shcore::on_leave_scope finish_jobs([&group]() {
+    group->cancel();
+
+    try {
+      group->wait();
+    } catch (...) {
+      // already handling an exception
+    }
+  });
+
+  // schedule the computation
+  for (auto iter = begin; iter != end; ++iter, ++count) {
+    pool->submit(group, [&results, map, iter]() {
+      try {
+        results.push(std::optional<IntermediateT>{map(*iter)});
+      } catch (...) {
+        // caller expects a value from each job
+        results.push(std::optional<IntermediateT>{});
+        throw;
+      }
+    });
   }
 
-  // wait for threads to finish
+  // wait for the results
   auto result = OutputT();
-  int threads_left = workers.size();
-  while (threads_left > 0) {
-    std::pair<size_t, IntermediateT> r = results.pop();
 
-    workers[r.first].join();
-    threads_left--;
+  for (size_t i = 0; i < count; ++i) {
+    const auto r = detail::pop_result(&results, pool);
 
-    result = reduce(result, r.second);
+    if (r) result = reduce(result, *r);
   }
 
+  finish_jobs.cancel();
+  group->wait();
+
   return result;
 }
 
+template <class OutputT, class IntermediateT, class InputIter, class MapF,
+          class ReduceF>
+OutputT map_reduce(InputIter begin, InputIter end, MapF map, ReduceF reduce) {
+  return map_reduce<OutputT, IntermediateT>(begin, end, std::move(map),
+                                            std::move(reduce),
+                                            default_worker_pool());
+}
+
+/**
+ * Calls fn on each value of the given list, using at most max_threads worker
+ * threads of the given pool. Each worker takes the next value as soon as it's
+ * done with the previous one, so a slow item only delays the worker processing
+ * it.
+ *
+ * fn is called in a worker thread. Returns once all values were processed.
+ *
+ * @throws any exception thrown by fn, processing stops in the worker which
+ *         has thrown it
+ */
+template <class InputIter, class F>
+void for_each_in_parallel(InputIter begin, InputIter end, size_t max_threads,
+                          F fn, Worker_pool *pool = default_worker_pool()) {
+  const auto count = static_cast<size_t>(std::distance(begin, end));
+
+  if (0 == count) return;
+
+  std::mutex mutex;
+  auto next = begin;
+
+  const auto worker = [&mutex, &next, end, &fn]() {
+    while (true) {
+      InputIter current;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (next == end) return;
+
+        current = next++;
+      }
+
+      fn(*current);
+    }
+  };
+
+  const auto group = pool->create_group();
+  const auto thread_count = std::min(count, std::max<size_t>(max_threads, 1));
+
+  // workers use the local variables, they need to finish before these go out
+  // of scope
+  shcore::on_leave_scope finish_jobs([&group]() {
+    group->cancel();
+
+    try {
+      group->wait();
+    } catch (...) {
+      // already handling an exception
+    }
+  });
+
+  for (size_t i = 0; i < thread_count; ++i) {
+    pool->submit(group, worker);
+  }
+
+  finish_jobs.cancel();
+  group->wait();
+}
+
 }  // namespace utils
 }  // namespace mysqlshdk
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -32,6 +32,7 @@
 #include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <deque>
 #include <string>
 
@@ -49,6 +50,30 @@ void Buffered_input::open(const std::string &filepath_) {
     throw std::runtime_error(filepath_ + ": " + errno_to_string(err) +
                              " (error code " + std::to_string(err) + ")");
   }
+
+  m_eof = false;
+  m_pos = m_end = m_buffer;
+  m_bytes_processed = 0;
+  m_bytes_remaining = std::numeric_limits<size_t>::max();
+}
+
+void Buffered_input::open(const std::string &filepath_, size_t offset,
+                          size_t length) {
+  open(filepath_);
+
+#ifdef _WIN32
+  const auto pos = ::_lseeki64(m_fd, offset, SEEK_SET);
+#else
+  const auto pos = ::lseek(m_fd, offset, SEEK_SET);
+#endif
+  if (pos < 0) {
+    int err = errno;
+    throw std::runtime_error(filepath_ + ": " + errno_to_string(err) +
+                             " (error code " + std::to_string(err) + ")");
+  }
+
+  m_bytes_processed = offset;
+  m_bytes_remaining = length;
 }
 
 void Buffered_input::close() {
@@ -90,16 +115,19 @@ void Buffered_input::fill_buffer() {
   }
 
   m_pos = m_buffer;
+  const auto to_read = std::min(BUFFER_SIZE, m_bytes_remaining);
 #ifdef _WIN32
-  int bytes = ::_read(m_fd, m_buffer, BUFFER_SIZE);
+  int bytes = ::_read(m_fd, m_buffer, static_cast<unsigned int>(to_read));
 #else
-  ssize_t bytes = ::read(m_fd, m_buffer, BUFFER_SIZE);
+  ssize_t bytes = ::read(m_fd, m_buffer, to_read);
 #endif
 
   if (bytes < 0) {
     bytes = 0;
   }
 
+  m_bytes_remaining -= bytes;
+
   m_end = m_buffer + bytes;
 
   if (m_pos == m_end) {
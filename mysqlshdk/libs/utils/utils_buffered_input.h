@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -25,6 +25,7 @@
 #define MYSQLSHDK_LIBS_UTILS_UTILS_BUFFERED_INPUT_H_
 
 #include <string.h>
+#include <limits>
 #include <string>
 
 #include "mysqlshdk/libs/utils/utils_general.h"
@@ -51,6 +52,12 @@ class Buffered_input {
 
   void open(const std::string &filepath_);
 
+  /**
+   * Opens the file and limits the input to the given byte range. Reported
+   * offsets are relative to the beginning of the file.
+   */
+  void open(const std::string &filepath_, size_t offset, size_t length);
+
   bool eof() { return m_eof; }
 
   byte peek() {
@@ -60,7 +67,25 @@ class Buffered_input {
     return *m_pos;
   }
 
-  void seek(byte *pos) { m_pos = pos > m_end ? m_end : pos; }
+  /**
+   * Consumes the buffered data up to the given position, which must not
+   * precede the current one.
+   */
+  void seek(const byte *pos) {
+    const auto target = pos > m_end ? m_end : pos;
+    m_bytes_processed += target - m_pos;
+    m_pos = m_buffer + (target - m_buffer);
+  }
+
+  /**
+   * Appends the buffered data up to the given position to the target, and
+   * consumes it.
+   */
+  void get(const byte *pos, std::string *target) {
+    const auto target_pos = pos > m_end ? m_end : pos;
+    target->append(reinterpret_cast<const char *>(m_pos), target_pos - m_pos);
+    seek(target_pos);
+  }
 
   byte get() {
     byte c = peek();
@@ -93,6 +118,7 @@ class Buffered_input {
   byte *m_pos = m_buffer;
   byte *m_end = m_buffer;
   size_t m_bytes_processed = 0;
+  size_t m_bytes_remaining = std::numeric_limits<size_t>::max();
 };
 
 }  // namespace shcore
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/utils/utils_scan.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SCAN_HAVE_SSE2
+#include <emmintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SCAN_HAVE_AVX2
+#include <immintrin.h>
+#endif  // __GNUC__ || __clang__
+#endif  // __x86_64__ || _M_X64
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif  // _MSC_VER
+
+namespace shcore {
+
+namespace {
+
+using Find_char_function = const char *(*)(const char *, const char *, char);
+
+inline unsigned count_trailing_zeros(uint32_t mask) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return index;
+#else
+  return __builtin_ctz(mask);
+#endif  // _MSC_VER
+}
+
+#ifdef SCAN_HAVE_SSE2
+
+// SSE2 is available on all x86-64 CPUs, no need for a runtime check
+const char *find_char_sse2(const char *first, const char *last, char c) {
+  const auto needle = _mm_set1_epi8(c);
+
+  while (last - first >= 16) {
+    const auto block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+    const auto mask = static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)));
+
+    if (mask) {
+      return first + count_trailing_zeros(mask);
+    }
+
+    first += 16;
+  }
+
+  return find_char_scalar(first, last, c);
+}
+
+#endif  // SCAN_HAVE_SSE2
+
+#ifdef SCAN_HAVE_AVX2
+
+__attribute__((target("avx2"))) const char *find_char_avx2(const char *first,
+                                                           const char *last,
+                                                           char c) {
+  const auto needle = _mm256_set1_epi8(c);
+
+  while (last - first >= 32) {
+    const auto block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+    const auto mask = static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)));
+
+    if (mask) {
+      return first + count_trailing_zeros(mask);
+    }
+
+    first += 32;
+  }
+
+  return find_char_sse2(first, last, c);
+}
+
+#endif  // SCAN_HAVE_AVX2
+
+struct Find_char_implementation {
+  Find_char_function function;
+  const char *name;
+};
+
+Find_char_implementation select_find_char() {
+#ifdef SCAN_HAVE_AVX2
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx2")) {
+    return {find_char_avx2, "avx2"};
+  }
+#endif  // SCAN_HAVE_AVX2
+
+#ifdef SCAN_HAVE_SSE2
+  return {find_char_sse2, "sse2"};
+#else
+  return {find_char_scalar, "scalar"};
+#endif  // SCAN_HAVE_SSE2
+}
+
+const Find_char_implementation &find_char_impl() {
+  static const auto s_impl = select_find_char();
+  return s_impl;
+}
+
+}  // namespace
+
+const char *find_char_scalar(const char *first, const char *last, char c) {
+  if (first >= last) {
+    return last;
+  }
+
+  const auto result = static_cast<const char *>(
+      memchr(first, static_cast<unsigned char>(c), last - first));
+
+  return result ? result : last;
+}
+
+const char *find_char(const char *first, const char *last, char c) {
+  return find_char_impl().function(first, last, c);
+}
+
+const char *find_char_implementation() { return find_char_impl().name; }
+
+}  // namespace shcore
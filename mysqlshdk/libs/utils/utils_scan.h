@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_LIBS_UTILS_UTILS_SCAN_H_
+#define MYSQLSHDK_LIBS_UTILS_UTILS_SCAN_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace shcore {
+
+/**
+ * Searches for the first occurrence of the given character in the range
+ * [first, last).
+ *
+ * Uses the widest vector instructions supported by the CPU (AVX2 or SSE2 on
+ * x86-64, detected at runtime), falls back to the scalar implementation on
+ * other platforms.
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param c Character to look for.
+ *
+ * @returns Pointer to the first matching character, last if not found.
+ */
+const char *find_char(const char *first, const char *last, char c);
+
+inline const uint8_t *find_char(const uint8_t *first, const uint8_t *last,
+                                uint8_t c) {
+  return reinterpret_cast<const uint8_t *>(
+      find_char(reinterpret_cast<const char *>(first),
+                reinterpret_cast<const char *>(last), static_cast<char>(c)));
+}
+
+/**
+ * Same as find_char(), but always uses the scalar implementation.
+ */
+const char *find_char_scalar(const char *first, const char *last, char c);
+
+/**
+ * Provides name of the implementation used by find_char(), i.e. "avx2".
+ */
+const char *find_char_implementation();
+
+}  // namespace shcore
+
+#endif  // MYSQLSHDK_LIBS_UTILS_UTILS_SCAN_H_
@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include "mysqlshdk/libs/utils/worker_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "mysqlshdk/include/shellcore/scoped_contexts.h"
+
+namespace mysqlshdk {
+namespace utils {
+
+namespace {
+
+// worker threads which don't get any jobs for this long are stopped
+constexpr auto k_idle_timeout = std::chrono::seconds(30);
+
+// pool and index of the worker running in the current thread
+thread_local const Worker_pool *t_pool = nullptr;
+thread_local std::size_t t_index = 0;
+
+/**
+ * Wraps the job, so that it's executed using the contexts (logger, console,
+ * etc.) of the current thread.
+ */
+Worker_pool::Job with_current_contexts(Worker_pool::Job job) {
+  if (!job) return job;
+
+  return [job = std::move(job), logger = shcore::current_logger(true),
+          shell_opts = mysqlsh::current_shell_options(true),
+          interrupt = shcore::current_interrupt(true),
+          console = mysqlsh::current_console(true),
+          ssh_manager = mysqlshdk::ssh::current_ssh_manager(true),
+          log_sql = shcore::current_log_sql(true)]() {
+    mysqlsh::Scoped_logger scoped_logger(logger);
+    mysqlsh::Scoped_shell_options scoped_shell_opts(shell_opts);
+    mysqlsh::Scoped_interrupt scoped_interrupt(interrupt);
+    mysqlsh::Scoped_console scoped_console(console);
+    mysqlsh::Scoped_ssh_manager scoped_ssh_manager(ssh_manager);
+    mysqlsh::Scoped_log_sql scoped_log_sql(log_sql);
+
+    job();
+  };
+}
+
+}  // namespace
+
+void Worker_pool::Job_group::wait() {
+  // a worker thread which waits for other jobs has to help to execute them,
+  // otherwise all workers could end up waiting
+  const auto help = m_pool->in_worker_thread();
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (m_pending > 0) {
+    if (help) {
+      lock.unlock();
+      const auto executed = m_pool->run_pending_job();
+      lock.lock();
+
+      if (!executed && m_pending > 0) {
+        // remaining jobs are executed by other workers, check periodically if
+        // they've submitted something new
+        m_all_done.wait_for(lock, std::chrono::milliseconds(10));
+      }
+    } else {
+      m_all_done.wait(lock);
+    }
+  }
+
+  if (m_error) std::rethrow_exception(m_error);
+}
+
+void Worker_pool::Job_group::job_added() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  ++m_pending;
+}
+
+void Worker_pool::Job_group::job_done(std::exception_ptr error) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (error && !m_error) m_error = std::move(error);
+
+  if (0 == --m_pending) m_all_done.notify_all();
+}
+
+Worker_pool::Worker_pool(std::size_t max_threads, Thread_init thread_init)
+    : m_thread_init(std::move(thread_init)),
+      m_queues(std::max<std::size_t>(max_threads, 1)),
+      m_slots(m_queues.size()) {}
+
+Worker_pool::~Worker_pool() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+
+  m_job_ready.notify_all();
+
+  for (auto &slot : m_slots) {
+    if (slot.thread.joinable()) slot.thread.join();
+  }
+}
+
+bool Worker_pool::in_worker_thread() const { return this == t_pool; }
+
+std::shared_ptr<Worker_pool::Job_group> Worker_pool::create_group(
+    Clock::time_point deadline) {
+  return std::shared_ptr<Job_group>(new Job_group(this, deadline));
+}
+
+void Worker_pool::submit(const std::shared_ptr<Job_group> &group, Job job,
+                         Job on_skip) {
+  assert(group && this == group->m_pool);
+
+  group->job_added();
+
+  {
+    auto &queue = m_queues[m_next_queue++ % m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back({group, with_current_contexts(std::move(job)),
+                           with_current_contexts(std::move(on_skip))});
+  }
+
+  const auto queued = ++m_queued;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (m_idle > 0) m_job_ready.notify_one();
+
+  // start a new worker if there are more jobs than idle workers
+  if (queued > m_idle && m_running < m_slots.size()) start_worker();
+}
+
+bool Worker_pool::run_pending_job() {
+  Task task;
+
+  if (!try_pop(in_worker_thread() ? t_index : 0, &task)) return false;
+
+  run(&task);
+
+  return true;
+}
+
+bool Worker_pool::try_pop(std::size_t index, Task *task) {
+  if (0 == m_queued) return false;
+
+  const auto size = m_queues.size();
+
+  for (std::size_t i = 0; i < size; ++i) {
+    auto &queue = m_queues[(index + i) % size];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty()) continue;
+
+    // own jobs are taken in the order they were submitted, jobs of other
+    // workers are taken from the other end of their queues
+    if (0 == i) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    } else {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+
+    --m_queued;
+
+    return true;
+  }
+
+  return false;
+}
+
+void Worker_pool::run(Task *task) {
+  std::exception_ptr error;
+
+  try {
+    if (!task->group->cancelled()) {
+      task->job();
+    } else if (task->on_skip) {
+      task->on_skip();
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  task->group->job_done(std::move(error));
+}
+
+void Worker_pool::start_worker() {
+  // m_mutex is locked by the caller
+  for (std::size_t i = 0; i < m_slots.size(); ++i) {
+    auto &slot = m_slots[i];
+
+    if (slot.running) continue;
+
+    // thread which was stopped due to inactivity
+    if (slot.thread.joinable()) slot.thread.join();
+
+    slot.running = true;
+    ++m_running;
+    slot.thread = std::thread(&Worker_pool::worker, this, i);
+
+    return;
+  }
+}
+
+void Worker_pool::worker(std::size_t index) {
+  t_pool = this;
+  t_index = index;
+
+  const auto thread_data = m_thread_init ? m_thread_init() : nullptr;
+
+  while (true) {
+    {
+      Task task;
+
+      if (try_pop(index, &task)) {
+        run(&task);
+        continue;
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_queued > 0) continue;
+
+    if (!m_stop) {
+      ++m_idle;
+      m_job_ready.wait_for(lock, k_idle_timeout,
+                           [this]() { return m_stop || m_queued > 0; });
+      --m_idle;
+
+      if (m_queued > 0) continue;
+    }
+
+    // pool is being destroyed or this worker was idle for too long
+    m_slots[index].running = false;
+    --m_running;
+
+    break;
+  }
+}
+
+}  // namespace utils
+}  // namespace mysqlshdk
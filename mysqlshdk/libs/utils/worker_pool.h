@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef MYSQLSHDK_LIBS_UTILS_WORKER_POOL_H_
+#define MYSQLSHDK_LIBS_UTILS_WORKER_POOL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mysqlshdk {
+namespace utils {
+
+/**
+ * A bounded pool of worker threads, which can be shared by many operations.
+ *
+ * Worker threads are started on demand, up to the given limit, and finish
+ * after being idle for a while. Each worker has its own queue of jobs, jobs are
+ * distributed between these queues, a worker which runs out of jobs takes them
+ * from the queues of the other workers.
+ *
+ * Jobs are submitted as a part of a Job_group, which allows to wait for all of
+ * them to finish and to skip the ones which have not started yet, either when
+ * the group is cancelled or when its deadline expires.
+ *
+ * Jobs are executed using the logger, console, shell options, etc. of the
+ * thread which submitted them.
+ */
+class Worker_pool final {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Job = std::function<void()>;
+
+  /**
+   * Called in each worker thread when it starts, the returned value is
+   * released before the thread finishes. Allows to initialize libraries which
+   * hold per-thread state.
+   */
+  using Thread_init = std::function<std::shared_ptr<void>()>;
+
+  class Job_group final {
+   public:
+    Job_group(const Job_group &) = delete;
+    Job_group(Job_group &&) = delete;
+
+    Job_group &operator=(const Job_group &) = delete;
+    Job_group &operator=(Job_group &&) = delete;
+
+    ~Job_group() = default;
+
+    /**
+     * Jobs of this group which have not started yet are going to be skipped.
+     * Jobs which are already running are not interrupted.
+     */
+    void cancel() { m_cancelled = true; }
+
+    /**
+     * @returns true if group was cancelled or its deadline has expired
+     */
+    bool cancelled() const {
+      return m_cancelled || Clock::now() >= m_deadline;
+    }
+
+    /**
+     * Waits for all the jobs of this group to finish or to be skipped.
+     *
+     * If called from one of the worker threads, executes the pending jobs
+     * while waiting.
+     *
+     * @throws any exception thrown by one of the jobs, the first one is
+     *         reported
+     */
+    void wait();
+
+   private:
+    friend class Worker_pool;
+
+    Job_group(Worker_pool *pool, Clock::time_point deadline)
+        : m_pool(pool), m_deadline(deadline) {}
+
+    void job_added();
+
+    void job_done(std::exception_ptr error);
+
+    Worker_pool *m_pool;
+    Clock::time_point m_deadline;
+    std::atomic<bool> m_cancelled{false};
+
+    std::mutex m_mutex;
+    std::condition_variable m_all_done;
+    std::size_t m_pending = 0;
+    std::exception_ptr m_error;
+  };
+
+  Worker_pool() = delete;
+
+  /**
+   * @param max_threads maximum number of worker threads
+   * @param thread_init called when a worker thread starts
+   */
+  explicit Worker_pool(std::size_t max_threads, Thread_init thread_init = {});
+
+  Worker_pool(const Worker_pool &) = delete;
+  Worker_pool(Worker_pool &&) = delete;
+
+  Worker_pool &operator=(const Worker_pool &) = delete;
+  Worker_pool &operator=(Worker_pool &&) = delete;
+
+  /**
+   * Waits for the submitted jobs to finish and stops all worker threads.
+   */
+  ~Worker_pool();
+
+  std::size_t max_threads() const { return m_queues.size(); }
+
+  /**
+   * @returns true if called from one of the worker threads of this pool
+   */
+  bool in_worker_thread() const;
+
+  /**
+   * Creates a new group of jobs.
+   *
+   * @param deadline jobs which did not start before this time point are
+   *        skipped
+   */
+  std::shared_ptr<Job_group> create_group(
+      Clock::time_point deadline = Clock::time_point::max());
+
+  /**
+   * Schedules a job for execution.
+   *
+   * @param group group of the job
+   * @param job job to be executed in one of the worker threads
+   * @param on_skip called instead of the job if the group has been cancelled
+   *        before the job started
+   */
+  void submit(const std::shared_ptr<Job_group> &group, Job job,
+              Job on_skip = {});
+
+  /**
+   * Executes one of the pending jobs in the current thread.
+   *
+   * @returns false if there are no pending jobs
+   */
+  bool run_pending_job();
+
+ private:
+  struct Task {
+    std::shared_ptr<Job_group> group;
+    Job job;
+    Job on_skip;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  struct Slot {
+    std::thread thread;
+    bool running = false;
+  };
+
+  bool try_pop(std::size_t index, Task *task);
+
+  void run(Task *task);
+
+  void start_worker();
+
+  void worker(std::size_t index);
+
+  Thread_init m_thread_init;
+
+  std::vector<Queue> m_queues;
+  std::atomic<std::size_t> m_next_queue{0};
+  std::atomic<std::size_t> m_queued{0};
+
+  std::mutex m_mutex;
+  std::condition_variable m_job_ready;
+  std::vector<Slot> m_slots;
+  std::size_t m_running = 0;
+  std::size_t m_idle = 0;
+  bool m_stop = false;
+};
+
+}  // namespace utils
+}  // namespace mysqlshdk
+
+#endif  // MYSQLSHDK_LIBS_UTILS_WORKER_POOL_H_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, 2020 Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -27,6 +27,8 @@
 #include <stdlib.h>
 #include <stdexcept>
 
+#include "mysqlshdk/libs/utils/threads.h"
+
 #ifdef HAVE_V8
 namespace shcore {
 extern void JScript_context_init();
@@ -54,6 +56,9 @@ void global_init() {
 }
 
 void global_end() {
+  // worker threads need to finish before the library is deinitialized
+  mysqlshdk::utils::shutdown_default_worker_pool();
+
   thread_end();
   mysql_library_end();
 
@@ -62,13 +67,26 @@ void global_end() {
 #endif
 }
 
+namespace {
+
+// Mysql_thread objects can be nested, i.e. job executed by a worker thread
+// which was already initialized, only the outermost one (de)initializes the
+// thread
+thread_local int t_mysql_thread_depth = 0;
+
+}  // namespace
+
 Mysql_thread::Mysql_thread() {
-  if (mysql_thread_init()) {
+  if (0 == t_mysql_thread_depth && mysql_thread_init()) {
     throw std::runtime_error(
         "Cannot allocate specific memory for the MySQL thread.");
   }
+
+  ++t_mysql_thread_depth;
 }
 
-Mysql_thread::~Mysql_thread() { mysql_thread_end(); }
+Mysql_thread::~Mysql_thread() {
+  if (0 == --t_mysql_thread_depth) mysql_thread_end();
+}
 
 }  // namespace mysqlsh
@@ -507,6 +507,10 @@ Shell_options::Shell_options(int argc, char **argv,
     (&storage.force, false, SHCORE_BATCH_CONTINUE_ON_ERROR, cmdline("--force"),
         "In SQL batch mode, forces processing to continue if an error "
         "is found.", shcore::opts::Read_only<bool>())
+    (&storage.bulk_source, false, SHCORE_BULK_SOURCE, cmdline("--bulk-source"),
+        "In SQL batch mode, sends consecutive INSERT and REPLACE statements to "
+        "the server in multi-statement batches. Supported only by classic "
+        "sessions in non-interactive mode, when the JSON output is disabled.")
     (&storage.log_file,
         shcore::path::join_path(shcore::get_user_config_path(), "mysqlsh.log"),
         SHCORE_LOG_FILE_NAME, cmdline("--log-file=<path>"),
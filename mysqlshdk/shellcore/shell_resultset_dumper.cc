@@ -25,8 +25,11 @@
 #include "shellcore/shell_resultset_dumper.h"
 
 #include <algorithm>
+#include <charconv>
 #include <cinttypes>
+#include <cstring>
 #include <deque>
+#include <string_view>
 
 #include "ext/linenoise-ng/include/linenoise.h"
 #include "mysqlshdk/include/shellcore/base_shell.h"
@@ -47,8 +50,37 @@
 // in order to calculate column widths
 static constexpr const int k_pre_fetch_result_rows = 1000;
 
+// size of the buffer used when exporting rows, output is written to the
+// printer once it is filled
+static constexpr const size_t k_export_buffer_size = 64 * 1024;
+
 namespace mysqlsh {
 
+namespace {
+
+/**
+ * Returns pointer to the first non-ASCII character in the given range, or end
+ * if there are none. Checks eight bytes at a time.
+ */
+const char *skip_ascii(const char *text, const char *end) {
+  constexpr uint64_t k_high_bits = 0x8080808080808080ULL;
+  uint64_t word;
+
+  while (end - text >= static_cast<std::ptrdiff_t>(sizeof(word))) {
+    memcpy(&word, text, sizeof(word));
+
+    if (word & k_high_bits) break;
+
+    text += sizeof(word);
+  }
+
+  while (text < end && !(static_cast<unsigned char>(*text) & 0x80)) ++text;
+
+  return text;
+}
+
+}  // namespace
+
 /* Calculates the required buffer size and display size considering:
  * - Some single byte characters may require injection of escaped sequence \\
  * - Some multibyte characters are displayed in the space of a single character
@@ -152,6 +184,39 @@ std::tuple<size_t, size_t> get_utf8_sizes(const char *text, size_t length,
   }
 
 #else
+  {
+    // ASCII characters always occupy a single byte and a single space on
+    // screen, only the special characters need to be taken into account, no
+    // need to inspect them one by one using mblen()
+    const char *ascii_end = skip_ascii(index, end);
+    size_t zeros = 0;
+    size_t ctrl = 0;
+
+    for (const char *c = index; c < ascii_end; ++c) {
+      zeros += *c == '\0';
+      ctrl += *c == '\t' || *c == '\n' || *c == '\\';
+    }
+
+    char_count = byte_count = ascii_end - index;
+
+    // \0 printed as a space does not change the sizes
+    if (!flags.is_set(Print_flag::PRINT_0_AS_SPC)) {
+      if (flags.is_set(Print_flag::PRINT_0_AS_ESC)) {
+        char_count += zeros;
+        byte_count += zeros;
+      } else {
+        char_count -= zeros;
+      }
+    }
+
+    if (flags.is_set(Print_flag::PRINT_CTRL)) {
+      char_count += ctrl;
+      byte_count += ctrl;
+    }
+
+    index = ascii_end;
+  }
+
   std::mblen(NULL, 0);
   while (index < end) {
     int width = std::mblen(index, end - index);
@@ -359,6 +424,7 @@ class Field_formatter {
         // if a number is larger than expected (e.g. floating pt with lots of
         // decimals)
         m_buffer.assign(data, length);
+        m_length = length;
       } else {
         return false;
       }
@@ -367,11 +433,19 @@ class Field_formatter {
   }
 
   const std::string &str() const { return m_buffer; }
+
+  /**
+   * Formatted value, in case of tables this does not include the unused part
+   * of the buffer.
+   */
+  std::string_view view() const { return {m_buffer.data(), m_length}; }
+
   size_t get_max_display_length() const { return m_max_display_length; }
   size_t get_max_buffer_length() const { return m_max_buffer_length; }
 
  private:
   std::string m_buffer;
+  size_t m_length = 0;
   size_t m_allocated;
   size_t m_zerofill;
   bool m_align_right;
@@ -414,37 +488,58 @@ class Field_formatter {
     }
 
     auto buffer = &m_buffer[0];
-    for (size_t index = 0; index < length; index++) {
-      if (m_flags.is_set(Print_flag::PRINT_0_AS_ESC) && text[index] == '\0') {
-        buffer[next_index++] = '\\';
-        buffer[next_index++] = '0';
-      } else if (m_flags.is_set(Print_flag::PRINT_0_AS_SPC) &&
-                 text[index] == '\0') {
-        buffer[next_index++] = ' ';
-      } else if (m_flags.is_set(Print_flag::PRINT_CTRL) &&
-                 text[index] == '\t') {
-        buffer[next_index++] = '\\';
-        buffer[next_index++] = 't';
-      } else if (m_flags.is_set(Print_flag::PRINT_CTRL) &&
-                 text[index] == '\n') {
-        buffer[next_index++] = '\\';
-        buffer[next_index++] = 'n';
-      } else if (m_flags.is_set(Print_flag::PRINT_CTRL) &&
-                 text[index] == '\\') {
-        buffer[next_index++] = '\\';
-        buffer[next_index++] = '\\';
-      } else {
-        buffer[next_index++] = text[index];
+
+    if (!m_flags.is_set(Print_flag::PRINT_0_AS_ESC) &&
+        !m_flags.is_set(Print_flag::PRINT_CTRL)) {
+      // no escape sequences are injected, data is copied as is
+      memcpy(buffer + next_index, text, length);
+
+      if (m_flags.is_set(Print_flag::PRINT_0_AS_SPC)) {
+        auto zero = static_cast<char *>(memchr(buffer + next_index, 0, length));
+
+        while (zero) {
+          *zero = ' ';
+          zero = static_cast<char *>(
+              memchr(zero + 1, 0, buffer + next_index + length - zero - 1));
+        }
+      }
+
+      next_index += length;
+    } else {
+      for (size_t index = 0; index < length; index++) {
+        if (m_flags.is_set(Print_flag::PRINT_0_AS_ESC) && text[index] == '\0') {
+          buffer[next_index++] = '\\';
+          buffer[next_index++] = '0';
+        } else if (m_flags.is_set(Print_flag::PRINT_0_AS_SPC) &&
+                   text[index] == '\0') {
+          buffer[next_index++] = ' ';
+        } else if (m_flags.is_set(Print_flag::PRINT_CTRL) &&
+                   text[index] == '\t') {
+          buffer[next_index++] = '\\';
+          buffer[next_index++] = 't';
+        } else if (m_flags.is_set(Print_flag::PRINT_CTRL) &&
+                   text[index] == '\n') {
+          buffer[next_index++] = '\\';
+          buffer[next_index++] = 'n';
+        } else if (m_flags.is_set(Print_flag::PRINT_CTRL) &&
+                   text[index] == '\\') {
+          buffer[next_index++] = '\\';
+          buffer[next_index++] = '\\';
+        } else {
+          buffer[next_index++] = text[index];
+        }
       }
     }
 
     if (m_format == ResultFormat::TABLE) {
       // If some multibyte characters were found, we need to truncate the buffer
       // adding the 'lost' characters
-      buffer[std::min(m_allocated,
-                      m_max_display_length + (buffer_size - display_size))] = 0;
+      m_length = std::min(m_allocated,
+                          m_max_display_length + (buffer_size - display_size));
+      buffer[m_length] = 0;
     } else {
       m_buffer.resize(next_index);
+      m_length = next_index;
     }
 
     return true;
@@ -488,6 +583,353 @@ class String_printer : public Resultset_printer {
   std::string m_output;
 };
 
+/**
+ * Formats rows directly into a buffer which is written to the printer in
+ * blocks. Each column gets an encoder selected using its metadata, so no
+ * intermediate objects are created for each row.
+ *
+ * Used by the formats meant to export data: json/raw, json/array and csv.
+ */
+class Row_exporter {
+ public:
+  enum class Format { JSON, CSV };
+
+  Row_exporter(Format format,
+               const std::vector<mysqlshdk::db::Column> &metadata,
+               Resultset_printer *printer)
+      : m_format(format),
+        m_printer(printer),
+        m_binary_limit(mysqlsh::current_shell_options()->get().binary_limit) {
+    m_buffer.reserve(2 * k_export_buffer_size);
+    m_fields.reserve(metadata.size());
+
+    for (const auto &column : metadata) {
+      Field field;
+
+      switch (column.get_type()) {
+        case mysqlshdk::db::Type::Integer:
+          field.encoder = Encoder::INTEGER;
+          break;
+        case mysqlshdk::db::Type::UInteger:
+          field.encoder = Encoder::UINTEGER;
+          break;
+        case mysqlshdk::db::Type::Float:
+          field.encoder = Encoder::FLOAT;
+          break;
+        case mysqlshdk::db::Type::Double:
+          field.encoder = Encoder::DOUBLE;
+          break;
+        case mysqlshdk::db::Type::Decimal:
+          field.encoder = Encoder::DECIMAL;
+          break;
+        case mysqlshdk::db::Type::Bit:
+          field.encoder = Encoder::BIT;
+          break;
+        case mysqlshdk::db::Type::Bytes:
+          field.encoder = Encoder::BYTES;
+          break;
+        case mysqlshdk::db::Type::Json:
+          field.encoder = Encoder::JSON;
+          break;
+        default:
+          field.encoder = Encoder::STRING;
+          break;
+      }
+
+      if (Format::JSON == m_format) {
+        append_json_string(column.get_column_label(), &field.label);
+        field.label += ':';
+      } else {
+        append_csv_string(column.get_column_label(), &field.label);
+      }
+
+      m_fields.emplace_back(std::move(field));
+    }
+  }
+
+  Row_exporter(const Row_exporter &) = delete;
+  Row_exporter(Row_exporter &&) = delete;
+  Row_exporter &operator=(const Row_exporter &) = delete;
+  Row_exporter &operator=(Row_exporter &&) = delete;
+
+  ~Row_exporter() = default;
+
+  /**
+   * Appends a line with the column names, CSV only.
+   */
+  void append_header() {
+    assert(Format::CSV == m_format);
+
+    for (size_t i = 0; i < m_fields.size(); ++i) {
+      if (i > 0) m_buffer += ',';
+      m_buffer += m_fields[i].label;
+    }
+
+    m_buffer += '\n';
+  }
+
+  void append_row(const mysqlshdk::db::IRow *row) {
+    if (Format::JSON == m_format) {
+      append_json_row(row);
+    } else {
+      append_csv_row(row);
+    }
+
+    if (m_buffer.size() >= k_export_buffer_size) flush();
+  }
+
+  void append(std::string_view text) { m_buffer.append(text); }
+
+  void flush() {
+    if (!m_buffer.empty()) {
+      m_printer->raw_print(m_buffer);
+      m_buffer.clear();
+    }
+  }
+
+ private:
+  enum class Encoder {
+    INTEGER,
+    UINTEGER,
+    FLOAT,
+    DOUBLE,
+    DECIMAL,
+    BIT,
+    BYTES,
+    JSON,
+    STRING
+  };
+
+  struct Field {
+    Encoder encoder = Encoder::STRING;
+    // JSON: quoted key followed by a colon, CSV: column header
+    std::string label;
+  };
+
+  static void append_json_string(std::string_view s, std::string *out) {
+    static constexpr char k_hex_digits[] = "0123456789ABCDEF";
+
+    out->push_back('"');
+
+    auto begin = s.data();
+    const auto end = begin + s.length();
+
+    for (auto p = begin; p < end; ++p) {
+      const auto c = static_cast<unsigned char>(*p);
+
+      if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+      out->append(begin, p - begin);
+      begin = p + 1;
+
+      out->push_back('\\');
+
+      switch (c) {
+        case '"':
+        case '\\':
+          out->push_back(c);
+          break;
+        case '\b':
+          out->push_back('b');
+          break;
+        case '\f':
+          out->push_back('f');
+          break;
+        case '\n':
+          out->push_back('n');
+          break;
+        case '\r':
+          out->push_back('r');
+          break;
+        case '\t':
+          out->push_back('t');
+          break;
+        default:
+          out->append("u00");
+          out->push_back(k_hex_digits[c >> 4]);
+          out->push_back(k_hex_digits[c & 0xF]);
+          break;
+      }
+    }
+
+    out->append(begin, end - begin);
+    out->push_back('"');
+  }
+
+  /**
+   * Values are quoted if they are empty (to distinguish them from NULL
+   * values) or contain special characters. \0 characters are written as \\0.
+   */
+  static void append_csv_string(std::string_view s, std::string *out) {
+    static constexpr std::string_view k_special{",\"\r\n\0", 5};
+
+    if (!s.empty() && std::string_view::npos == s.find_first_of(k_special)) {
+      out->append(s);
+      return;
+    }
+
+    out->push_back('"');
+
+    auto begin = s.data();
+    const auto end = begin + s.length();
+
+    for (auto p = begin; p < end; ++p) {
+      if ('"' == *p) {
+        out->append(begin, p - begin + 1);
+        out->push_back('"');
+        begin = p + 1;
+      } else if ('\0' == *p) {
+        out->append(begin, p - begin);
+        out->append("\\0");
+        begin = p + 1;
+      }
+    }
+
+    out->append(begin, end - begin);
+    out->push_back('"');
+  }
+
+  template <typename T>
+  void append_number(T value) {
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    m_buffer.append(buffer, result.ptr - buffer);
+  }
+
+  void append_double(double value) {
+    // same conversion which is used by shcore::JSON_dumper
+    char buffer[32];
+    const auto length = shcore::fmt_double(value, buffer, sizeof(buffer));
+    m_buffer.append(buffer, length);
+  }
+
+  void append_string(std::string_view s) {
+    if (Format::JSON == m_format) {
+      append_json_string(s, &m_buffer);
+    } else {
+      append_csv_string(s, &m_buffer);
+    }
+  }
+
+  void append_value(const mysqlshdk::db::IRow *row, uint32_t index,
+                    Encoder encoder) {
+    switch (encoder) {
+      case Encoder::INTEGER:
+        append_number(row->get_int(index));
+        break;
+
+      case Encoder::UINTEGER:
+        append_number(row->get_uint(index));
+        break;
+
+      case Encoder::FLOAT:
+        if (Format::JSON == m_format) {
+          append_double(static_cast<double>(row->get_float(index)));
+        } else {
+          // same representation which is used by the tabbed format
+          m_buffer.append(shcore::ftoa(row->get_float(index)));
+        }
+        break;
+
+      case Encoder::DOUBLE:
+        if (Format::JSON == m_format) {
+          append_double(row->get_double(index));
+        } else {
+          m_buffer.append(shcore::dtoa(row->get_double(index)));
+        }
+        break;
+
+      case Encoder::DECIMAL:
+        if (Format::JSON == m_format) {
+          append_double(static_cast<double>(row->get_float(index)));
+        } else {
+          // keep the exact value
+          m_buffer.append(row->get_as_string(index));
+        }
+        break;
+
+      case Encoder::BIT: {
+        const auto [bit_value, bit_size] = row->get_bit(index);
+        append_string(shcore::bits_to_string_hex(bit_value, bit_size));
+        break;
+      }
+
+      case Encoder::BYTES: {
+        const auto data = row->get_string_data(index);
+
+        if (Format::JSON == m_format) {
+          // At most binary-limit + 1 bytes are written, when the extra byte is
+          // written, it will be an indicator for the consumer of the data that
+          // a truncation happened
+          const auto length =
+              m_binary_limit > 0 ? std::min(data.second, m_binary_limit + 1)
+                                 : data.second;
+
+          m_encoded.clear();
+          shcore::encode_base64(
+              reinterpret_cast<const unsigned char *>(data.first), length,
+              &m_encoded);
+          append_string(m_encoded);
+        } else {
+          m_buffer.append(shcore::string_to_hex({data.first, data.second}));
+        }
+        break;
+      }
+
+      case Encoder::JSON:
+        if (Format::JSON == m_format) {
+          // documents are normalized, just like in case of shcore::JSON_dumper
+          shcore::JSON_dumper dumper;
+          dumper.append_json(row->get_string(index));
+          m_buffer.append(dumper.str());
+        } else {
+          append_string(row->get_string(index));
+        }
+        break;
+
+      case Encoder::STRING:
+        append_string(row->get_as_string(index));
+        break;
+    }
+  }
+
+  void append_json_row(const mysqlshdk::db::IRow *row) {
+    m_buffer += '{';
+
+    for (uint32_t i = 0; i < m_fields.size(); ++i) {
+      if (i > 0) m_buffer += ',';
+
+      m_buffer += m_fields[i].label;
+
+      if (row->is_null(i)) {
+        m_buffer += "null";
+      } else {
+        append_value(row, i, m_fields[i].encoder);
+      }
+    }
+
+    m_buffer += '}';
+  }
+
+  void append_csv_row(const mysqlshdk::db::IRow *row) {
+    for (uint32_t i = 0; i < m_fields.size(); ++i) {
+      if (i > 0) m_buffer += ',';
+
+      // NULL values are written as empty, unquoted fields
+      if (!row->is_null(i)) append_value(row, i, m_fields[i].encoder);
+    }
+
+    m_buffer += '\n';
+  }
+
+  Format m_format;
+  Resultset_printer *m_printer;
+  size_t m_binary_limit;
+  std::vector<Field> m_fields;
+  std::string m_buffer;
+  std::string m_encoded;
+};
+
 }  // namespace
 
 Resultset_dumper_base::Resultset_dumper_base(
@@ -545,6 +987,8 @@ size_t Resultset_dumper::dump(const std::string &item_label, bool is_query,
           count = dump_vertical();
         else if (m_format == "table")
           count = dump_table();
+        else if (m_format == "csv")
+          count = dump_csv();
         else
           count = dump_tabbed();
 
@@ -662,6 +1106,28 @@ size_t Resultset_dumper_base::dump_documents(bool is_doc_result) {
 
   if (!row) return row_count;
 
+  if (!pretty && !is_doc_result) {
+    Row_exporter exporter(Row_exporter::Format::JSON, metadata,
+                          m_printer.get());
+
+    if (as_array) exporter.append("[\n");
+
+    while (row && !m_cancelled) {
+      if (row_count > 0) exporter.append(as_array ? ",\n" : "\n");
+
+      exporter.append_row(row);
+
+      row_count++;
+      row = m_result->fetch_one();
+    }
+
+    exporter.append("\n");
+    if (as_array) exporter.append("]\n");
+    exporter.flush();
+
+    return row_count;
+  }
+
   if (as_array) m_printer->raw_print("[\n");
   while (row) {
     shcore::JSON_dumper dumper(
@@ -731,6 +1197,28 @@ size_t Resultset_dumper_base::dump_tabbed() {
   return row_index;
 }
 
+size_t Resultset_dumper_base::dump_csv() {
+  const auto &metadata = m_result->get_metadata();
+  auto row = m_result->fetch_one();
+  size_t row_count = 0;
+
+  if (!row) return row_count;
+
+  Row_exporter exporter(Row_exporter::Format::CSV, metadata, m_printer.get());
+  exporter.append_header();
+
+  while (row && !m_cancelled) {
+    exporter.append_row(row);
+
+    row_count++;
+    row = m_result->fetch_one();
+  }
+
+  exporter.flush();
+
+  return row_count;
+}
+
 size_t Resultset_dumper_base::dump_vertical() {
   return format_vertical(true, true, 0);
 }
@@ -941,49 +1429,46 @@ size_t Resultset_dumper_base::dump_table() {
   }
   m_printer->print(separator);
 
-  // Print pre-fetched records
-  for (const auto &row : pre_fetched_rows) {
+  // each row is formatted into a single buffer, which is reused by all rows,
+  // and printed at once
+  std::string line;
+
+  const auto print_row = [&](const mysqlshdk::db::IRow *row) {
     ++num_records;
-    m_printer->print("| ");
+    line.assign("| ");
 
     for (size_t field_index = 0; field_index < field_count; field_index++) {
-      if (fmt[field_index].put(&row, field_index)) {
-        m_printer->print(fmt[field_index].str());
+      if (fmt[field_index].put(row, field_index)) {
+        line.append(fmt[field_index].view());
       } else {
         assert(mysqlshdk::db::is_string_type(metadata[field_index].get_type()));
-        if (row.get_type(field_index) == mysqlshdk::db::Type::Bytes) {
+        if (row->get_type(field_index) == mysqlshdk::db::Type::Bytes) {
           const char *data;
           size_t length;
-          std::tie(data, length) = row.get_string_data(field_index);
-          m_printer->print(shcore::string_to_hex({data, length}));
+          std::tie(data, length) = row->get_string_data(field_index);
+          line.append(shcore::string_to_hex({data, length}));
         } else {
-          m_printer->print(row.get_as_string(field_index));
+          line.append(row->get_as_string(field_index));
         }
       }
-      if (field_index < field_count - 1) m_printer->print(" | ");
+      line.append(field_index < field_count - 1 ? " | " : " |\n");
     }
-    m_printer->print(" |\n");
+
+    m_printer->print(line);
+  };
+
+  // Print pre-fetched records
+  for (const auto &row : pre_fetched_rows) {
+    print_row(&row);
 
     if (m_cancelled) break;
   }
+
   // Now prints the remaining records
   if (!m_cancelled) {
     auto row = m_result->fetch_one();
     while (row && !m_cancelled) {
-      ++num_records;
-      m_printer->print("| ");
-
-      for (size_t field_index = 0; field_index < field_count; field_index++) {
-        if (fmt[field_index].put(row, field_index)) {
-          m_printer->print(fmt[field_index].str());
-        } else {
-          assert(
-              mysqlshdk::db::is_string_type(metadata[field_index].get_type()));
-          m_printer->print(row->get_as_string(field_index));
-        }
-        if (field_index < field_count - 1) m_printer->print(" | ");
-      }
-      m_printer->print(" |\n");
+      print_row(row);
       row = m_result->fetch_one();
     }
   }
@@ -61,11 +61,51 @@ namespace shcore {
 
 namespace {
 const std::initializer_list<const char *> keyword_commands = {"source", "use"};
+
+// Statements which can be sent to the server in a multi-statement batch, these
+// do not produce a result and do not change the state of the client
+constexpr std::array<const char *, 2> k_batchable_statements = {"INSERT",
+                                                                 "REPLACE"};
+
+/**
+ * Checks if the SET statement (iterator needs to be positioned right after the
+ * SET keyword) changes the value of sql_mode.
+ */
+bool changes_sql_mode(mysqlshdk::utils::SQL_iterator *it) {
+  constexpr std::array<const char *, 4> mods = {"GLOBAL", "PERSIST", "SESSION",
+                                                "LOCAL"};
+  auto next = shcore::str_upper(it->next_token());
+
+  for (const char *mod : mods)
+    if (next.compare(mod) == 0) {
+      next = it->next_token();
+      break;
+    }
+
+  while (next == "@") next = it->next_token();
+
+  return shcore::str_upper(next).find("SQL_MODE") != std::string::npos;
+}
+
+bool is_batchable(const std::string &statement) {
+  mysqlshdk::utils::SQL_iterator it(statement);
+  const auto keyword = shcore::str_upper(it.next_token());
+
+  for (const char *k : k_batchable_statements) {
+    if (keyword.compare(k) == 0) return true;
+  }
+
+  return false;
 }
+}  // namespace
 
 // How many bytes at a time to process when executing large SQL scripts
 static constexpr auto k_sql_chunk_size = 64 * 1024;
 
+// Size of the multi-statement batches sent in bulk source mode, a single
+// statement which is bigger than this is sent on its own
+static constexpr size_t k_sql_batch_size = 1024 * 1024;
+
 Shell_sql::Context::Context(Shell_sql *parent_)
     : parent(parent_),
       splitter(
@@ -181,6 +221,7 @@ bool Shell_sql::process_sql(const char *query_str, size_t query_len,
     }
   }
 
+  const auto offset = _last_handled.size();
   _last_handled.append(query_str, query_len).append(delimiter);
 
   // check if the value of sql_mode have changed - statement can either begin
@@ -188,27 +229,69 @@ bool Shell_sql::process_sql(const char *query_str, size_t query_len,
   // comment e.g.: /*...*/ set sql_mode...
   if (ret_val && query_len > 12 &&
       (query_str[2] == 't' || query_str[2] == 'T' || query_str[1] == '*')) {
-    mysqlshdk::utils::SQL_iterator it(_last_handled);
-    auto next = shcore::str_upper(it.next_token());
-    if (next.compare("SET") == 0) {
-      constexpr std::array<const char *, 4> mods = {"GLOBAL", "PERSIST",
-                                                    "SESSION", "LOCAL"};
-      next = shcore::str_upper(it.next_token());
-      for (const char *mod : mods)
-        if (next.compare(mod) == 0) {
-          next = it.next_token();
-          break;
-        }
+    mysqlshdk::utils::SQL_iterator it(_last_handled, offset);
 
-      while (next == "@") next = it.next_token();
+    if (shcore::str_caseeq(it.next_token(), "SET") && changes_sql_mode(&it)) {
+      session->refresh_sql_mode();
+      splitter->set_ansi_quotes(session->ansi_quotes_enabled());
+    }
+  }
 
-      if (shcore::str_upper(next).find("SQL_MODE") != std::string::npos) {
-        session->refresh_sql_mode();
-        splitter->set_ansi_quotes(session->ansi_quotes_enabled());
-      }
+  return ret_val;
+}
+
+bool Shell_sql::execute_batch(
+    Statement_batch *batch,
+    const std::shared_ptr<mysqlshdk::db::ISession> &session) {
+  const auto classic =
+      std::static_pointer_cast<mysqlshdk::db::mysql::Session>(session);
+  const auto total = batch->statements.size();
+  size_t next = 0;
+  bool ret_val = true;
+
+  // Install kill query as ^C handler
+  uint64_t conn_id = session->get_connection_id();
+  const auto &conn_opts = session->get_connection_options();
+  shcore::Interrupt_handler interrupt([this, conn_id, conn_opts]() {
+    kill_query(conn_id, conn_opts);
+    return true;
+  });
+
+  while (next < total) {
+    const auto offset = batch->statements[next].first;
+    size_t executed = 0;
+
+    try {
+      // information string is printed for each statement, just like when
+      // statements are executed one by one
+      classic->execute_batch(batch->sql.data() + offset,
+                             batch->sql.size() - offset, &executed,
+                             [](const char *info) {
+                               if (info && *info) {
+                                 mysqlsh::current_console()->print(
+                                     std::string{"\n"} + info + "\n");
+                               }
+                             });
+      break;
+    } catch (const mysqlshdk::db::Error &e) {
+      auto exc = shcore::Exception::mysql_error_with_code_and_state(
+          e.what(), e.code(), e.sqlstate());
+      next += executed;
+
+      if (next < total)
+        exc.set_file_context("", batch->statements[next].second);
+
+      print_exception(exc);
+      ret_val = false;
+
+      if (!mysqlsh::current_shell_options()->get().force) break;
+
+      // skip the failed statement and continue with the rest of the batch
+      ++next;
     }
   }
 
+  batch->clear();
   return ret_val;
 }
 
@@ -222,35 +305,81 @@ bool Shell_sql::handle_input_stream(std::istream *istream) {
       session = s->get_core_session();
   }
 
+  // in bulk source mode INSERT and REPLACE statements are sent to the server
+  // in multi-statement batches, this is supported only by the classic
+  // protocol; in interactive mode and when JSON output is enabled, statistics
+  // and warnings are printed for each statement, so they are executed one by
+  // one
+  const auto &options = mysqlsh::current_shell_options()->get();
+  const bool bulk_source =
+      options.bulk_source && !options.interactive &&
+      options.wrap_json == "off" &&
+      std::dynamic_pointer_cast<mysqlshdk::db::mysql::Session>(session);
+  Statement_batch batch;
+  std::string statement;
+
   mysqlshdk::utils::Sql_splitter *splitter = nullptr;
-  if (!mysqlshdk::utils::iterate_sql_stream(
-          istream, k_sql_chunk_size,
-          [&](const char *s, size_t len, const std::string &delim, size_t lnum,
-              size_t) {
-            std::string cmd(s, len);
-            std::string file;
-
-            if (shcore::str_beginswith(cmd.c_str(), "source"))
-              file = cmd.substr(6);
-            else if (shcore::str_beginswith(cmd.c_str(), "\\."))
-              file = cmd.substr(2);
-
-            bool ret = false;
-            if (!file.empty())
-              ret = _owner->handle_shell_command("\\source " + file);
-            else if (len > 0)
-              ret = process_sql(s, len, delim, lnum, session, splitter);
-            return ret ? ret : mysqlsh::current_shell_options()->get().force;
-          },
-          [](const std::string &err) {
-            mysqlsh::current_console()->print_error(err);
-          },
-          ansi_quotes_enabled(session), nullptr, &splitter)) {
+  bool ret_val = mysqlshdk::utils::iterate_sql_stream(
+      istream, k_sql_chunk_size,
+      [&](const char *s, size_t len, const std::string &delim, size_t lnum,
+          size_t) {
+        const auto force = mysqlsh::current_shell_options()->get().force;
+
+        if (bulk_source) {
+          if (len > 0 && delim == ";") {
+            statement.assign(s, len);
+
+            if (is_batchable(statement)) {
+              if (!batch.empty() &&
+                  batch.sql.size() + len > k_sql_batch_size &&
+                  !execute_batch(&batch, session) && !force)
+                return false;
+
+              batch.add(statement, lnum);
+              return true;
+            }
+          }
+
+          // statements need to be executed in order
+          if (!batch.empty() && !execute_batch(&batch, session) && !force)
+            return false;
+        }
+
+        const std::string_view cmd{s, len};
+        std::string file;
+
+        if (shcore::str_beginswith(cmd, "source"))
+          file.assign(s + 6, len - 6);
+        else if (shcore::str_beginswith(cmd, "\\."))
+          file.assign(s + 2, len - 2);
+
+        bool ret = false;
+        if (!file.empty())
+          ret = _owner->handle_shell_command("\\source " + file);
+        else if (len > 0)
+          ret = process_sql(s, len, delim, lnum, session, splitter);
+
+        // only the current statement is tracked when processing a stream, so
+        // memory usage does not depend on the size of the input
+        _last_handled.clear();
+
+        return ret ? ret : force;
+      },
+      [](const std::string &err) {
+        mysqlsh::current_console()->print_error(err);
+      },
+      ansi_quotes_enabled(session), nullptr, &splitter);
+
+  if (ret_val && !batch.empty())
+    ret_val = execute_batch(&batch, session) ||
+              mysqlsh::current_shell_options()->get().force;
+
+  if (!ret_val) {
     // signal error during input processing
     _result_processor(nullptr, {});
-    return false;
   }
-  return true;
+
+  return ret_val;
 }
 
 std::shared_ptr<mysqlshdk::db::ISession> Shell_sql::get_session() {
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/load/dump_reader.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Schedules all chunks of a synthetic dump, simulating the workers which are
+// loading the data.
+//
+// Usage: bench_load_scheduler [tables [threads]]
+
+int main(int argc, char **argv) {
+  const std::size_t num_tables = argc > 1 ? std::stoul(argv[1]) : 200000;
+  const std::size_t num_threads = argc > 2 ? std::stoul(argv[2]) : 32;
+
+  std::vector<mysqlsh::Dump_reader::Table_info> tables(num_tables);
+  mysqlsh::Dump_reader::Tables_with_data tables_with_data;
+  std::size_t total_chunks = 0;
+
+  std::srand(0);
+
+  for (std::size_t i = 0; i < num_tables; ++i) {
+    auto &table = tables[i];
+    table.schema = "schema" + std::to_string(i % 100);
+    table.table = "table" + std::to_string(i);
+    table.data_info.emplace_back();
+
+    auto &di = table.data_info.back();
+    di.owner = &table;
+    di.basename = table.table;
+    di.last_chunk_seen = true;
+
+    // most of the tables are small, some of them are big
+    const std::size_t chunks = 0 == i % 1000 ? 100 + std::rand() % 100 : 1;
+    di.chunked = chunks > 1;
+
+    for (std::size_t c = 0; c < chunks; ++c) {
+      di.available_chunks.emplace_back(
+          mysqlshdk::storage::IDirectory::File_info{
+              "chunk" + std::to_string(c),
+              static_cast<std::size_t>(1000 + std::rand() % 100000)});
+    }
+
+    total_chunks += chunks;
+    tables_with_data.insert(&di);
+  }
+
+  struct Worker {
+    mysqlsh::Dump_reader::Table_data_info *table = nullptr;
+    std::size_t size = 0;
+    std::size_t left = 0;
+  };
+
+  std::vector<Worker> workers(num_threads);
+  std::unordered_multimap<std::string, size_t> tables_being_loaded;
+  std::size_t scheduled = 0;
+
+  const auto t_start = std::chrono::steady_clock::now();
+
+  while (true) {
+    bool busy = false;
+
+    for (auto &worker : workers) {
+      if (!worker.table) {
+        const auto table = tables_with_data.schedule_chunk_proportionally(
+            tables_being_loaded, num_threads);
+
+        if (table) {
+          worker.table = table;
+          worker.size =
+              table->available_chunks[table->chunks_consumed]->size();
+          worker.left = 1 + std::rand() % 10;
+          tables_being_loaded.emplace(table->key(), worker.size);
+          tables_with_data.consume(table);
+          ++scheduled;
+        }
+      }
+
+      if (worker.table) busy = true;
+    }
+
+    if (!busy) break;
+
+    // simulate some progress
+    for (auto &worker : workers) {
+      if (worker.table && 0 == --worker.left) {
+        const auto range = tables_being_loaded.equal_range(worker.table->key());
+
+        for (auto it = range.first; it != range.second; ++it) {
+          if (it->second == worker.size) {
+            tables_being_loaded.erase(it);
+            break;
+          }
+        }
+
+        worker.table = nullptr;
+      }
+    }
+  }
+
+  const auto t_end = std::chrono::steady_clock::now();
+  const auto t_int_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_start);
+
+  std::cout << "# " << num_tables << " tables, " << total_chunks
+            << " chunks, " << num_threads << " threads\n";
+  std::cout << "# " << scheduled << " chunks scheduled @ " << t_int_ms.count()
+            << "ms\n";
+
+  return scheduled == total_chunks ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "unittest/gtest_clean.h"
+
+#include "modules/adminapi/cluster/status.h"
+#include "mysqlshdk/libs/utils/error.h"
+
+namespace mysqlsh {
+namespace dba {
+namespace cluster {
+
+namespace {
+
+std::vector<Member_connection> make_members(
+    std::size_t count, std::chrono::milliseconds delay,
+    std::atomic<int> *attempts) {
+  std::vector<Member_connection> members;
+
+  for (std::size_t i = 0; i < count; ++i) {
+    Member_connection member;
+    member.endpoint = "member" + std::to_string(i) + ":3306";
+    member.connect = [delay, attempts]() {
+      ++(*attempts);
+      std::this_thread::sleep_for(delay);
+      return std::make_shared<Instance>();
+    };
+
+    members.emplace_back(std::move(member));
+  }
+
+  return members;
+}
+
+std::size_t count_timeouts(const std::vector<Member_connection> &members) {
+  return std::count_if(
+      members.begin(), members.end(), [](const Member_connection &member) {
+        return member.error.find("timeout while waiting for the other "
+                                 "members to be probed") != std::string::npos;
+      });
+}
+
+}  // namespace
+
+TEST(Cluster_status_test, connect_in_parallel) {
+  std::atomic<int> active{0};
+  std::atomic<int> max_active{0};
+  std::vector<Member_connection> members;
+
+  for (int i = 0; i < 20; ++i) {
+    Member_connection member;
+    member.endpoint = "member" + std::to_string(i) + ":3306";
+    member.connect = [i, &active, &max_active]() -> std::shared_ptr<Instance> {
+      const int current = ++active;
+      int expected = max_active;
+
+      while (current > expected &&
+             !max_active.compare_exchange_weak(expected, current)) {
+      }
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      --active;
+
+      if (i % 2) throw shcore::Error("Can't connect to MySQL server", 2003);
+
+      return std::make_shared<Instance>();
+    };
+
+    members.emplace_back(std::move(member));
+  }
+
+  connect_in_parallel(&members, std::chrono::milliseconds(0));
+
+  // members are probed concurrently, but there are never more probes than
+  // the maximum size of a group
+  EXPECT_LT(1, max_active);
+  EXPECT_GE(9, max_active);
+
+  for (std::size_t i = 0; i < members.size(); ++i) {
+    SCOPED_TRACE(members[i].endpoint);
+
+    if (i % 2) {
+      EXPECT_EQ(nullptr, members[i].instance);
+      EXPECT_EQ("Error 2003: Can't connect to MySQL server", members[i].error);
+    } else {
+      EXPECT_NE(nullptr, members[i].instance);
+      EXPECT_EQ("", members[i].error);
+    }
+  }
+}
+
+TEST(Cluster_status_test, connect_in_parallel_deadline) {
+  std::atomic<int> attempts{0};
+  // 9 members are tried right away, next 9 after 500ms, the last 2 after 1s,
+  // when the deadline has already passed
+  auto members = make_members(20, std::chrono::milliseconds(500), &attempts);
+
+  connect_in_parallel(&members, std::chrono::milliseconds(800));
+
+  EXPECT_EQ(18, attempts);
+  EXPECT_EQ(2u, count_timeouts(members));
+
+  for (const auto &member : members) {
+    SCOPED_TRACE(member.endpoint);
+    EXPECT_TRUE(member.instance || !member.error.empty());
+  }
+}
+
+TEST(Cluster_status_test, connect_in_parallel_no_deadline) {
+  std::atomic<int> attempts{0};
+  auto members = make_members(20, std::chrono::milliseconds(100), &attempts);
+
+  // dba.connectTimeout set to 0 disables the timeout
+  connect_in_parallel(&members, std::chrono::milliseconds(0));
+
+  EXPECT_EQ(20, attempts);
+  EXPECT_EQ(0u, count_timeouts(members));
+
+  for (const auto &member : members) {
+    SCOPED_TRACE(member.endpoint);
+    EXPECT_NE(nullptr, member.instance);
+  }
+}
+
+}  // namespace cluster
+}  // namespace dba
+}  // namespace mysqlsh
@@ -22,8 +22,14 @@
  */
 
 #include <gtest/gtest_prod.h>
+#include <algorithm>
 #include <cstdlib>
+#include <string>
+#include <vector>
 #include "modules/util/dump/dump_utils.h"
+#include "modules/util/dump/dump_writer.h"
+#include "mysqlshdk/libs/db/row_batch.h"
+#include "mysqlshdk/libs/storage/backend/memory_file.h"
 #include "unittest/gtest_clean.h"
 
 #include "modules/util/load/dump_reader.h"
@@ -31,6 +37,216 @@
 namespace mysqlsh {
 namespace dump {
 
+namespace {
+
+class Counting_file : public mysqlshdk::storage::backend::Memory_file {
+ public:
+  Counting_file(std::size_t *writes, std::string *content, bool fail)
+      : Memory_file("file"), m_writes(writes), m_content(content),
+        m_fail(fail) {}
+
+  ssize_t write(const void *buffer, size_t length) override {
+    ++*m_writes;
+
+    if (m_fail) return -1;
+
+    m_content->append(static_cast<const char *>(buffer), length);
+    return Memory_file::write(buffer, length);
+  }
+
+ private:
+  std::size_t *m_writes;
+  std::string *m_content;
+  bool m_fail;
+};
+
+// writes the first field of each row followed by a new line
+class Test_dump_writer : public Dump_writer {
+ public:
+  using Dump_writer::Dump_writer;
+
+ private:
+  void store_preamble(const std::vector<mysqlshdk::db::Column> &,
+                      const std::vector<Encoding_type> &) override {}
+
+  void store_row(const mysqlshdk::db::IRow *) override {}
+
+  void store_rows(const mysqlshdk::db::Row_batch &batch,
+                  std::vector<std::size_t> *row_sizes) override {
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      const char *data;
+      std::size_t length;
+      batch.row(i).get_raw_data(0, &data, &length);
+
+      buffer()->will_write(length + 1);
+      buffer()->append(data, length);
+      buffer()->append('\n');
+
+      if (row_sizes) row_sizes->emplace_back(length + 1);
+    }
+  }
+
+  void store_postamble() override {
+    buffer()->will_write(3);
+    buffer()->append("END", 3);
+  }
+};
+
+class Dump_writer_test : public ::testing::Test {
+ protected:
+  Test_dump_writer *writer(std::size_t block_size, bool fail = false) {
+    m_writer = std::make_unique<Test_dump_writer>(
+        std::make_unique<Counting_file>(&m_writes, &m_content, fail));
+    m_writer->set_output_block_size(block_size);
+    m_writer->open();
+    return m_writer.get();
+  }
+
+  static void fill(mysqlshdk::db::Row_batch *batch, std::size_t rows,
+                   const std::string &value) {
+    batch->reset(1);
+
+    const char *data = value.c_str();
+    const std::size_t length = value.length();
+
+    for (std::size_t i = 0; i < rows; ++i) {
+      batch->append(&data, &length);
+    }
+  }
+
+  std::size_t m_writes = 0;
+  std::string m_content;
+  std::unique_ptr<Test_dump_writer> m_writer;
+};
+
+}  // namespace
+
+TEST_F(Dump_writer_test, output_block) {
+  const auto w = writer(64);
+  mysqlshdk::db::Row_batch batch;
+  fill(&batch, 3, "abcdefghi");  // 30 bytes per batch
+
+  std::vector<std::size_t> row_sizes;
+  auto result = w->write_rows(batch, &row_sizes);
+
+  // data is reported immediately, but it's not written to the file yet
+  EXPECT_EQ(30, result.data_bytes());
+  EXPECT_EQ(0, result.bytes_written());
+  EXPECT_EQ(std::vector<std::size_t>({10, 10, 10}), row_sizes);
+  EXPECT_EQ(0, m_writes);
+
+  result = w->write_rows(batch);
+  EXPECT_EQ(30, result.data_bytes());
+  EXPECT_EQ(0, m_writes);
+
+  // block would overflow, first two batches are written out
+  result = w->write_rows(batch);
+  EXPECT_EQ(30, result.data_bytes());
+  EXPECT_EQ(60, result.bytes_written());
+  EXPECT_EQ(1, m_writes);
+
+  // postamble flushes the block
+  result = w->write_postamble();
+  EXPECT_EQ(3, result.data_bytes());
+  EXPECT_EQ(33, result.bytes_written());
+  EXPECT_EQ(2, m_writes);
+
+  std::string expected;
+
+  for (int i = 0; i < 9; ++i) {
+    expected += "abcdefghi\n";
+  }
+
+  expected += "END";
+
+  EXPECT_EQ(expected, m_content);
+
+  // nothing to flush
+  EXPECT_EQ(0, w->flush().bytes_written());
+  EXPECT_EQ(2, m_writes);
+}
+
+TEST_F(Dump_writer_test, output_block_large_write) {
+  const auto w = writer(64);
+  mysqlshdk::db::Row_batch batch;
+
+  fill(&batch, 1, "abc");
+  w->write_rows(batch);
+  EXPECT_EQ(0, m_writes);
+
+  // data larger than the block flushes the block and is written directly
+  fill(&batch, 10, "abcdefghi");
+  const auto result = w->write_rows(batch);
+  EXPECT_EQ(100, result.data_bytes());
+  EXPECT_EQ(104, result.bytes_written());
+  EXPECT_EQ(2, m_writes);
+  EXPECT_EQ(104, m_content.length());
+  EXPECT_EQ("abc\nabcdefghi\n", m_content.substr(0, 14));
+}
+
+TEST_F(Dump_writer_test, output_block_disabled) {
+  const auto w = writer(0);
+  mysqlshdk::db::Row_batch batch;
+  fill(&batch, 1, "abc");
+
+  for (int i = 0; i < 3; ++i) {
+    const auto result = w->write_rows(batch);
+    EXPECT_EQ(4, result.data_bytes());
+    EXPECT_EQ(4, result.bytes_written());
+  }
+
+  EXPECT_EQ(3, m_writes);
+}
+
+TEST_F(Dump_writer_test, output_block_flush_on_destruction) {
+  {
+    const auto w = writer(64);
+    mysqlshdk::db::Row_batch batch;
+    fill(&batch, 2, "abc");
+    w->write_rows(batch);
+    EXPECT_EQ(0, m_writes);
+
+    m_writer.reset();
+  }
+
+  EXPECT_EQ(1, m_writes);
+  EXPECT_EQ("abc\nabc\n", m_content);
+}
+
+TEST_F(Dump_writer_test, output_block_change_size) {
+  const auto w = writer(64);
+  mysqlshdk::db::Row_batch batch;
+  fill(&batch, 1, "abc");
+
+  w->write_rows(batch);
+
+  // cannot change the size when block holds data
+  EXPECT_THROW(w->set_output_block_size(128), std::logic_error);
+  EXPECT_EQ(64, w->output_block_size());
+
+  w->flush();
+  EXPECT_NO_THROW(w->set_output_block_size(128));
+  EXPECT_EQ(128, w->output_block_size());
+}
+
+TEST_F(Dump_writer_test, output_block_write_failure) {
+  const auto w = writer(64, true);
+  mysqlshdk::db::Row_batch batch;
+  fill(&batch, 1, "abc");
+
+  // data is buffered, write error is reported when block is written out
+  EXPECT_NO_THROW(w->write_rows(batch));
+  EXPECT_EQ(0, m_writes);
+
+  EXPECT_THROW(w->write_postamble(), shcore::Exception);
+  EXPECT_EQ(1, m_writes);
+
+  // data which does not fit into the block is written immediately
+  fill(&batch, 10, "abcdefghi");
+  EXPECT_THROW(w->write_rows(batch), shcore::Exception);
+  EXPECT_EQ(2, m_writes);
+}
+
 TEST(Dump_utils, encode_schema_basename) {
   EXPECT_EQ(".sql", get_schema_filename(encode_schema_basename("")));
   EXPECT_EQ("sakila.sql",
@@ -113,6 +329,176 @@ TEST(Dump_utils, encode_table_data_filename_chunks) {
                                     "csv", 4, true));
 }
 
+namespace {
+
+std::string pad(uint64_t value) {
+  auto result = std::to_string(value);
+  return std::string(20 - result.length(), '0') + result;
+}
+
+void test_index_ranges(const std::vector<Index_key> &index,
+                       uint64_t keys_per_range) {
+  ASSERT_TRUE(std::is_sorted(index.begin(), index.end()));
+
+  std::size_t lookups = 0;
+  std::vector<std::pair<Index_key, Index_key>> ranges;
+  std::vector<bool> last_ranges;
+
+  const auto ranges_count = sample_index_ranges(
+      index.front(), index.back(), keys_per_range,
+      [&index, &lookups](const Index_key &from, uint64_t offset) {
+        ++lookups;
+
+        std::vector<Index_key> keys;
+        auto it = std::lower_bound(index.begin(), index.end(), from);
+
+        if (static_cast<uint64_t>(index.end() - it) > offset) {
+          it += offset;
+
+          for (int i = 0; i < 2 && it != index.end(); ++i, ++it) {
+            keys.emplace_back(*it);
+          }
+        }
+
+        return keys;
+      },
+      [&ranges, &last_ranges](const Index_key &begin, const Index_key &end,
+                              bool last_range) {
+        ranges.emplace_back(begin, end);
+        last_ranges.emplace_back(last_range);
+        return true;
+      });
+
+  const auto expected_ranges =
+      (index.size() + keys_per_range - 1) / keys_per_range;
+
+  ASSERT_EQ(expected_ranges, ranges_count);
+  ASSERT_EQ(expected_ranges, ranges.size());
+  // one lookup per range
+  EXPECT_EQ(expected_ranges, lookups);
+
+  auto next = index.begin();
+
+  for (std::size_t i = 0; i < ranges.size(); ++i) {
+    SCOPED_TRACE("range: " + std::to_string(i));
+
+    const auto begin =
+        std::lower_bound(index.begin(), index.end(), ranges[i].first);
+    const auto end =
+        std::upper_bound(index.begin(), index.end(), ranges[i].second);
+
+    // ranges are contiguous and cover the whole index
+    EXPECT_EQ(next, begin);
+    next = end;
+
+    if (i + 1 < ranges.size()) {
+      EXPECT_EQ(keys_per_range, static_cast<uint64_t>(end - begin));
+      EXPECT_FALSE(last_ranges[i]);
+    } else {
+      EXPECT_GE(keys_per_range, static_cast<uint64_t>(end - begin));
+      EXPECT_TRUE(last_ranges[i]);
+    }
+  }
+
+  EXPECT_EQ(index.end(), next);
+}
+
+}  // namespace
+
+TEST(Dump_utils, sample_index_ranges_composite_key) {
+  // few distinct values in the first column, the integer algorithm would
+  // produce a single chunk for each of them
+  std::vector<Index_key> index;
+
+  for (uint64_t a = 0; a < 3; ++a) {
+    for (uint64_t b = 0; b < 1000; ++b) {
+      index.emplace_back(Index_key{pad(a), pad(b * 7)});
+    }
+  }
+
+  {
+    SCOPED_TRACE("100");
+    test_index_ranges(index, 100);
+  }
+
+  {
+    SCOPED_TRACE("333");
+    test_index_ranges(index, 333);
+  }
+
+  {
+    SCOPED_TRACE("1");
+    test_index_ranges(index, 1);
+  }
+
+  {
+    SCOPED_TRACE("more than keys");
+    test_index_ranges(index, 5000);
+  }
+}
+
+TEST(Dump_utils, sample_index_ranges_skewed_key) {
+  // most of the keys are packed into a narrow range, the rest is spread far
+  // apart
+  std::vector<Index_key> index;
+
+  for (uint64_t i = 0; i < 9000; ++i) {
+    index.emplace_back(Index_key{pad(i)});
+  }
+
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    index.emplace_back(Index_key{pad(i * i * 1000000)});
+  }
+
+  {
+    SCOPED_TRACE("250");
+    test_index_ranges(index, 250);
+  }
+
+  {
+    SCOPED_TRACE("999");
+    test_index_ranges(index, 999);
+  }
+}
+
+TEST(Dump_utils, sample_index_ranges_stop) {
+  std::vector<Index_key> ranges;
+
+  EXPECT_EQ(2, sample_index_ranges(
+                   {"1"}, {"9"}, 2,
+                   [](const Index_key &from, uint64_t) {
+                     const auto next = std::to_string(std::stoi(from[0]) + 1);
+                     return std::vector<Index_key>{{next}, {next + "0"}};
+                   },
+                   [&ranges](const Index_key &begin, const Index_key &,
+                             bool) {
+                     ranges.emplace_back(begin);
+                     return ranges.size() < 2;
+                   }));
+  EXPECT_EQ(2, ranges.size());
+}
+
+TEST(Dump_utils, sample_index_ranges_removed_rows) {
+  // rows were removed after the boundaries were fetched, the last range ends
+  // with the last known key
+  std::vector<std::pair<Index_key, Index_key>> ranges;
+
+  EXPECT_EQ(1, sample_index_ranges(
+                   {"1"}, {"9"}, 100,
+                   [](const Index_key &, uint64_t) {
+                     return std::vector<Index_key>{};
+                   },
+                   [&ranges](const Index_key &begin, const Index_key &end,
+                             bool last_range) {
+                     EXPECT_TRUE(last_range);
+                     ranges.emplace_back(begin, end);
+                     return true;
+                   }));
+  ASSERT_EQ(1, ranges.size());
+  EXPECT_EQ(Index_key{"1"}, ranges[0].first);
+  EXPECT_EQ(Index_key{"9"}, ranges[0].second);
+}
+
 }  // namespace dump
 
 class Dump_scheduler : public ::testing::Test {
@@ -151,14 +537,12 @@ class Dump_scheduler : public ::testing::Test {
     return info;
   }
 
-  template <typename SchedF>
   std::vector<std::string> test_scheduling(
-      SchedF f, const std::vector<Dump_reader::Table_info> &tables,
-      size_t nthreads) {
+      const std::vector<Dump_reader::Table_info> &tables, size_t nthreads) {
     std::vector<std::string> schedule_order;
 
     std::unordered_multimap<std::string, size_t> tables_being_loaded;
-    std::unordered_set<Dump_reader::Table_data_info *> tables_with_data;
+    Dump_reader::Tables_with_data tables_with_data;
 
     auto copy = tables;
     for (auto &t : copy) {
@@ -170,28 +554,28 @@ class Dump_scheduler : public ::testing::Test {
 
     auto schedule_one = [&](std::string *out_table, std::string *out_file,
                             size_t *out_size) {
-      auto iter = f(tables_being_loaded, &tables_with_data, nthreads);
+      auto table = tables_with_data.schedule_chunk_proportionally(
+          tables_being_loaded, nthreads);
 
-      if (iter != tables_with_data.end()) {
+      if (table) {
         *out_table = schema_table_object_key(
-            (*iter)->owner->schema, (*iter)->owner->table, (*iter)->partition);
+            table->owner->schema, table->owner->table, table->partition);
 
         size_t chunk_index;
 
-        if ((*iter)->chunked) {
-          chunk_index = (*iter)->chunks_consumed;
-          (*iter)->chunks_consumed++;
+        if (table->chunked) {
+          chunk_index = table->chunks_consumed;
 
-          *out_file = (*iter)->available_chunks[chunk_index]->name();
-          *out_size = (*iter)->available_chunks[chunk_index]->size();
+          *out_file = table->available_chunks[chunk_index]->name();
+          *out_size = table->available_chunks[chunk_index]->size();
         } else {
           chunk_index = 0;
-          (*iter)->chunks_consumed++;
 
-          *out_size = (*iter)->available_chunks[0]->size();
-          *out_file = (*iter)->available_chunks[0]->name();
+          *out_size = table->available_chunks[0]->size();
+          *out_file = table->available_chunks[0]->name();
         }
-        if (!(*iter)->has_data_available()) tables_with_data.erase(iter);
+
+        tables_with_data.consume(table);
         return true;
       }
       return false;
@@ -215,10 +599,10 @@ class Dump_scheduler : public ::testing::Test {
       }
 
       std::cout << "\nTables with data:\n";
-      for (auto t : tables_with_data) {
+      tables_with_data.for_each([](Dump_reader::Table_data_info *t) {
         std::cout << t->owner->schema << "." << t->owner->table << "\t"
                   << t->bytes_available() << "\n";
-      }
+      });
       std::cout << "\n";
     };
 
@@ -227,7 +611,10 @@ class Dump_scheduler : public ::testing::Test {
       std::string file;
       size_t count;
 
-      auto old_tables_with_data = tables_with_data;
+      std::vector<Dump_reader::Table_data_info *> old_tables_with_data;
+      tables_with_data.for_each([&old_tables_with_data](auto t) {
+        old_tables_with_data.emplace_back(t);
+      });
 
       int n_busy_threads = 0;
       // schedule work until all threads busy
@@ -325,13 +712,13 @@ TEST_F(Dump_scheduler, load_scheduler) {
   // just 1 thread
   {
     SCOPED_TRACE("1-1");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 1);
+    test_scheduling(tables, 1);
   }
 
   // fewer threads than tables
   {
     SCOPED_TRACE("1-3");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 3);
+    test_scheduling(tables, 3);
   }
 
   // 2 tables
@@ -340,13 +727,13 @@ TEST_F(Dump_scheduler, load_scheduler) {
   // just 1 thread
   {
     SCOPED_TRACE("2-1");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 1);
+    test_scheduling(tables, 1);
   }
 
   // fewer threads than tables
   {
     SCOPED_TRACE("2-4");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 4);
+    test_scheduling(tables, 4);
   }
 
   // 5 tables
@@ -357,25 +744,25 @@ TEST_F(Dump_scheduler, load_scheduler) {
   // just 1 thread
   {
     SCOPED_TRACE("1");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 1);
+    test_scheduling(tables, 1);
   }
 
   // fewer threads than tables
   {
     SCOPED_TRACE("3");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 3);
+    test_scheduling(tables, 3);
   }
 
   // same as tables
   {
     SCOPED_TRACE("5");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 5);
+    test_scheduling(tables, 5);
   }
 
   // more than tables
   {
     SCOPED_TRACE("16");
-    test_scheduling(Dump_reader::schedule_chunk_proportionally, tables, 16);
+    test_scheduling(tables, 16);
   }
 }
 }  // namespace mysqlsh
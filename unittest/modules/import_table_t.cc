@@ -29,6 +29,7 @@
 
 #include "modules/util/import_table/chunk_file.h"
 #include "modules/util/import_table/import_table.h"
+#include "mysqlshdk/libs/storage/backend/memory_file.h"
 #include "mysqlshdk/libs/utils/synchronized_queue.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 
@@ -1042,5 +1043,229 @@ TEST(import_table, twochar_aa_line_terminator_same_as_row_data) {
   shcore::delete_file(path, true);
 }
 
+TEST(import_table, find_needle_file_iterator) {
+  // vectorized find() specialized for File_iterator must give the same results
+  // as the generic version
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int> dist(0, 7);
+  const std::string alphabet{"ab\\\r\nxyz"};
+
+  std::string test_string;
+  for (int i = 0; i < kBufferSize * 3 + 17; i++) {
+    test_string += alphabet[dist(gen)];
+  }
+
+  const std::string path{"import_table_find_needle.dump"};
+  shcore::create_file(path, test_string, true);
+
+  for (const std::string needle : {"\n", "\r\n", "ab", "xyz", "zz\\"}) {
+    SCOPED_TRACE(needle);
+
+    auto fh_ptr = mysqlshdk::storage::make_file(path);
+    File_handler fh{fh_ptr.get()};
+    auto first = fh.begin(needle.size());
+    const auto last = fh.end(needle.size());
+
+    auto expected_fh_ptr = mysqlshdk::storage::make_file(path);
+    File_handler expected_fh{expected_fh_ptr.get()};
+    auto expected = expected_fh.begin(needle.size());
+    const auto expected_last = expected_fh.end(needle.size());
+
+    while (first != last) {
+      Find_context<uint8_t> context{};
+      Find_context<uint8_t> expected_context{};
+
+      first = find(first, last, needle.begin(), needle.end(), &context);
+      expected = find<File_iterator, std::string::const_iterator>(
+          expected, expected_last, needle.begin(), needle.end(),
+          &expected_context);
+
+      ASSERT_EQ(expected.offset(), first.offset());
+      ASSERT_EQ(expected_context.needle_found, context.needle_found);
+
+      if (context.needle_found) {
+        EXPECT_EQ(expected_context.preceding_element_set,
+                  context.preceding_element_set);
+        EXPECT_EQ(expected_context.preceding_element,
+                  context.preceding_element);
+        EXPECT_EQ(expected_context.last_element, context.last_element);
+      }
+    }
+  }
+
+  shcore::delete_file(path, true);
+}
+
+TEST(import_table, chunk_compressed_file) {
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> length(0, 300);
+  std::uniform_int_distribution<int> dist(0, 5);
+  const std::string alphabet{"ab\\\nxy"};
+
+  std::string rows;
+  for (int i = 0; i < 20000; i++) {
+    for (int j = length(gen); j > 0; j--) {
+      rows += alphabet[dist(gen)];
+    }
+    rows += '\n';
+  }
+
+  for (const uint64_t skip_rows : {0, 1, 7}) {
+    SCOPED_TRACE(skip_rows);
+
+    mysqlshdk::storage::backend::Memory_file file("data.tsv.zst");
+    file.set_content(rows);
+
+    shcore::Synchronized_queue<File_import_info> queue;
+    const size_t chunk_size = 2 * kBufferSize;
+
+    Chunk_compressed_file chunk;
+    chunk.set_chunk_size(chunk_size);
+    chunk.set_file_handle(&file);
+    chunk.set_dialect(Dialect::default_());
+    chunk.set_rows_to_skip(skip_rows);
+    chunk.set_output_queue(&queue);
+    chunk.set_max_pending_chunks(1000);
+    chunk.start();
+
+    ASSERT_LT(1, queue.size());
+
+    std::string loaded;
+    while (queue.size() > 0) {
+      auto info = queue.pop();
+      std::unique_ptr<mysqlshdk::storage::IFile> fh{info.file_handler};
+      ASSERT_NE(nullptr, fh);
+      EXPECT_FALSE(info.range_read);
+
+      const auto data = mysqlshdk::storage::read_file(fh.get());
+      EXPECT_EQ(*info.file_size, data.size());
+
+      // each chunk ends at an unescaped row terminator, only the last one can
+      // be smaller than the chunk size
+      ASSERT_FALSE(data.empty());
+      EXPECT_EQ('\n', data.back());
+      if (data.size() > 1) {
+        EXPECT_NE('\\', data[data.size() - 2]);
+      }
+      if (queue.size() > 0) {
+        EXPECT_LE(chunk_size, data.size());
+      }
+
+      loaded += data;
+    }
+
+    // skipped rows are the unescaped terminators at the beginning of the data
+    size_t offset = 0;
+    for (uint64_t i = 0; i < skip_rows; i++) {
+      do {
+        offset = rows.find('\n', offset) + 1;
+      } while (offset > 1 && rows[offset - 2] == '\\');
+    }
+
+    EXPECT_EQ(rows.substr(offset), loaded);
+  }
+}
+
+TEST(import_table, release_queued_files) {
+  shcore::Synchronized_queue<File_import_info> queue;
+  int released = 0;
+
+  for (int i = 0; i < 3; ++i) {
+    mysqlshdk::storage::backend::Memory_file source("data.tsv.zst");
+
+    File_import_info info;
+    info.file_handler =
+        new Decompressed_chunk(source, "data\n", [&released]() { ++released; });
+    info.is_guard = false;
+    queue.push(std::move(info));
+  }
+
+  queue.shutdown(2);
+
+  // workers have stopped without loading the chunks
+  release_queued_files(&queue);
+
+  EXPECT_EQ(3, released);
+  EXPECT_EQ(0, queue.size());
+}
+
+TEST(import_table, chunk_compressed_file_bounded_memory) {
+  std::string rows;
+  for (int i = 0; i < 10000; i++) {
+    rows += std::string(100, 'a') + "\n";
+  }
+
+  mysqlshdk::storage::backend::Memory_file file("data.tsv.gz");
+  file.set_content(rows);
+
+  shcore::Synchronized_queue<File_import_info> queue;
+  Chunk_compressed_file chunk;
+  chunk.set_chunk_size(0);
+  chunk.set_file_handle(&file);
+  chunk.set_dialect(Dialect::default_());
+  chunk.set_output_queue(&queue);
+  chunk.set_max_pending_chunks(2);
+
+  // nobody consumes the chunks, chunking stops once the limit is reached
+  int checks = 0;
+  chunk.set_stop_condition([&checks]() { return ++checks > 1; });
+  chunk.start();
+
+  EXPECT_EQ(2, queue.size());
+
+  while (queue.size() > 0) {
+    delete queue.pop().file_handler;
+  }
+}
+
+TEST(import_table, chunk_compressed_file_bounded_bytes) {
+  std::string rows;
+  for (int i = 0; i < 10000; i++) {
+    rows += std::string(100, 'a') + "\n";
+  }
+
+  const size_t chunk_size = 2 * kBufferSize;
+
+  for (const size_t max_bytes : {size_t{1}, 5 * chunk_size}) {
+    SCOPED_TRACE(max_bytes);
+
+    mysqlshdk::storage::backend::Memory_file file("data.tsv.gz");
+    file.set_content(rows);
+
+    shcore::Synchronized_queue<File_import_info> queue;
+    Chunk_compressed_file chunk;
+    chunk.set_chunk_size(chunk_size);
+    chunk.set_file_handle(&file);
+    chunk.set_dialect(Dialect::default_());
+    chunk.set_output_queue(&queue);
+    chunk.set_max_pending_chunks(1000);
+    chunk.set_max_pending_bytes(max_bytes);
+
+    // nobody consumes the chunks, chunking stops once the limit is reached
+    int checks = 0;
+    chunk.set_stop_condition([&checks]() { return ++checks > 1; });
+    chunk.start();
+
+    size_t count = 0;
+    size_t bytes = 0;
+
+    while (queue.size() > 0) {
+      auto info = queue.pop();
+      ++count;
+      bytes += *info.file_size;
+      delete info.file_handler;
+    }
+
+    if (1 == max_bytes) {
+      // a single chunk is allowed even if it exceeds the limit
+      EXPECT_EQ(1, count);
+    } else {
+      EXPECT_LT(1, count);
+      EXPECT_GE(max_bytes, bytes);
+      EXPECT_LT(max_bytes, bytes + chunk_size + 101);
+    }
+  }
+}
+
 }  // namespace import_table
 }  // namespace mysqlsh
@@ -23,6 +23,7 @@
 
 #include "modules/util/dump/instance_cache.h"
 
+#include <algorithm>
 #include <set>
 #include <string>
 
@@ -1683,6 +1684,99 @@ TEST_F(Instance_cache_test, table_histograms) {
   }
 }
 
+TEST_F(Instance_cache_test, parallel_metadata) {
+  {
+    // setup
+    m_session->execute("CREATE SCHEMA first;");
+    m_session->execute(
+        "CREATE TABLE first.one (id INT PRIMARY KEY, data TEXT) "
+        "PARTITION BY KEY (id) PARTITIONS 3;");
+    m_session->execute("CREATE TABLE first.two (id INT, data INT UNIQUE);");
+    m_session->execute("CREATE VIEW first.three AS SELECT * FROM first.one;");
+    m_session->execute("CREATE SCHEMA second;");
+    m_session->execute(
+        "CREATE TABLE second.four (a INT, b INT, PRIMARY KEY (b, a));");
+    m_session->execute("CREATE SCHEMA third;");
+    m_session->execute(
+        "CREATE TABLE third.five (id INT, c INT AS (id + 1));");
+  }
+
+  const auto sequential =
+      Instance_cache_builder(m_session, {}, {}, {}, {}).build();
+
+  std::size_t sessions = 0;
+  std::vector<std::shared_ptr<mysqlshdk::db::ISession>> opened;
+  const auto factory = [&sessions, &opened]() {
+    ++sessions;
+    opened.emplace_back(connect_session());
+    return opened.back();
+  };
+
+  const auto parallel = Instance_cache_builder(m_session, {}, {}, {}, {}, {},
+                                               true, 4, factory)
+                            .build();
+
+  // the main session is used by one of the threads
+  EXPECT_EQ(std::min<std::size_t>(4, parallel.schemas.size()) - 1, sessions);
+
+  for (const auto &s : opened) {
+    EXPECT_FALSE(s->is_open());
+  }
+
+  ASSERT_EQ(sequential.schemas.size(), parallel.schemas.size());
+
+  for (const auto &schema : sequential.schemas) {
+    SCOPED_TRACE("testing schema " + schema.first);
+
+    const auto &actual = parallel.schemas.at(schema.first);
+
+    ASSERT_EQ(schema.second.tables.size(), actual.tables.size());
+
+    for (const auto &table : schema.second.tables) {
+      SCOPED_TRACE("testing table " + table.first);
+
+      const auto &expected = table.second;
+      const auto &t = actual.tables.at(table.first);
+
+      ASSERT_EQ(expected.all_columns.size(), t.all_columns.size());
+
+      for (std::size_t i = 0; i < expected.all_columns.size(); ++i) {
+        EXPECT_EQ(expected.all_columns[i].name, t.all_columns[i].name);
+        EXPECT_EQ(expected.all_columns[i].generated,
+                  t.all_columns[i].generated);
+      }
+
+      EXPECT_EQ(expected.columns.size(), t.columns.size());
+      EXPECT_EQ(expected.index.primary(), t.index.primary());
+      EXPECT_EQ(expected.index.columns_sql(), t.index.columns_sql());
+
+      for (const auto column : t.index.columns()) {
+        // index has to refer to the columns of its own table
+        EXPECT_LE(t.all_columns.data(), column);
+        EXPECT_GT(t.all_columns.data() + t.all_columns.size(), column);
+      }
+
+      ASSERT_EQ(expected.partitions.size(), t.partitions.size());
+
+      for (std::size_t i = 0; i < expected.partitions.size(); ++i) {
+        EXPECT_EQ(expected.partitions[i].name, t.partitions[i].name);
+      }
+    }
+
+    ASSERT_EQ(schema.second.views.size(), actual.views.size());
+
+    for (const auto &view : schema.second.views) {
+      SCOPED_TRACE("testing view " + view.first);
+
+      const auto &v = actual.views.at(view.first);
+
+      EXPECT_EQ(view.second.all_columns, v.all_columns);
+      EXPECT_EQ(view.second.character_set_client, v.character_set_client);
+      EXPECT_EQ(view.second.collation_connection, v.collation_connection);
+    }
+  }
+}
+
 #if defined(_WIN32) || defined(__APPLE__)
 TEST_F(Instance_cache_test, filter_schemas_and_tables_case_sensitive) {
   {
@@ -218,6 +218,125 @@ TEST(Load_dump, add_execute_conditionally) {
       "", "", false);
 }
 
+TEST(Load_dump, index_build_threads) {
+  constexpr uint64_t k_mib = 1024 * 1024;
+
+  {
+    // server does not support setting the DDL threads per session
+    Index_build_budget budget{8, 4, 0, 0};
+    EXPECT_FALSE(budget.tunable());
+    // size not known
+    EXPECT_EQ(4, budget.threads(0));
+    // small table uses a single thread
+    EXPECT_EQ(1, budget.threads(40 * k_mib));
+    EXPECT_EQ(4, budget.threads(41 * k_mib));
+    EXPECT_EQ(4, budget.threads(1024 * k_mib));
+  }
+
+  {
+    // innodb_ddl_threads=4, innodb_ddl_buffer_size=1M
+    Index_build_budget budget{16, 4, 4, k_mib};
+    EXPECT_TRUE(budget.tunable());
+    EXPECT_EQ(4, budget.threads(0));
+    EXPECT_EQ(1, budget.threads(5 * k_mib));
+    EXPECT_EQ(2, budget.threads(25 * k_mib));
+    // capped by innodb_ddl_threads
+    EXPECT_EQ(4, budget.threads(1024 * k_mib));
+  }
+
+  {
+    // innodb_parallel_read_threads=16, innodb_ddl_threads=8
+    Index_build_budget budget{32, 16, 8, k_mib};
+    EXPECT_EQ(16, budget.threads(0));
+    EXPECT_EQ(8, budget.threads(1024 * k_mib));
+  }
+
+  {
+    // capped by the number of loader threads
+    Index_build_budget budget{2, 4, 4, k_mib};
+    EXPECT_EQ(2, budget.threads(0));
+    EXPECT_EQ(2, budget.threads(1024 * k_mib));
+  }
+}
+
+TEST(Load_dump, index_build_memory) {
+  constexpr uint64_t k_kib = 1024;
+  constexpr uint64_t k_mib = 1024 * k_kib;
+
+  {
+    // innodb_ddl_buffer_size=1M, 8 loader threads
+    Index_build_budget budget{8, 4, 4, k_mib};
+    EXPECT_EQ(8 * k_mib, budget.memory_budget());
+
+    // each thread gets the default size
+    EXPECT_EQ(k_mib, budget.acquire_buffer(1));
+    EXPECT_EQ(4 * k_mib, budget.acquire_buffer(4));
+    EXPECT_EQ(2 * k_mib, budget.acquire_buffer(2));
+    EXPECT_EQ(7 * k_mib, budget.memory_used());
+
+    budget.release_buffer(2 * k_mib);
+    budget.release_buffer(4 * k_mib);
+    budget.release_buffer(k_mib);
+    EXPECT_EQ(0, budget.memory_used());
+  }
+
+  {
+    // server's minimum is used
+    Index_build_budget budget{2, 4, 4, 32 * k_kib};
+    EXPECT_EQ(64 * k_kib, budget.acquire_buffer(1));
+    budget.release_buffer(64 * k_kib);
+  }
+
+  {
+    // a single build can exceed the budget
+    Index_build_budget budget{2, 4, 4, k_mib};
+    EXPECT_EQ(2 * k_mib, budget.memory_budget());
+    EXPECT_EQ(4 * k_mib, budget.acquire_buffer(4));
+    budget.release_buffer(4 * k_mib);
+  }
+}
+
+TEST(Load_dump, index_build_memory_wait) {
+  constexpr uint64_t k_mib = 1024 * 1024;
+
+  // innodb_ddl_buffer_size=1M, 4 loader threads
+  Index_build_budget budget{4, 4, 4, k_mib};
+  ASSERT_EQ(4 * k_mib, budget.memory_budget());
+
+  EXPECT_EQ(2 * k_mib, budget.acquire_buffer(2));
+  EXPECT_EQ(k_mib, budget.acquire_buffer(1));
+
+  // concurrent builds would exceed the budget, these have to wait
+  std::atomic<int> acquired{0};
+  std::vector<std::thread> builds;
+
+  for (int i = 0; i < 2; ++i) {
+    builds.emplace_back([&budget, &acquired]() {
+      budget.acquire_buffer(2);
+      ++acquired;
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(0, acquired);
+  EXPECT_EQ(3 * k_mib, budget.memory_used());
+
+  // only one of the waiting builds fits
+  budget.release_buffer(k_mib);
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(1, acquired);
+  EXPECT_EQ(4 * k_mib, budget.memory_used());
+
+  budget.release_buffer(2 * k_mib);
+
+  for (auto &build : builds) {
+    build.join();
+  }
+
+  EXPECT_EQ(2, acquired);
+  EXPECT_EQ(4 * k_mib, budget.memory_used());
+}
+
 static std::string table_name_for_chunk_file(const std::string &f) {
   return shcore::str_rstrip(f.substr(0, f.rfind('@')), "@");
 }
@@ -534,9 +653,10 @@ class Load_dump_mocked : public Shell_core_test_wrapper {
       mock_main_session
           ->expect_query(
               "SELECT GREATEST(@@innodb_parallel_read_threads, "
-              "@@innodb_ddl_threads)")
-          .then({"a"})
-          .add_row({"4"});
+              "@@innodb_ddl_threads), @@innodb_ddl_threads, "
+              "@@innodb_ddl_buffer_size")
+          .then({"a", "b", "c"})
+          .add_row({"4", "4", "1048576"});
     }
 
     mock_main_session
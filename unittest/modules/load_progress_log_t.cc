@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <memory>
+#include <string>
+
+#include "unittest/gprod_clean.h"
+#include "unittest/gtest_clean.h"
+
+#include "modules/util/load/load_progress_log.h"
+#include "mysqlshdk/libs/storage/ifile.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+
+namespace mysqlsh {
+namespace {
+
+class Load_progress_log_test : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_path = shcore::path::join_path(getenv("TMPDIR"), "load-progress.json");
+    remove_files();
+  }
+
+  void TearDown() override { remove_files(); }
+
+  std::unique_ptr<mysqlshdk::storage::IFile> file() const {
+    return mysqlshdk::storage::make_file(m_path);
+  }
+
+  std::string segment(uint64_t n) const {
+    return m_path + "." + std::to_string(n);
+  }
+
+  void remove_files() const {
+    shcore::delete_file(m_path);
+
+    for (uint64_t n = 1; n <= 1000; ++n) {
+      shcore::delete_file(segment(n));
+    }
+  }
+
+  // entries of the format used before segments were introduced
+  static std::string old_format_chunks(int first, int last, bool done) {
+    std::string data;
+
+    for (int i = first; i < last; ++i) {
+      const auto prefix = R"({"op":"TABLE-DATA","done":)" +
+                          std::string(done ? "true" : "false") +
+                          R"(,"timestamp":1650000000000,"schema":"schema",)"
+                          R"("table":"table","chunk":)" +
+                          std::to_string(i);
+
+      data += prefix + "}\n";
+
+      if (done) {
+        data += prefix + R"(,"bytes":100,"raw_bytes":200,"rows":10})" + "\n";
+      }
+    }
+
+    return data;
+  }
+
+  std::string read_main_file() const {
+    std::string data;
+    EXPECT_TRUE(shcore::load_text_file(m_path, data));
+    return data;
+  }
+
+  uint64_t count_segments() const {
+    uint64_t segments = 0;
+
+    for (uint64_t n = 1; n <= 1000; ++n) {
+      if (shcore::is_file(segment(n))) ++segments;
+    }
+
+    return segments;
+  }
+
+  // parses the file the same way as versions which use format 1
+  static void parse_format_1(const std::string &data) {
+    for (const auto &line : shcore::str_split(data, "\n")) {
+      if (shcore::str_strip(line).empty()) continue;
+
+      const auto entry = shcore::Value::parse(line).as_map();
+      entry->get_string("op");
+      entry->get_int("done");
+    }
+  }
+
+  static void load_chunks(Load_progress_log *log, int first, int last) {
+    for (int i = first; i < last; ++i) {
+      log->start_table_chunk("schema", "table", "", i);
+      log->end_table_chunk("schema", "table", "", i, 100, 200, 10);
+    }
+  }
+
+  std::string m_path;
+};
+
+TEST_F(Load_progress_log_test, segments_are_replayed) {
+  {
+    Load_progress_log log{512};
+    EXPECT_EQ(Load_progress_log::PENDING, log.init(file(), false, true).status);
+    const auto main_size = shcore::file_size(m_path);
+
+    load_chunks(&log, 0, 50);
+
+    // new entries are not written to the main file
+    EXPECT_EQ(main_size, shcore::file_size(m_path));
+    EXPECT_TRUE(shcore::is_file(segment(1)));
+    EXPECT_TRUE(shcore::is_file(segment(2)));
+    // load is interrupted, cleanup() is not called
+  }
+
+  Load_progress_log log{512};
+  const auto progress = log.init(file(), false, true);
+
+  EXPECT_EQ(Load_progress_log::INTERRUPTED, progress.status);
+  EXPECT_EQ(50 * 100u, progress.bytes_completed);
+  EXPECT_EQ(50 * 200u, progress.raw_bytes_completed);
+
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_EQ(Load_progress_log::DONE,
+              log.table_chunk_status("schema", "table", "", i));
+  }
+
+  EXPECT_EQ(Load_progress_log::PENDING,
+            log.table_chunk_status("schema", "table", "", 50));
+
+  // replayed segments were compacted into the main file
+  EXPECT_FALSE(shcore::is_file(segment(1)));
+  EXPECT_FALSE(shcore::is_file(segment(2)));
+}
+
+TEST_F(Load_progress_log_test, segments_are_compacted) {
+  {
+    Load_progress_log log{256};
+    log.init(file(), false, true);
+
+    const auto main_file = read_main_file();
+
+    load_chunks(&log, 0, 100);
+
+    // main file is not rewritten while the load is in progress
+    EXPECT_EQ(main_file, read_main_file());
+    EXPECT_LT(4u, count_segments());
+  }
+
+  {
+    Load_progress_log log{256};
+    EXPECT_EQ(100 * 100u, log.init(file(), false, true).bytes_completed);
+
+    // segments are compacted into the main file when load is resumed
+    EXPECT_EQ(0u, count_segments());
+
+    const auto main_file = read_main_file();
+
+    load_chunks(&log, 100, 120);
+
+    EXPECT_EQ(main_file, read_main_file());
+    EXPECT_LT(0u, count_segments());
+
+    log.cleanup();
+
+    // everything is in the main file
+    EXPECT_EQ(0u, count_segments());
+  }
+
+  Load_progress_log log{256};
+  EXPECT_EQ(120 * 100u, log.init(file(), true, true).bytes_completed);
+  EXPECT_EQ(Load_progress_log::DONE,
+            log.table_chunk_status("schema", "table", "", 119));
+}
+
+TEST_F(Load_progress_log_test, reset_progress) {
+  {
+    Load_progress_log log{256};
+    log.init(file(), false, true);
+    load_chunks(&log, 0, 20);
+  }
+
+  {
+    Load_progress_log log{256};
+    EXPECT_EQ(Load_progress_log::INTERRUPTED,
+              log.init(file(), false, true).status);
+    log.reset_progress();
+    load_chunks(&log, 0, 5);
+  }
+
+  Load_progress_log log{256};
+  const auto progress = log.init(file(), false, true);
+  EXPECT_EQ(5 * 100u, progress.bytes_completed);
+  EXPECT_EQ(Load_progress_log::PENDING,
+            log.table_chunk_status("schema", "table", "", 5));
+}
+
+TEST_F(Load_progress_log_test, resume_from_old_format) {
+  // load interrupted with chunk 20 in progress, using local and remote storage
+  for (const auto rewrite_on_flush : {false, true}) {
+    SCOPED_TRACE(rewrite_on_flush ? "remote" : "local");
+
+    remove_files();
+    ASSERT_TRUE(shcore::create_file(
+        m_path,
+        old_format_chunks(0, 20, true) + old_format_chunks(20, 21, false)));
+
+    {
+      Load_progress_log log{256};
+      const auto progress = log.init(file(), false, rewrite_on_flush);
+
+      EXPECT_EQ(Load_progress_log::INTERRUPTED, progress.status);
+      EXPECT_EQ(20 * 100u, progress.bytes_completed);
+      EXPECT_EQ(20 * 200u, progress.raw_bytes_completed);
+      EXPECT_EQ(Load_progress_log::DONE,
+                log.table_chunk_status("schema", "table", "", 19));
+      EXPECT_EQ(Load_progress_log::INTERRUPTED,
+                log.table_chunk_status("schema", "table", "", 20));
+      EXPECT_EQ(Load_progress_log::PENDING,
+                log.table_chunk_status("schema", "table", "", 21));
+
+      load_chunks(&log, 20, 40);
+      // load is interrupted again
+    }
+
+    Load_progress_log log{256};
+    const auto progress = log.init(file(), false, rewrite_on_flush);
+
+    EXPECT_EQ(Load_progress_log::INTERRUPTED, progress.status);
+    EXPECT_EQ(40 * 100u, progress.bytes_completed);
+    EXPECT_EQ(Load_progress_log::DONE,
+              log.table_chunk_status("schema", "table", "", 39));
+    EXPECT_EQ(Load_progress_log::PENDING,
+              log.table_chunk_status("schema", "table", "", 40));
+  }
+}
+
+TEST_F(Load_progress_log_test, newer_format_version) {
+  ASSERT_TRUE(shcore::create_file(
+      m_path, old_format_chunks(0, 5, true) +
+                  R"({"op":"SEGMENTS","done":"segments","version":1000,)"
+      R"("next":1,"active":true})"
+                  "\n"));
+
+  Load_progress_log log;
+
+  try {
+    log.init(file(), false, true);
+    ADD_FAILURE() << "Expected an exception";
+  } catch (const std::exception &e) {
+    EXPECT_NE(std::string::npos, std::string(e.what()).find(
+                                     "unsupported format version 1000"));
+  }
+}
+
+TEST_F(Load_progress_log_test, format_1_rejects_segments) {
+  {
+    Load_progress_log log{256};
+    log.init(file(), false, true);
+    load_chunks(&log, 0, 20);
+  }
+
+  {
+    // segments are compacted into the main file
+    Load_progress_log log{256};
+    log.init(file(), false, true);
+    load_chunks(&log, 20, 40);
+  }
+
+  // entries written before the marker are still readable, but versions
+  // which do not support segments must not resume from such file
+  const auto data = read_main_file();
+  const auto marker = data.find(R"({"op":"SEGMENTS")");
+  ASSERT_NE(std::string::npos, marker);
+  EXPECT_NE(std::string::npos, data.find(R"("chunk":19)"));
+  EXPECT_NO_THROW(parse_format_1(data.substr(0, marker)));
+  EXPECT_ANY_THROW(parse_format_1(data));
+
+  // file written by a local load does not use segments and remains readable
+  remove_files();
+
+  {
+    Load_progress_log log;
+    log.init(file(), false, false);
+    load_chunks(&log, 0, 20);
+  }
+
+  EXPECT_NO_THROW(parse_format_1(read_main_file()));
+}
+
+}  // namespace
+}  // namespace mysqlsh
@@ -49,6 +49,26 @@ using ::testing::AnyOf;
 using ::testing::HasSubstr;
 using ::testing::Not;
 
+namespace {
+
+class Recording_session : public mysqlshdk::db::mysql::Session {
+ public:
+  std::shared_ptr<mysqlshdk::db::IResult> querys(
+      const char *sql, size_t len, bool buffered = false) override {
+    statements.emplace_back(sql, len);
+    return Session::querys(sql, len, buffered);
+  }
+
+  void executes(const char *sql, size_t len) override {
+    statements.emplace_back(sql, len);
+    Session::executes(sql, len);
+  }
+
+  std::vector<std::string> statements;
+};
+
+}  // namespace
+
 class Schema_dumper_test : public Shell_core_test_wrapper {
  public:
   static void TearDownTestCase() {
@@ -187,6 +207,93 @@ CREATE TABLE IF NOT EXISTS `at1` (
   wipe_all();
 }
 
+TEST_F(Schema_dumper_test, reuse_dumper) {
+  const auto recording = std::make_shared<Recording_session>();
+  recording->connect(shcore::get_connection_options(_mysql_uri));
+  session->close();
+  session = recording;
+
+  Schema_dumper sd(session);
+  sd.opt_drop_table = true;
+
+  const auto count = [&recording](const std::string &prefix) {
+    return std::count_if(recording->statements.begin(),
+                         recording->statements.end(),
+                         [&prefix](const std::string &s) {
+                           return shcore::str_ibeginswith(s, prefix);
+                         });
+  };
+  const auto character_set_results = [&recording]() {
+    std::vector<std::string> values;
+
+    for (const auto &s : recording->statements) {
+      if (shcore::str_ibeginswith(s, "SET SESSION character_set_results")) {
+        values.emplace_back(s);
+      }
+    }
+
+    return values;
+  };
+
+  // dumper is reused, statements which set up the session are executed once
+  EXPECT_NO_THROW(sd.dump_table_ddl(file.get(), db_name, "at1"));
+
+  EXPECT_EQ(1, count("USE "));
+  EXPECT_EQ(1, count("SET SQL_QUOTE_SHOW_CREATE"));
+  EXPECT_FALSE(character_set_results().empty());
+
+  // same schema, nothing needs to be set up again
+  recording->statements.clear();
+  EXPECT_NO_THROW(sd.dump_table_ddl(file.get(), db_name, "t1"));
+
+  EXPECT_EQ(0, count("USE "));
+  EXPECT_EQ(0, count("SET SQL_QUOTE_SHOW_CREATE"));
+
+  // different schema, only USE is executed
+  recording->statements.clear();
+  EXPECT_NO_THROW(
+      sd.dump_table_ddl(file.get(), compat_db_name, "myisam_tbl1"));
+
+  EXPECT_EQ(1, count("USE "));
+  EXPECT_EQ(0, count("SET SQL_QUOTE_SHOW_CREATE"));
+
+  recording->statements.clear();
+  EXPECT_NO_THROW(sd.dump_table_ddl(file.get(), db_name, "t2"));
+
+  EXPECT_EQ(1, count("USE "));
+  EXPECT_EQ(0, count("SET SQL_QUOTE_SHOW_CREATE"));
+
+  EXPECT_TRUE(output_handler.std_err.empty());
+
+  // character_set_results is switched only if it changes
+  {
+    recording->statements.clear();
+    EXPECT_NO_THROW(sd.dump_table_ddl(file.get(), db_name, "t1"));
+
+    const auto values = character_set_results();
+    ASSERT_FALSE(values.empty());
+    // previous dump restored the default value, first switch is to binary
+    EXPECT_THAT(values.front(), HasSubstr("binary"));
+
+    for (std::size_t i = 1; i < values.size(); ++i) {
+      EXPECT_NE(values[i - 1], values[i]);
+    }
+  }
+
+  EXPECT_EQ(db_name,
+            session->query("SELECT DATABASE()")->fetch_one()->get_string(0));
+  EXPECT_EQ(sd.opt_character_set_results,
+            session->query("SELECT @@SESSION.character_set_results")
+                ->fetch_one()
+                ->get_string(0));
+
+  expect_output_contains({"DROP TABLE IF EXISTS `at1`;",
+                          "DROP TABLE IF EXISTS `myisam_tbl1`;",
+                          "DROP TABLE IF EXISTS `t1`;",
+                          "DROP TABLE IF EXISTS `t2`;"});
+  wipe_all();
+}
+
 TEST_F(Schema_dumper_test, dump_table_with_trigger) {
   Schema_dumper sd(session);
   sd.opt_drop_table = true;
@@ -207,6 +207,9 @@ TEST_P(Object_storage_test, file_write_multipart_upload) {
         std::min(k_min_part_size + 1, k_multipart_file_size - offset));
   }
 
+  // parts are uploaded in the background
+  file->flush();
+
   auto uploads = bucket.list_multipart_uploads();
   EXPECT_EQ(1, uploads.size());
   EXPECT_STREQ("test/sample\".txt", uploads[0].name.c_str());
@@ -281,6 +284,8 @@ TEST_P(Object_storage_test, file_append_resume_interrupted_upload) {
     offset += initial_file->write(data.data() + offset, k_min_part_size + 1);
   }
 
+  initial_file->flush();
+
   auto uploads = bucket.list_multipart_uploads();
   EXPECT_EQ(1, uploads.size());
   EXPECT_STREQ("sample.txt", uploads[0].name.c_str());
@@ -305,6 +310,8 @@ TEST_P(Object_storage_test, file_append_resume_interrupted_upload) {
         std::min(k_min_part_size + 1, k_multipart_file_size - offset));
   }
 
+  final_file->flush();
+
   uploads = bucket.list_multipart_uploads();
   EXPECT_EQ(1, uploads.size());
   EXPECT_STREQ("sample.txt", uploads[0].name.c_str());
@@ -526,6 +533,8 @@ TEST_P(Object_storage_test, file_auto_cancel_multipart_upload) {
         std::min(k_min_part_size + 1, k_multipart_file_size - offset));
   }
 
+  file->flush();
+
   const auto uploads = bucket.list_multipart_uploads();
   EXPECT_EQ(1, uploads.size());
   EXPECT_STREQ("test/sample\".txt", uploads[0].name.c_str());
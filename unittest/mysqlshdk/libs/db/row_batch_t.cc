@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/db/row_batch.h"
+
+#include <string>
+
+#include "unittest/gtest_clean.h"
+
+namespace mysqlshdk {
+namespace db {
+
+namespace {
+
+std::string field(const Row_batch::Row_ref &row, uint32_t idx) {
+  const char *data = nullptr;
+  std::size_t length = 0;
+  row.get_raw_data(idx, &data, &length);
+  return data ? std::string(data, length) : "NULL";
+}
+
+}  // namespace
+
+TEST(Row_batch, empty) {
+  Row_batch batch;
+  batch.reset(3);
+
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(0, batch.size());
+  EXPECT_EQ(3, batch.num_fields());
+  EXPECT_EQ(0, batch.data_size());
+}
+
+TEST(Row_batch, append) {
+  Row_batch batch;
+  batch.reset(3);
+
+  {
+    const char *data[] = {"one", nullptr, ""};
+    const unsigned long lengths[] = {3, 0, 0};
+    batch.append(data, lengths);
+  }
+
+  {
+    const char *data[] = {"two", "2", "second"};
+    const unsigned long lengths[] = {3, 1, 6};
+    batch.append(data, lengths);
+  }
+
+  ASSERT_EQ(2, batch.size());
+  EXPECT_FALSE(batch.empty());
+  EXPECT_EQ(13, batch.data_size());
+
+  const auto first = batch.row(0);
+  EXPECT_EQ(3, first.num_fields());
+  EXPECT_FALSE(first.is_null(0));
+  EXPECT_TRUE(first.is_null(1));
+  EXPECT_FALSE(first.is_null(2));
+  EXPECT_EQ("one", field(first, 0));
+  EXPECT_EQ("NULL", field(first, 1));
+  EXPECT_EQ("", field(first, 2));
+
+  const auto second = batch.row(1);
+  EXPECT_FALSE(second.is_null(1));
+  EXPECT_EQ("two", field(second, 0));
+  EXPECT_EQ("2", field(second, 1));
+  EXPECT_EQ("second", field(second, 2));
+}
+
+TEST(Row_batch, grow_and_reset) {
+  Row_batch batch;
+  batch.reset(1);
+
+  const std::string value(1000, 'x');
+  const char *data[] = {value.c_str()};
+  const std::size_t lengths[] = {value.length()};
+
+  for (int i = 0; i < 100; ++i) {
+    batch.append(data, lengths);
+  }
+
+  ASSERT_EQ(100, batch.size());
+  EXPECT_EQ(100 * value.length(), batch.data_size());
+
+  for (std::size_t i = 0; i < batch.size(); ++i) {
+    EXPECT_EQ(value, field(batch.row(i), 0));
+  }
+
+  batch.reset(2);
+
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(2, batch.num_fields());
+  EXPECT_EQ(0, batch.data_size());
+}
+
+}  // namespace db
+}  // namespace mysqlshdk
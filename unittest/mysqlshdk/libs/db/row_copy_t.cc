@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/db/row_copy.h"
+
+#include <string>
+
+#include "unittest/gtest_clean.h"
+
+namespace mysqlshdk {
+namespace db {
+
+namespace {
+
+std::string raw_data(const IRow &row, uint32_t idx) {
+  const char *data = nullptr;
+  std::size_t length = 0;
+  row.get_raw_data(idx, &data, &length);
+  return data ? std::string(data, length) : "NULL";
+}
+
+}  // namespace
+
+TEST(Row_copy, mutable_row) {
+  Mutable_row row({Type::Integer, Type::UInteger, Type::Double, Type::String,
+                   Type::Bytes, Type::Decimal, Type::Float},
+                  -5, 7u, 2.5, "text", std::string("\0bin", 4), "12.50",
+                  nullptr);
+
+  ASSERT_EQ(7, row.num_fields());
+
+  EXPECT_EQ(-5, row.get_int(0));
+  EXPECT_EQ(7, row.get_uint(1));
+  EXPECT_EQ(2.5, row.get_double(2));
+  EXPECT_EQ("text", row.get_string(3));
+  EXPECT_EQ(std::string("\0bin", 4), row.get_string(4));
+  EXPECT_EQ(12.5, row.get_double(5));
+  EXPECT_TRUE(row.is_null(6));
+
+  const auto data = row.get_string_data(3);
+  EXPECT_EQ("text", std::string(data.first, data.second));
+
+  EXPECT_EQ("-5", raw_data(row, 0));
+  EXPECT_EQ("text", raw_data(row, 3));
+  EXPECT_EQ("12.50", raw_data(row, 5));
+  EXPECT_EQ("NULL", raw_data(row, 6));
+
+  // overwriting values
+  row.set_field(3, std::string(100, 'x'));
+  row.set_field(0, nullptr);
+  row.set_field(6, 1.5f);
+
+  EXPECT_EQ(std::string(100, 'x'), row.get_string(3));
+  EXPECT_EQ(std::string("\0bin", 4), row.get_string(4));
+  EXPECT_TRUE(row.is_null(0));
+  EXPECT_EQ(1.5f, row.get_float(6));
+
+  EXPECT_THROW(row.set_field(0, "text"), std::invalid_argument);
+  EXPECT_THROW(row.set_field(3, 1), std::invalid_argument);
+}
+
+TEST(Row_copy, copy_and_add_field) {
+  const Mutable_row source({Type::String, Type::Integer, Type::Json},
+                           "first", 1, nullptr);
+  Row_copy row(source);
+
+  ASSERT_EQ(3, row.num_fields());
+  EXPECT_EQ("first", row.get_string(0));
+  EXPECT_EQ(1, row.get_int(1));
+  EXPECT_TRUE(row.is_null(2));
+
+  row.add_field(Type::String, 1);
+  row.add_field(Type::Integer);
+
+  ASSERT_EQ(5, row.num_fields());
+  EXPECT_EQ(Type::String, row.get_type(0));
+  EXPECT_EQ(Type::String, row.get_type(1));
+  EXPECT_EQ(Type::Integer, row.get_type(2));
+  EXPECT_EQ(Type::Json, row.get_type(3));
+  EXPECT_EQ(Type::Integer, row.get_type(4));
+
+  EXPECT_EQ("first", row.get_string(0));
+  EXPECT_TRUE(row.is_null(1));
+  EXPECT_EQ(1, row.get_int(2));
+  EXPECT_TRUE(row.is_null(3));
+  EXPECT_TRUE(row.is_null(4));
+}
+
+}  // namespace db
+}  // namespace mysqlshdk
@@ -23,12 +23,18 @@
 
 #include "unittest/mysqlshdk/libs/oci/oci_tests.h"
 
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "mysqlshdk/libs/storage/backend/object_storage.h"
 
 using mysqlshdk::oci::Oci_bucket;
 using mysqlshdk::rest::Response_error;
 using mysqlshdk::storage::Mode;
 using mysqlshdk::storage::backend::object_storage::Directory;
+using mysqlshdk::storage::backend::object_storage::Upload_memory;
 
 namespace testing {
 
@@ -199,6 +205,8 @@ TEST_F(Oci_os_tests, file_write_multipart_upload) {
   offset += file->write(data.data() + offset, 5);
   offset += file->write(data.data() + offset, 5);
   EXPECT_EQ(offset, data.size());
+  // parts are uploaded in the background
+  file->flush();
 
   auto uploads = bucket.list_multipart_uploads();
   EXPECT_EQ(1, uploads.size());
@@ -269,6 +277,7 @@ TEST_F(Oci_os_tests, file_append_resume_interrupted_upload) {
   initial_file->open(Mode::WRITE);
   offset += initial_file->write(data.data() + offset, 5);
   offset += initial_file->write(data.data() + offset, 5);
+  initial_file->flush();
 
   // INTERRUPTION: We stop writing to initial_file as it got interrupted
   // At this point the file is an active multipart upload:
@@ -281,6 +290,7 @@ TEST_F(Oci_os_tests, file_append_resume_interrupted_upload) {
   final_file->open(Mode::APPEND);
   offset = final_file->file_size();
   offset += final_file->write(data.data() + offset, 5);
+  final_file->flush();
   auto uploads = bucket.list_multipart_uploads();
   EXPECT_EQ(1, uploads.size());
   EXPECT_STREQ("sample.txt", uploads[0].name.c_str());
@@ -500,6 +510,7 @@ TEST_F(Oci_os_tests, file_auto_cancel_multipart_upload) {
   offset += file->write(data.data() + offset, 5);
   offset += file->write(data.data() + offset, 5);
   offset += file->write(data.data() + offset, 5);
+  file->flush();
 
   const auto uploads = bucket.list_multipart_uploads();
   EXPECT_EQ(1, uploads.size());
@@ -520,4 +531,168 @@ TEST_F(Oci_os_tests, file_auto_cancel_multipart_upload) {
   EXPECT_TRUE(bucket.list_multipart_uploads().empty());
 }
 
+TEST_F(Oci_os_tests, file_write_multipart_upload_concurrent) {
+  SKIP_IF_NO_OCI_CONFIGURATION;
+
+  auto config = get_config();
+  config->set_part_size(3);
+  Oci_bucket bucket(config);
+  Directory root(config, "test");
+
+  auto file = root.file("sample.txt");
+
+  const auto data = shcore::get_random_string(300, "0123456789ABCDEF");
+
+  file->open(Mode::WRITE);
+  // a single write schedules all the parts, they are uploaded by multiple
+  // threads
+  EXPECT_EQ(data.size(), file->write(data.data(), data.size()));
+  // buffers of the parts are accounted for
+  EXPECT_LT(0, Upload_memory::instance().used());
+  file->flush();
+
+  auto uploads = bucket.list_multipart_uploads();
+  ASSERT_EQ(1, uploads.size());
+  EXPECT_STREQ("test/sample.txt", uploads[0].name.c_str());
+  const auto parts = bucket.list_multipart_uploaded_parts(uploads[0]);
+  EXPECT_EQ(99, parts.size());  // Last part is still on the buffer
+
+  file->close();
+  EXPECT_EQ(0, Upload_memory::instance().used());
+  EXPECT_TRUE(bucket.list_multipart_uploads().empty());
+
+  // parts were uploaded out of order, but object is assembled in order
+  file->open(Mode::READ);
+  std::string buffer;
+  buffer.resize(data.size() + 5);
+  const auto read = file->read(buffer.data(), buffer.size());
+  EXPECT_EQ(data.size(), read);
+  buffer.resize(read);
+  EXPECT_EQ(data, buffer);
+  file->close();
+
+  bucket.delete_object("test/sample.txt");
+}
+
+TEST_F(Oci_os_tests, file_write_multipart_upload_many_writers) {
+  SKIP_IF_NO_OCI_CONFIGURATION;
+
+  auto config = get_config();
+  config->set_part_size(3);
+  Oci_bucket bucket(config);
+  Directory root(config, "test");
+
+  constexpr std::size_t k_files = 20;
+  std::vector<std::unique_ptr<mysqlshdk::storage::IFile>> files;
+  std::vector<std::string> data;
+
+  for (std::size_t i = 0; i < k_files; ++i) {
+    files.emplace_back(root.file("sample" + std::to_string(i) + ".txt"));
+    data.emplace_back(shcore::get_random_string(30, "0123456789ABCDEF"));
+    files.back()->open(Mode::WRITE);
+  }
+
+  // all the writers are active at once, their parts are uploaded by the
+  // threads of the shared pool
+  for (std::size_t offset = 0; offset < 30; offset += 10) {
+    for (std::size_t i = 0; i < k_files; ++i) {
+      EXPECT_EQ(10, files[i]->write(data[i].data() + offset, 10));
+    }
+  }
+
+  for (auto &file : files) {
+    file->close();
+  }
+
+  EXPECT_EQ(0, Upload_memory::instance().used());
+  EXPECT_TRUE(bucket.list_multipart_uploads().empty());
+
+  for (std::size_t i = 0; i < k_files; ++i) {
+    SCOPED_TRACE(i);
+
+    files[i]->open(Mode::READ);
+    std::string buffer;
+    buffer.resize(data[i].size() + 5);
+    buffer.resize(files[i]->read(buffer.data(), buffer.size()));
+    EXPECT_EQ(data[i], buffer);
+    files[i]->close();
+
+    bucket.delete_object("test/sample" + std::to_string(i) + ".txt");
+  }
+}
+
+TEST_F(Oci_os_tests, bucket_shared_by_threads) {
+  SKIP_IF_NO_OCI_CONFIGURATION;
+
+  auto config = get_config();
+  Oci_bucket bucket(config);
+
+  constexpr std::size_t k_threads = 8;
+  std::vector<std::thread> threads;
+  std::vector<std::size_t> sizes(k_threads, 0);
+
+  // single instance is used by multiple threads at once
+  for (std::size_t i = 0; i < k_threads; ++i) {
+    threads.emplace_back([&bucket, &sizes, i]() {
+      const auto name = "test/shared" + std::to_string(i) + ".txt";
+      const auto data = std::string(i + 1, 'a');
+
+      bucket.put_object(name, data.data(), data.size());
+      sizes[i] = bucket.head_object(name);
+      bucket.delete_object(name);
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (std::size_t i = 0; i < k_threads; ++i) {
+    EXPECT_EQ(i + 1, sizes[i]);
+  }
+}
+
+TEST_F(Oci_os_tests, file_write_multipart_upload_abort) {
+  SKIP_IF_NO_OCI_CONFIGURATION;
+
+  auto config = get_config();
+  config->set_part_size(3);
+  Oci_bucket bucket(config);
+  Directory root(config, "test");
+
+  auto file = root.file("sample.txt");
+
+  const auto data = shcore::get_random_string(300, "0123456789ABCDEF");
+  size_t offset = 0;
+
+  file->open(Mode::WRITE);
+  offset += file->write(data.data(), 5);
+  file->flush();
+
+  auto uploads = bucket.list_multipart_uploads();
+  ASSERT_EQ(1, uploads.size());
+
+  // upload is aborted while writer is still running, uploads of the
+  // remaining parts are going to fail
+  bucket.abort_multipart_upload(uploads[0]);
+
+  EXPECT_THROW(
+      {
+        while (offset < data.size()) {
+          offset += file->write(data.data() + offset,
+                                std::min<size_t>(10, data.size() - offset));
+        }
+
+        file->flush();
+      },
+      shcore::Exception);
+
+  // upload threads are stopped, all buffers are released
+  EXPECT_EQ(0, Upload_memory::instance().used());
+
+  file->close();
+  EXPECT_TRUE(bucket.list_multipart_uploads().empty());
+  EXPECT_FALSE(file->exists());
+}
+
 }  // namespace testing
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -375,6 +375,145 @@ TEST_P(Compression, compress_decompress_bigdata) {
   }
 }
 
+TEST_P(Compression, seek_table) {
+  if (storage::Compression::ZSTD != std::get<0>(GetParam())) {
+    return;
+  }
+
+#ifdef _WIN32
+  if (std::get<1>(GetParam()) == "required") {
+    return;
+  }
+#endif
+
+  Generate_text g;
+  const auto input_text = g.bytes(1024 * 1024 + 123);
+
+  Compression_options options;
+  options.frame_size = 64 * 1024;
+
+  auto file = mysqlshdk::storage::make_file(
+      make_output_file(), storage::Compression::ZSTD, options);
+
+  file->open(Mode::WRITE);
+  // write in chunks which are not aligned with the frames
+  for (size_t offset = 0; offset < input_text.size(); offset += 10000) {
+    const auto length = std::min<size_t>(10000, input_text.size() - offset);
+    EXPECT_EQ(static_cast<ssize_t>(length),
+              file->write(input_text.data() + offset, length));
+  }
+  file->close();
+
+  const auto read_all = [&file]() {
+    std::string result;
+    byte buffer[BUFSIZE];
+
+    for (auto read_bytes = file->read(buffer, BUFSIZE); read_bytes > 0;
+         read_bytes = file->read(buffer, BUFSIZE)) {
+      result.append(buffer, read_bytes);
+    }
+
+    return result;
+  };
+
+  // seek table is transparent to the reader
+  file->open(Mode::READ);
+  EXPECT_EQ(input_text, read_all());
+  file->close();
+
+  for (const size_t offset :
+       {0, 1, 65535, 65536, 65537, 300000, 1024 * 1024 + 122, 1024 * 1024 + 123,
+        2 * 1024 * 1024}) {
+    SCOPED_TRACE(offset);
+
+    file->open(Mode::READ);
+    file->seek(offset);
+    EXPECT_EQ(static_cast<off64_t>(std::min(offset, input_text.size())),
+              file->tell());
+    EXPECT_EQ(input_text.substr(std::min(offset, input_text.size())),
+              read_all());
+
+    // seek backwards after the whole file was read
+    file->seek(offset / 2);
+    EXPECT_EQ(input_text.substr(offset / 2, 1000),
+              read_all().substr(0, 1000));
+    file->close();
+  }
+
+  // seeking is not possible if file does not have a seek table
+  auto no_seek_table = mysqlshdk::storage::make_file(
+      std::make_unique<backend::Memory_file>(""), storage::Compression::ZSTD);
+
+  no_seek_table->open(Mode::WRITE);
+  no_seek_table->write(input_text.data(), input_text.size());
+  no_seek_table->close();
+
+  no_seek_table->open(Mode::READ);
+  EXPECT_THROW(no_seek_table->seek(1), std::logic_error);
+  no_seek_table->close();
+}
+
+TEST_P(Compression, parallel_compression) {
+#ifdef _WIN32
+  if (std::get<1>(GetParam()) == "required") {
+    return;
+  }
+#endif
+
+  Generate_text g;
+  const auto input_text = g.bytes(16 * 1024 * 1024 + 123);
+
+  for (const size_t frame_size : {0, 64 * 1024}) {
+    SCOPED_TRACE(frame_size);
+
+    Compression_options options;
+    options.threads = 4;
+    options.frame_size = frame_size;
+
+    auto file = mysqlshdk::storage::make_file(
+        make_output_file(), std::get<0>(GetParam()), options);
+    const auto compressed = dynamic_cast<Compressed_file *>(file.get());
+    ASSERT_NE(nullptr, compressed);
+
+    file->open(Mode::WRITE);
+    // write in chunks which are not aligned with the compressed blocks
+    for (size_t offset = 0; offset < input_text.size(); offset += 10000) {
+      const auto length = std::min<size_t>(10000, input_text.size() - offset);
+      EXPECT_EQ(static_cast<ssize_t>(length),
+                file->write(input_text.data() + offset, length));
+    }
+    EXPECT_EQ(static_cast<off64_t>(input_text.size()), file->tell());
+    file->close();
+
+    // data was compressed by the background threads
+    EXPECT_LT(1, compressed->compression_threads_used());
+    EXPECT_GE(4, compressed->compression_threads_used());
+
+    // gzip data is read back as a single member, zstd frames are read in
+    // sequence
+    std::string result;
+    byte buffer[BUFSIZE];
+
+    file->open(Mode::READ);
+    for (auto read_bytes = file->read(buffer, BUFSIZE); read_bytes > 0;
+         read_bytes = file->read(buffer, BUFSIZE)) {
+      result.append(buffer, read_bytes);
+    }
+    file->close();
+
+    EXPECT_EQ(input_text, result);
+  }
+
+  // compression without background threads
+  auto file = mysqlshdk::storage::make_file(make_output_file(),
+                                            std::get<0>(GetParam()), {});
+  file->open(Mode::WRITE);
+  file->write(input_text.data(), 1024);
+  file->close();
+  EXPECT_EQ(0, dynamic_cast<Compressed_file *>(file.get())
+                   ->compression_threads_used());
+}
+
 inline std::string fmt_compr(
     const testing::TestParamInfo<
         std::tuple<mysqlshdk::storage::Compression, std::string>> &info) {
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "unittest/gprod_clean.h"
+#include "unittest/gtest_clean.h"
+#include "unittest/test_utils/shell_test_env.h"
+
+#include "mysqlshdk/libs/storage/backend/object_storage.h"
+
+namespace mysqlshdk {
+namespace storage {
+namespace backend {
+namespace object_storage {
+
+namespace {
+
+constexpr std::size_t k_mib = 1024 * 1024;
+constexpr std::size_t k_upload_threads = 4;
+
+void wait_a_bit() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+}  // namespace
+
+TEST(Upload_memory_test, limit) {
+  Upload_memory memory;
+  EXPECT_EQ(Upload_memory::k_min_limit, memory.limit());
+
+  // small parts do not change the limit
+  memory.reserve_for(10 * k_mib, k_upload_threads);
+  EXPECT_EQ(Upload_memory::k_min_limit, memory.limit());
+
+  // large parts: all upload threads busy plus one part being filled
+  memory.reserve_for(128 * k_mib, k_upload_threads);
+  EXPECT_EQ(128 * k_mib * (k_upload_threads + 1),
+            memory.limit());
+
+  // limit never shrinks
+  memory.reserve_for(64 * k_mib, k_upload_threads);
+  EXPECT_EQ(128 * k_mib * (k_upload_threads + 1),
+            memory.limit());
+}
+
+TEST(Upload_memory_test, memory_cap) {
+  Upload_memory memory{100};
+
+  // single allocation is always allowed
+  memory.acquire(150);
+  EXPECT_EQ(150, memory.used());
+  memory.release(150);
+  EXPECT_EQ(0, memory.used());
+
+  memory.acquire(60);
+
+  std::atomic<bool> acquired{false};
+  std::thread waiter([&]() {
+    memory.acquire(60);
+    acquired = true;
+  });
+
+  // limit would be exceeded, thread has to wait
+  wait_a_bit();
+  EXPECT_FALSE(acquired);
+  EXPECT_EQ(60, memory.used());
+
+  memory.release(60);
+  waiter.join();
+
+  EXPECT_TRUE(acquired);
+  EXPECT_EQ(60, memory.used());
+
+  // already allocated memory is accounted for, even if it exceeds the limit
+  memory.force_acquire(60);
+  EXPECT_EQ(120, memory.used());
+
+  memory.release(120);
+  EXPECT_EQ(0, memory.used());
+}
+
+TEST(Upload_memory_test, can_proceed) {
+  Upload_memory memory{100};
+  std::atomic<bool> own_parts_uploaded{false};
+  std::atomic<bool> acquired{false};
+
+  memory.acquire(100);
+
+  std::thread waiter([&]() {
+    memory.acquire(50, [&]() { return own_parts_uploaded.load(); });
+    acquired = true;
+  });
+
+  wait_a_bit();
+  EXPECT_FALSE(acquired);
+
+  // predicate is checked when memory is released
+  own_parts_uploaded = true;
+  memory.release(10);
+  waiter.join();
+
+  EXPECT_TRUE(acquired);
+  EXPECT_EQ(140, memory.used());
+
+  memory.release(140);
+}
+
+TEST(Upload_memory_test, concurrent_writers) {
+  constexpr std::size_t k_part_size = 10;
+  constexpr std::size_t k_writers = 8;
+  Upload_memory memory{4 * k_part_size};
+  std::atomic<std::size_t> in_use{0};
+  std::atomic<std::size_t> max_in_use{0};
+  std::vector<std::thread> writers;
+
+  for (std::size_t i = 0; i < k_writers; ++i) {
+    writers.emplace_back([&]() {
+      for (int part = 0; part < 100; ++part) {
+        memory.acquire(k_part_size);
+
+        const auto current = in_use += k_part_size;
+        auto max = max_in_use.load();
+        while (current > max && !max_in_use.compare_exchange_weak(max, current))
+          ;
+
+        std::this_thread::yield();
+
+        in_use -= k_part_size;
+        memory.release(k_part_size);
+      }
+    });
+  }
+
+  for (auto &writer : writers) {
+    writer.join();
+  }
+
+  EXPECT_LE(max_in_use, memory.limit());
+  EXPECT_EQ(0, memory.used());
+}
+
+}  // namespace object_storage
+}  // namespace backend
+}  // namespace storage
+}  // namespace mysqlshdk
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "unittest/gprod_clean.h"
+#include "unittest/gtest_clean.h"
+#include "unittest/test_utils/shell_test_env.h"
+
+#include "mysqlshdk/libs/storage/backend/memory_file.h"
+#include "mysqlshdk/libs/storage/read_ahead_file.h"
+
+namespace mysqlshdk {
+namespace storage {
+namespace tests {
+
+namespace {
+
+constexpr std::size_t k_block_size = 256;
+
+class Failing_file : public backend::Memory_file {
+ public:
+  Failing_file(std::string data, off64_t fail_at)
+      : Memory_file(""), m_fail_at(fail_at) {
+    set_content(std::move(data));
+  }
+
+  ssize_t read(void *buffer, size_t length) override {
+    if (tell() >= m_fail_at) {
+      throw std::runtime_error("read failed");
+    }
+
+    return Memory_file::read(
+        buffer, std::min<std::size_t>(length, m_fail_at - tell()));
+  }
+
+ private:
+  off64_t m_fail_at;
+};
+
+std::string test_data(std::size_t size) {
+  std::string data(size, '\0');
+  std::iota(data.begin(), data.end(), 'a');
+  return data;
+}
+
+std::unique_ptr<Read_ahead_file> make_file(const std::string &data) {
+  auto file = std::make_unique<backend::Memory_file>("");
+  file->set_content(data);
+
+  auto result =
+      std::make_unique<Read_ahead_file>(std::move(file), k_block_size);
+  result->open(Mode::READ);
+
+  return result;
+}
+
+std::string read_all(IFile *file, std::size_t length) {
+  std::string result;
+  std::string buffer(length, '\0');
+  ssize_t bytes;
+
+  while ((bytes = file->read(&buffer[0], buffer.size())) > 0) {
+    result.append(buffer.data(), bytes);
+  }
+
+  EXPECT_EQ(0, bytes);
+
+  return result;
+}
+
+}  // namespace
+
+TEST(Read_ahead_file, sequential) {
+  const auto data = test_data(10 * k_block_size + 17);
+
+  for (const auto length : {1, 100, 256, 1000, 100000}) {
+    SCOPED_TRACE("length: " + std::to_string(length));
+
+    const auto file = make_file(data);
+    EXPECT_EQ(data, read_all(file.get(), length));
+    EXPECT_EQ(static_cast<off64_t>(data.size()), file->tell());
+    file->close();
+  }
+}
+
+TEST(Read_ahead_file, empty) {
+  const auto file = make_file("");
+  EXPECT_EQ("", read_all(file.get(), 100));
+  file->close();
+}
+
+TEST(Read_ahead_file, seek) {
+  const auto data = test_data(10 * k_block_size);
+  const auto file = make_file(data);
+  std::string buffer(100, '\0');
+
+  EXPECT_EQ(100, file->read(&buffer[0], buffer.size()));
+  EXPECT_EQ(data.substr(0, 100), buffer);
+  EXPECT_EQ(100, file->tell());
+
+  // data which was read ahead is discarded
+  EXPECT_EQ(2000, file->seek(2000));
+  EXPECT_EQ(2000, file->tell());
+  EXPECT_EQ(data.substr(2000), read_all(file.get(), 100));
+
+  // reopening starts from the beginning
+  file->close();
+  file->open(Mode::READ);
+  EXPECT_EQ(data, read_all(file.get(), 100));
+  file->close();
+}
+
+TEST(Read_ahead_file, error) {
+  const auto data = test_data(10 * k_block_size);
+  Read_ahead_file file{std::make_unique<Failing_file>(data, 1000),
+                       k_block_size};
+  file.open(Mode::READ);
+
+  std::string result;
+  std::string buffer(100, '\0');
+
+  // data read before the failure is returned, then error is reported
+  EXPECT_THROW_LIKE(
+      {
+        while (true) {
+          const auto bytes = file.read(&buffer[0], buffer.size());
+          ASSERT_LT(0, bytes);
+          result.append(buffer.data(), bytes);
+        }
+      },
+      std::runtime_error, "read failed");
+
+  EXPECT_EQ(data.substr(0, 1000), result);
+  file.close();
+}
+
+}  // namespace tests
+}  // namespace storage
+}  // namespace mysqlshdk
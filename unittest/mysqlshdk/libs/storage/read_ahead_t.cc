@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "unittest/gprod_clean.h"
+#include "unittest/gtest_clean.h"
+#include "unittest/test_utils/shell_test_env.h"
+
+#include "mysqlshdk/libs/storage/read_ahead.h"
+
+namespace mysqlshdk {
+namespace storage {
+namespace tests {
+
+namespace {
+
+std::string test_data(std::size_t size) {
+  std::string data(size, '\0');
+  std::iota(data.begin(), data.end(), 'a');
+  return data;
+}
+
+class Fake_remote_file {
+ public:
+  explicit Fake_remote_file(std::string data) : m_data(std::move(data)) {}
+
+  Read_ahead::Fetch_factory factory() {
+    return [this]() -> Read_ahead::Fetch {
+      ++m_fetchers;
+
+      return [this](off64_t offset, std::size_t length, char *buffer) {
+        ++m_requests;
+
+        ++m_active;
+
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_fetch_threads.emplace(std::this_thread::get_id());
+        }
+
+        if (m_delay.count() > 0) {
+          std::this_thread::sleep_for(m_delay);
+        }
+
+        --m_active;
+
+        if (m_fail_at >= 0 && offset >= m_fail_at) {
+          throw std::runtime_error("fetch failed");
+        }
+
+        const auto size = std::min(length, m_data.size() - offset);
+        m_data.copy(buffer, size, offset);
+        return size;
+      };
+    };
+  }
+
+  const std::string &data() const { return m_data; }
+
+  std::atomic<int> m_fetchers{0};
+  std::atomic<int> m_requests{0};
+  std::atomic<off64_t> m_fail_at{-1};
+  std::chrono::milliseconds m_delay{0};
+  std::atomic<int> m_active{0};
+  std::mutex m_mutex;
+  std::set<std::thread::id> m_fetch_threads;
+
+ private:
+  std::string m_data;
+};
+
+std::string read_all(Read_ahead *reader, off64_t offset, std::size_t length,
+                     std::size_t chunk) {
+  std::string result;
+  std::vector<char> buffer(chunk);
+
+  while (length > 0) {
+    const auto read =
+        reader->read(offset, buffer.data(), std::min(length, chunk));
+
+    if (0 == read) break;
+
+    result.append(buffer.data(), read);
+    offset += read;
+    length -= read;
+  }
+
+  return result;
+}
+
+}  // namespace
+
+TEST(Read_ahead, sequential) {
+  Fake_remote_file file{test_data(1000)};
+
+  for (const auto chunk : {1, 7, 10, 64, 100, 2000}) {
+    SCOPED_TRACE("chunk: " + std::to_string(chunk));
+
+    Read_ahead reader{file.factory(), file.data().size(), 64, 4};
+
+    EXPECT_EQ(file.data(), read_all(&reader, 0, file.data().size(), chunk));
+
+    char c;
+    EXPECT_EQ(0, reader.read(file.data().size(), &c, 1));
+  }
+}
+
+TEST(Read_ahead, small_reads_are_prefetched) {
+  Fake_remote_file file{test_data(1000)};
+  Read_ahead reader{file.factory(), file.data().size(), 100, 4};
+
+  EXPECT_EQ(file.data(), read_all(&reader, 0, file.data().size(), 10));
+
+  // first read is direct, the remaining 990 bytes are fetched in 10 blocks
+  EXPECT_EQ(11, file.m_requests);
+}
+
+TEST(Read_ahead, seek) {
+  Fake_remote_file file{test_data(1000)};
+  Read_ahead reader{file.factory(), file.data().size(), 64, 4};
+
+  EXPECT_EQ(file.data().substr(0, 300), read_all(&reader, 0, 300, 10));
+  EXPECT_EQ(file.data().substr(900), read_all(&reader, 900, 1000, 10));
+  EXPECT_EQ(file.data().substr(100, 500), read_all(&reader, 100, 500, 33));
+  EXPECT_EQ(file.data().substr(550, 5), read_all(&reader, 550, 5, 33));
+  EXPECT_EQ(file.data().substr(555), read_all(&reader, 555, 1000, 33));
+}
+
+TEST(Read_ahead, random_reads_are_not_prefetched) {
+  Fake_remote_file file{test_data(1000)};
+  Read_ahead reader{file.factory(), file.data().size(), 64, 4};
+
+  for (const auto offset : {990, 0, 500, 100, 700}) {
+    EXPECT_EQ(file.data().substr(offset, 10), read_all(&reader, offset, 10, 10));
+  }
+
+  EXPECT_EQ(5, file.m_requests);
+  // only the calling thread fetched the data
+  EXPECT_EQ(1, file.m_fetchers);
+}
+
+TEST(Read_ahead, error) {
+  Fake_remote_file file{test_data(1000)};
+  file.m_fail_at = 500;
+
+  Read_ahead reader{file.factory(), file.data().size(), 64, 4};
+
+  EXPECT_EQ(file.data().substr(0, 400), read_all(&reader, 0, 400, 10));
+  EXPECT_THROW_LIKE(read_all(&reader, 400, 600, 10), std::runtime_error,
+                    "fetch failed");
+
+  file.m_fail_at = -1;
+  EXPECT_EQ(file.data().substr(400), read_all(&reader, 400, 600, 10));
+}
+
+TEST(Read_ahead, close_mid_read) {
+  Fake_remote_file file{test_data(1000)};
+  file.m_delay = std::chrono::milliseconds(20);
+
+  utils::Worker_pool pool{1};
+  auto reader = std::make_unique<Read_ahead>(
+      file.factory(), file.data().size(), 10, 4, &pool);
+
+  // first read is direct, second one starts the prefetch
+  EXPECT_EQ(file.data().substr(0, 30), read_all(reader.get(), 0, 30, 10));
+
+  reader.reset();
+
+  // blocks which were not fetched yet are skipped
+  const int requests = file.m_requests;
+  EXPECT_GT(100, requests);
+  EXPECT_FALSE(pool.run_pending_job());
+
+  // nothing is fetched once reader is closed
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(requests, file.m_requests);
+  EXPECT_EQ(0, file.m_active);
+}
+
+TEST(Read_ahead, shared_pool) {
+  constexpr std::size_t k_readers = 8;
+  Fake_remote_file file{test_data(1000)};
+  file.m_delay = std::chrono::milliseconds(1);
+
+  utils::Worker_pool pool{2};
+  std::vector<std::thread> threads;
+  std::set<std::thread::id> reader_threads;
+
+  for (std::size_t i = 0; i < k_readers; ++i) {
+    threads.emplace_back([&]() {
+      Read_ahead reader{file.factory(), file.data().size(), 64, 4, &pool};
+      EXPECT_EQ(file.data(), read_all(&reader, 0, file.data().size(), 10));
+    });
+
+    reader_threads.emplace(threads.back().get_id());
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // readers fetch their first read directly, the rest is fetched by the two
+  // threads of the pool, regardless of the number of readers
+  std::size_t fetch_threads = 0;
+
+  for (const auto &id : file.m_fetch_threads) {
+    if (!reader_threads.count(id)) ++fetch_threads;
+  }
+
+  EXPECT_LE(1, fetch_threads);
+  EXPECT_GE(2, fetch_threads);
+}
+
+}  // namespace tests
+}  // namespace storage
+}  // namespace mysqlshdk
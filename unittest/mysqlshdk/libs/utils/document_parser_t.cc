@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Oracle and/or its affiliates.
+ * Copyright (c) 2020, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -22,9 +22,12 @@
  */
 
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include "mysqlshdk/libs/utils/document_parser.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
 #include "unittest/gtest_clean.h"
 #include "unittest/test_utils/shell_test_env.h"
 
@@ -167,4 +170,58 @@ TEST(Document_parser, bom_utf32be) {
                       "UTF-32BE encoded document is not supported.");
   }
 }
+
+TEST(Document_parser, buffer_boundaries) {
+  // documents are larger than the input buffer, strings and values are split
+  // between the buffers at different positions
+  std::vector<std::string> documents;
+
+  for (const auto size : {65530, 65535, 65536, 100000}) {
+    documents.emplace_back("{\"a\": \"" + std::string(size, 'x') +
+                           "\\\"" + std::string(size % 7, 'y') + "\\\\\", " +
+                           "\"b\": [" + std::string(size % 5, ' ') +
+                           "12345.678, true, null], \"c\": {}}");
+  }
+
+  const std::string filename{"test.json"};
+  shcore::create_file(filename, shcore::str_join(documents, "\n"), true);
+  auto exit_scope =
+      shcore::on_leave_scope([&]() { shcore::delete_file(filename); });
+
+  shcore::Buffered_input input{filename};
+  shcore::Document_reader_options options{};
+  shcore::Json_reader reader(&input, options);
+  reader.parse_bom();
+
+  for (const auto &expected : documents) {
+    ASSERT_FALSE(reader.eof());
+    // trailing whitespace is included in the document
+    EXPECT_EQ(expected, shcore::str_rstrip(reader.next()));
+  }
+
+  EXPECT_EQ("", reader.next());
+  EXPECT_TRUE(reader.eof());
+}
+
+TEST(Document_parser, premature_end) {
+  for (const auto &content :
+       {"{\"a\": \"x", "{\"a\": \"x\\", "{\"a\": [1, 2", "{\"a\": tru"}) {
+    SCOPED_TRACE(content);
+    EXPECT_THROW_LIKE(process_input(content), shcore::invalid_json,
+                      "Premature end of input stream");
+  }
+}
+
+TEST(Document_parser, unescaped_control_characters) {
+  // a raw line break in a string could be mistaken for a document boundary
+  for (const auto &content :
+       {"{\"a\": \"x}\n{\"}", "{\"a\": \"\t\"}", "{\"a\": \"x\\\"\r\"}",
+        "{\"a\": [\"\x01\"]}"}) {
+    SCOPED_TRACE(content);
+    EXPECT_THROW_LIKE(process_input(content), shcore::invalid_json,
+                      "Unescaped control character in a string");
+  }
+
+  EXPECT_EQ(2, process_input("{\"a\": \"x}\\n{\\t\"}\n{\"b\": \"\\r\"}"));
+}
 }  // namespace shcore
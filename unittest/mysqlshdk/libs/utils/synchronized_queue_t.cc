@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "unittest/gprod_clean.h"
+#include "unittest/gtest_clean.h"
+
+#include "mysqlshdk/libs/utils/synchronized_queue.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace shcore {
+
+TEST(Synchronized_queue, fifo) {
+  Synchronized_queue<std::string> queue;
+
+  // more values than the lock-free queue can hold
+  for (int i = 0; i < 1000; ++i) {
+    queue.push(std::to_string(i));
+  }
+
+  EXPECT_EQ(1000, queue.size());
+
+  for (int i = 0; i < 500; ++i) {
+    EXPECT_EQ(std::to_string(i), queue.pop());
+  }
+
+  for (int i = 1000; i < 1100; ++i) {
+    queue.push(std::to_string(i));
+  }
+
+  for (int i = 500; i < 1100; ++i) {
+    EXPECT_EQ(std::to_string(i), queue.pop());
+  }
+
+  EXPECT_EQ(0, queue.size());
+}
+
+TEST(Synchronized_queue, priority) {
+  Synchronized_queue<int> queue;
+
+  queue.push(1, Queue_priority::LOW);
+  queue.push(2, Queue_priority::MEDIUM);
+  queue.push(3, Queue_priority::HIGH);
+  queue.shutdown(1);
+  queue.push(4, Queue_priority::LOW);
+  queue.push(5, Queue_priority::HIGH);
+  queue.push(6);
+
+  for (const auto expected : {3, 5, 2, 6, 1, 4, 0}) {
+    EXPECT_EQ(expected, queue.pop());
+  }
+}
+
+TEST(Synchronized_queue, try_pop) {
+  Synchronized_queue<std::unique_ptr<int>> queue;
+
+  EXPECT_FALSE(queue.try_pop(std::chrono::milliseconds{1}).has_value());
+
+  std::thread producer{[&queue]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    queue.push(std::make_unique<int>(7));
+  }};
+
+  const auto value = queue.try_pop(std::chrono::seconds{60});
+  producer.join();
+
+  ASSERT_TRUE(value.has_value());
+  ASSERT_NE(nullptr, *value);
+  EXPECT_EQ(7, **value);
+}
+
+TEST(Synchronized_queue, multiple_producers_and_consumers) {
+  constexpr int k_producers = 8;
+  constexpr int k_consumers = 8;
+  constexpr int k_values = 20000;
+
+  Synchronized_queue<std::unique_ptr<std::pair<int, int>>> queue;
+  std::vector<std::vector<std::pair<int, int>>> consumed(k_consumers);
+  std::vector<std::thread> threads;
+
+  for (int c = 0; c < k_consumers; ++c) {
+    threads.emplace_back([&queue, &result = consumed[c]]() {
+      while (auto value = queue.pop()) {
+        result.emplace_back(*value);
+      }
+    });
+  }
+
+  std::vector<std::thread> producers;
+
+  for (int p = 0; p < k_producers; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for (int i = 0; i < k_values; ++i) {
+        queue.push(std::make_unique<std::pair<int, int>>(p, i));
+      }
+    });
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+
+  queue.shutdown(k_consumers);
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<int> count(k_producers, 0);
+
+  for (const auto &result : consumed) {
+    std::vector<int> last(k_producers, -1);
+
+    for (const auto &value : result) {
+      // each consumer gets values of a single producer in order
+      EXPECT_LT(last[value.first], value.second);
+      last[value.first] = value.second;
+      ++count[value.first];
+    }
+  }
+
+  for (const auto c : count) {
+    EXPECT_EQ(k_values, c);
+  }
+
+  EXPECT_EQ(0, queue.size());
+}
+
+}  // namespace shcore
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/libs/utils/utils_scan.h"
+
+#include <string>
+
+#include "unittest/gtest_clean.h"
+
+namespace shcore {
+
+TEST(Utils_scan, find_char) {
+  SCOPED_TRACE(find_char_implementation());
+
+  const std::string empty;
+  EXPECT_EQ(empty.c_str(),
+            find_char(empty.c_str(), empty.c_str() + empty.length(), 'x'));
+
+  // test all possible positions, with needle crossing the vector boundaries
+  for (std::size_t length = 1; length <= 100; ++length) {
+    for (std::size_t position = 0; position < length; ++position) {
+      std::string s(length, '.');
+      s[position] = '\n';
+
+      const auto begin = s.c_str();
+      const auto end = begin + s.length();
+
+      EXPECT_EQ(begin + position, find_char(begin, end, '\n'));
+      EXPECT_EQ(begin + position, find_char_scalar(begin, end, '\n'));
+      EXPECT_EQ(end, find_char(begin, end, 'x'));
+      EXPECT_EQ(begin + position, find_char(begin, begin + position, '\n'));
+    }
+  }
+}
+
+TEST(Utils_scan, find_char_first_match) {
+  const std::string s = "abcdefghijklmnopqrstuvwxyz0123456789,abcdefghijklmn,";
+  const auto begin = s.c_str();
+  const auto end = begin + s.length();
+
+  EXPECT_EQ(begin + 36, find_char(begin, end, ','));
+  EXPECT_EQ(begin + 51, find_char(begin + 37, end, ','));
+  EXPECT_EQ(end, find_char(begin + 52, end, ','));
+}
+
+TEST(Utils_scan, find_char_high_bit) {
+  std::string s(64, 'a');
+  s[40] = '\xff';
+
+  const auto begin = reinterpret_cast<const uint8_t *>(s.c_str());
+  const auto end = begin + s.length();
+
+  EXPECT_EQ(begin + 40, find_char(begin, end, uint8_t{0xff}));
+  EXPECT_EQ(end, find_char(begin, end, uint8_t{0x80}));
+}
+
+}  // namespace shcore
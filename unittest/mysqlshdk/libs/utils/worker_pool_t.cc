@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include "unittest/gprod_clean.h"
+#include "unittest/gtest_clean.h"
+#include "unittest/test_utils/shell_test_env.h"
+
+#include "mysqlshdk/libs/utils/threads.h"
+#include "mysqlshdk/libs/utils/worker_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace mysqlshdk {
+namespace utils {
+
+TEST(Worker_pool, all_jobs_executed) {
+  Worker_pool pool(4);
+  const auto group = pool.create_group();
+
+  std::atomic<int> executed{0};
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+
+  for (int i = 0; i < 100; ++i) {
+    pool.submit(group, [&]() {
+      ++executed;
+      std::lock_guard<std::mutex> lock(mutex);
+      threads.emplace(std::this_thread::get_id());
+    });
+  }
+
+  group->wait();
+
+  EXPECT_EQ(100, executed);
+  EXPECT_GE(4, threads.size());
+  EXPECT_EQ(0, threads.count(std::this_thread::get_id()));
+  EXPECT_FALSE(pool.in_worker_thread());
+}
+
+TEST(Worker_pool, thread_init) {
+  std::atomic<int> initialized{0};
+  std::atomic<int> released{0};
+
+  {
+    Worker_pool pool(2, [&]() {
+      ++initialized;
+      return std::shared_ptr<void>(nullptr, [&](void *) { ++released; });
+    });
+    const auto group = pool.create_group();
+
+    for (int i = 0; i < 10; ++i) {
+      pool.submit(group, [&pool]() { EXPECT_TRUE(pool.in_worker_thread()); });
+    }
+
+    group->wait();
+  }
+
+  EXPECT_LE(1, initialized);
+  EXPECT_GE(2, initialized);
+  EXPECT_EQ(initialized, released);
+}
+
+TEST(Worker_pool, exception) {
+  Worker_pool pool(2);
+  const auto group = pool.create_group();
+  std::atomic<int> executed{0};
+
+  for (int i = 0; i < 10; ++i) {
+    pool.submit(group, [&executed, i]() {
+      ++executed;
+      if (5 == i) throw std::runtime_error("failed");
+    });
+  }
+
+  EXPECT_THROW_LIKE(group->wait(), std::runtime_error, "failed");
+  // remaining jobs are still executed
+  EXPECT_EQ(10, executed);
+}
+
+TEST(Worker_pool, cancel) {
+  Worker_pool pool(1);
+  const auto group = pool.create_group();
+  std::atomic<int> executed{0};
+  std::atomic<int> skipped{0};
+
+  pool.submit(group, [&group]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    group->cancel();
+  });
+
+  for (int i = 0; i < 10; ++i) {
+    pool.submit(
+        group, [&executed]() { ++executed; }, [&skipped]() { ++skipped; });
+  }
+
+  group->wait();
+
+  EXPECT_TRUE(group->cancelled());
+  EXPECT_EQ(0, executed);
+  EXPECT_EQ(10, skipped);
+}
+
+TEST(Worker_pool, deadline) {
+  Worker_pool pool(1);
+  const auto group = pool.create_group(Worker_pool::Clock::now() +
+                                       std::chrono::milliseconds(50));
+  std::atomic<int> executed{0};
+  std::atomic<int> skipped{0};
+
+  pool.submit(group, [&executed]() {
+    ++executed;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  });
+
+  for (int i = 0; i < 10; ++i) {
+    pool.submit(
+        group, [&executed]() { ++executed; }, [&skipped]() { ++skipped; });
+  }
+
+  group->wait();
+
+  EXPECT_TRUE(group->cancelled());
+  EXPECT_EQ(1, executed);
+  EXPECT_EQ(10, skipped);
+}
+
+TEST(Worker_pool, nested_groups) {
+  // each job waits for jobs it has submitted, with a single worker this would
+  // deadlock if waiting thread was not executing the pending jobs
+  Worker_pool pool(1);
+  const auto group = pool.create_group();
+  std::atomic<int> executed{0};
+
+  for (int i = 0; i < 5; ++i) {
+    pool.submit(group, [&pool, &executed]() {
+      const auto nested = pool.create_group();
+
+      for (int j = 0; j < 5; ++j) {
+        pool.submit(nested, [&executed]() { ++executed; });
+      }
+
+      nested->wait();
+    });
+  }
+
+  group->wait();
+
+  EXPECT_EQ(25, executed);
+}
+
+TEST(Worker_pool, map_reduce) {
+  Worker_pool pool(3);
+  std::vector<int> input;
+
+  for (int i = 1; i <= 100; ++i) {
+    input.emplace_back(i);
+  }
+
+  const auto map = [](int i) { return i * 2; };
+  const auto reduce = [](int total, int i) { return total + i; };
+
+  EXPECT_EQ(10100, (map_reduce<int, int>(input.begin(), input.end(), map,
+                                         reduce, &pool)));
+
+  // nested call from a worker thread
+  const auto group = pool.create_group();
+  int nested_result = 0;
+
+  pool.submit(group, [&]() {
+    nested_result =
+        map_reduce<int, int>(input.begin(), input.end(), map, reduce, &pool);
+  });
+
+  group->wait();
+
+  EXPECT_EQ(10100, nested_result);
+
+  // failure
+  EXPECT_THROW_LIKE(
+      (map_reduce<int, int>(
+          input.begin(), input.end(),
+          [](int i) {
+            if (50 == i) throw std::runtime_error("map failed");
+            return i;
+          },
+          reduce, &pool)),
+      std::runtime_error, "map failed");
+}
+
+TEST(Worker_pool, map_reduce_reduce_throws) {
+  Worker_pool pool(4);
+  std::vector<int> input(20, 1);
+  std::atomic<int> executed{0};
+  std::atomic<int> running{0};
+
+  EXPECT_THROW_LIKE(
+      (map_reduce<int, int>(
+          input.begin(), input.end(),
+          [&](int i) {
+            ++running;
+            ++executed;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            --running;
+            return i;
+          },
+          [](int, int) -> int { throw std::runtime_error("reduce failed"); },
+          &pool)),
+      std::runtime_error, "reduce failed");
+
+  // jobs which were running have finished, the remaining ones were skipped
+  EXPECT_EQ(0, running);
+  EXPECT_GT(20, executed);
+}
+
+TEST(Worker_pool, shutdown_default_worker_pool) {
+  struct Thread_exit {
+    explicit Thread_exit(std::atomic<int> *c) : counter(c) {}
+    ~Thread_exit() { ++(*counter); }
+    std::atomic<int> *counter;
+  };
+
+  std::atomic<int> exited{0};
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+  std::vector<int> input(10, 1);
+
+  for_each_in_parallel(input.begin(), input.end(), 4, [&](int) {
+    thread_local Thread_exit on_exit{&exited};
+    (void)on_exit;
+    std::lock_guard<std::mutex> lock(mutex);
+    threads.emplace(std::this_thread::get_id());
+  });
+
+  shutdown_default_worker_pool();
+
+  // all worker threads have finished
+  EXPECT_EQ(static_cast<int>(threads.size()), exited);
+
+  // pool is created again when needed
+  EXPECT_EQ(10, (map_reduce<int, int>(
+                    input.begin(), input.end(), [](int i) { return i; },
+                    [](int total, int i) { return total + i; })));
+}
+
+TEST(Worker_pool, for_each_in_parallel) {
+  Worker_pool pool(8);
+  std::vector<int> input(50, 1);
+  std::atomic<int> total{0};
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+
+  for_each_in_parallel(
+      input.begin(), input.end(), 3,
+      [&](int i) {
+        const auto current = ++running;
+        int expected = max_running;
+
+        while (current > expected &&
+               !max_running.compare_exchange_weak(expected, current)) {
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        total += i;
+        --running;
+      },
+      &pool);
+
+  EXPECT_EQ(50, total);
+  EXPECT_GE(3, max_running);
+}
+
+}  // namespace utils
+}  // namespace mysqlshdk
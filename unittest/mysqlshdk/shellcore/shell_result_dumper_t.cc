@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * Copyright (c) 2018, 2022, Oracle and/or its affiliates. All rights reserved.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -66,4 +66,12 @@ TEST(Resultset_dumper, get_data_sizes) {
 
   // Multibyte character 3 bytes represented in 2 spaces
   TEST_DATA_SIZES("I 爱 MySQL Shell\0", 17, Print_flags(), 16, 17);
+
+  // ASCII text spanning several words, followed by multibyte characters
+  TEST_DATA_SIZES("MySQL\tShell\\MySQL\0Shell ❤ 爱", 31,
+                  Print_flags(Print_flag::PRINT_CTRL), 29, 33);
+  TEST_DATA_SIZES("MySQL\tShell\\MySQL\0Shell ❤ 爱", 31,
+                  Print_flags(Print_flag::PRINT_0_AS_ESC), 29, 32);
+  TEST_DATA_SIZES("MySQL Shell MySQL Shell MySQL Shell", 35,
+                  Print_flags(Print_flag::PRINT_0_AS_SPC), 35, 35);
 }
@@ -534,6 +534,28 @@ EXPECT_STDOUT_CONTAINS(
     '" to collection `wl10606`.`2MB_less________` in MySQL Server at');
 EXPECT_STDOUT_CONTAINS("Total successfully imported documents 1 ");
 
+//@<> Import documents using multiple threads
+var ndjson_file = os.path.join(__tmp_dir, "wl10606_threads.json");
+var documents = [];
+for (var i = 0; i < 1000; ++i) {
+  // every other document spans multiple lines
+  documents.push(i % 2 ? '{"_id": "' + i + '", "n": ' + i + '}' :
+                         '{\n  "_id": "' + i + '",\n  "n": ' + i + '\n}');
+}
+testutil.createFile(ndjson_file, documents.join("\n") + "\n");
+
+util.importJson(ndjson_file, {
+  schema : target_schema,
+  collection: "threads",
+  threads: 4
+});
+EXPECT_STDOUT_CONTAINS("Total successfully imported documents 1000 ");
+EXPECT_EQ(1000, session.getSchema(target_schema).getCollection("threads").count());
+EXPECT_EQ(499500, session.sql("SELECT SUM(doc->>'$.n') FROM `" + target_schema +
+                              "`.threads").execute().fetchOne()[0]);
+
+testutil.rmfile(ndjson_file);
+
 //@<> Import document using invalid options
 EXPECT_THROWS(function() {
   util.importJson(__import_data_path + '/2MB_doc.json', {
@@ -543,6 +565,30 @@ EXPECT_THROWS(function() {
   });
 }, "Util.importJson: Argument #2: Invalid options: unexisting");
 
+for (const threads of [0, -1]) {
+  EXPECT_THROWS(function() {
+    util.importJson(__import_data_path + '/sample.json', {
+      schema : target_schema,
+      collection: "threads",
+      threads: threads
+    });
+  }, "Util.importJson: The value of 'threads' option must be greater than 0.");
+}
+
+//@<> Import document with a raw line break in a string
+var raw_line_break_file = os.path.join(__tmp_dir, "wl10606_raw_line_break.json");
+testutil.createFile(raw_line_break_file, '{"_id": "1", "s": "a}\n{"}\n');
+
+EXPECT_THROWS(function() {
+  util.importJson(raw_line_break_file, {
+    schema : target_schema,
+    collection: "raw_line_break",
+    threads: 2
+  });
+}, "Util.importJson: Unescaped control character in a string");
+
+testutil.rmfile(raw_line_break_file);
+
 //@ Teardown
 session.close();
 testutil.destroySandbox(target_port);
@@ -26,6 +26,10 @@ session.sql('select * from resultset_dumper.bindata');
 shell.options.resultFormat = 'json/raw';
 session.sql('select * from resultset_dumper.bindata');
 
+//@ X CSV Format
+shell.options.resultFormat = 'csv';
+session.sql('select * from resultset_dumper.bindata');
+
 //@ X Json Wrapping
 testutil.callMysqlsh([__uripwd, "--js", "--quiet-start=2", "-i", "--json", "-e", "session.sql('select * from resultset_dumper.bindata');"]);
 session.close();
@@ -51,6 +55,21 @@ session.runSql('select * from resultset_dumper.bindata');
 shell.options.resultFormat = 'json/raw';
 session.runSql('select * from resultset_dumper.bindata');
 
+//@ Classic CSV Format
+shell.options.resultFormat = 'csv';
+session.runSql('select * from resultset_dumper.bindata');
+
+//@ Classic CSV Format - special values
+session.runSql("select 1 as a, null as b, '' as c, 'x,\"y\"' as d, 1.5 as e");
+
+//@ Classic Raw Json Format - special values
+shell.options.resultFormat = 'json/raw';
+session.runSql("select 1 as a, null as b, '' as c, 'x,\"y\"' as d, 1.5 as e");
+
+//@ Classic Json Array Format - special values
+shell.options.resultFormat = 'json/array';
+session.runSql("select 1 as a, null as b, '' as c, 'x,\"y\"' as d, 1.5 as e union all select 2, 'b', 'c\\td', 'e', 2.25");
+
 //@ Classic Json Wrapping
 testutil.callMysqlsh([__mysqluripwd, "--js", "--quiet-start=2", "-i", "--json", "-e", "session.runSql('select * from resultset_dumper.bindata');"]);
 shell.options.resultFormat = 'table';
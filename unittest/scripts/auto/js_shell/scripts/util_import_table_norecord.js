@@ -315,6 +315,15 @@ session.runSql('TRUNCATE TABLE cities');
 util.importTable(__import_data_path + '/world_x_cities.zst', { schema: target_schema, table: 'cities' })
 EXPECT_EQ(4079, session.runSql('select count(*) from cities').fetchOne()[0])
 
+//@<> Import compressed files with skipRows, result does not depend on the number of threads
+for (const file of ['world_x_cities.gz', 'world_x_cities.zst']) {
+  for (const threads of [1, 4]) {
+    session.runSql('TRUNCATE TABLE cities');
+    util.importTable(__import_data_path + '/' + file, { schema: target_schema, table: 'cities', skipRows: 10, threads: threads, bytesPerChunk: '128k' })
+    EXPECT_EQ(4069, session.runSql('select count(*) from cities').fetchOne()[0], `${file}, threads: ${threads}`)
+  }
+}
+
 //@<> Import into table a zip file
 EXPECT_THROWS(function () {
     util.importTable(__import_data_path + '/world_x_cities.zip', { schema: target_schema, table: 'cities' });
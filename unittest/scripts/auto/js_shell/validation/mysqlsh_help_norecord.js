@@ -128,8 +128,9 @@ Usage: mysqlsh [OPTIONS] [URI]
   -E, --vertical                   Print the output of a query (rows)
                                    vertically.
   --result-format=<value>          Determines format of results. Allowed
-                                   values: [table, tabbed, vertical, json,
-                                   ndjson, json/raw, json/array, json/pretty].
+                                   values: [table, tabbed, csv, vertical,
+                                   json, ndjson, json/raw, json/array,
+                                   json/pretty].
   --get-server-public-key          Request public key from the server required
                                    for RSA key pair-based password exchange.
                                    Use when connecting to MySQL 8.0 servers
@@ -146,6 +147,11 @@ Usage: mysqlsh [OPTIONS] [URI]
                                    interactive mode.
   --force                          In SQL batch mode, forces processing to
                                    continue if an error is found.
+  --bulk-source                    In SQL batch mode, sends consecutive INSERT
+                                   and REPLACE statements to the server in
+                                   multi-statement batches. Supported only by
+                                   classic sessions in non-interactive mode,
+                                   when the JSON output is disabled.
   --log-file=<path>                Override location of the Shell log file.
   --log-level=<value>              Set logging level. The log level value must
                                    be an integer between 1 and 8 or any of
@@ -44,6 +44,13 @@ data
 {"data":"YWIKY2Q="}
 3 rows in set ([[*]] sec)
 
+//@<OUT> X CSV Format
+data
+0x6162006364
+0x6162096364
+0x61620A6364
+3 rows in set ([[*]] sec)
+
 //@<OUT> X Json Wrapping
 {
     "hasData": true,
@@ -109,6 +116,29 @@ data
 {"data":"YWIKY2Q="}
 3 rows in set ([[*]] sec)
 
+//@<OUT> Classic CSV Format
+data
+0x6162006364
+0x6162096364
+0x61620A6364
+3 rows in set ([[*]] sec)
+
+//@<OUT> Classic CSV Format - special values
+a,b,c,d,e
+1,,"","x,""y""",1.5
+1 row in set ([[*]] sec)
+
+//@<OUT> Classic Raw Json Format - special values
+{"a":1,"b":null,"c":"","d":"x,\"y\"","e":1.5}
+1 row in set ([[*]] sec)
+
+//@<OUT> Classic Json Array Format - special values
+[
+{"a":1,"b":null,"c":"","d":"x,\"y\"","e":1.5},
+{"a":2,"b":"b","c":"c\td","d":"e","e":2.25}
+]
+2 rows in set ([[*]] sec)
+
 //@<OUT> Classic Json Wrapping
 {
     "hasData": true,
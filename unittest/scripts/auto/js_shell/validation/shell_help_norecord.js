@@ -117,6 +117,10 @@ DESCRIPTION
         enabled. The \rehash command can be used for manual refresh
       - batchContinueOnError: read-only, boolean value to indicate if the
         execution of an SQL script in batch mode shall continue if errors occur
+      - bulkSource: boolean value to indicate if consecutive INSERT and REPLACE
+        statements shall be sent to the server in multi-statement batches when
+        executing an SQL script in non-interactive batch mode, supported only by
+        classic sessions and when the JSON output is disabled
       - connectTimeout: float, default connection timeout used by Shell
         sessions, in seconds
       - credentialStore.excludeFilters: array of URLs for which automatic
@@ -196,6 +200,7 @@ DESCRIPTION
 
       - table: tabular format with a ascii character frame (default)
       - tabbed: tabular format with no frame, columns separated by tabs
+      - csv: comma separated values with a header line, NULL values are empty
       - vertical: displays the outputs vertically, one line per column value
       - json: same as json/pretty
       - ndjson: newline delimited JSON, same as json/raw
@@ -2007,7 +2012,7 @@ SYNTAX
 
 WHERE
       result: The resultset object to dump
-      format: One of table, tabbed, vertical, json, ndjson, json/raw,
+      format: One of table, tabbed, csv, vertical, json, ndjson, json/raw,
               json/array, json/pretty. Default is table.
 
 RETURNS
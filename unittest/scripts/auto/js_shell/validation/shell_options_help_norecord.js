@@ -41,7 +41,7 @@
 
 //@<OUT> resultFormat option help text
  resultFormat  Determines format of results. Allowed values: [table, tabbed,
-               vertical, json, ndjson, json/raw, json/array, json/pretty].
+               csv, vertical, json, ndjson, json/raw, json/array, json/pretty].
 
 //@<OUT> passwordsFromStdin option help text
  passwordsFromStdin  Read passwords from stdin instead of the console.
@@ -302,6 +302,7 @@
 //@<OUT> List all the options using \option
  autocomplete.nameCache          true
  batchContinueOnError            false
+ bulkSource                      false
  connectTimeout                  10
  credentialStore.excludeFilters  []
  credentialStore.helper          default
@@ -340,6 +341,7 @@
 //@<OUT> List all the options using \option and show-origin
  autocomplete.nameCache          true (Compiled default)
  batchContinueOnError            false (Compiled default)
+ bulkSource                      false (Compiled default)
  connectTimeout                  10 (Compiled default)
  credentialStore.excludeFilters  [] (Compiled default)
  credentialStore.helper          default (Compiled default)
@@ -459,6 +461,7 @@
 //@<OUT> List all the options using \option for SQL mode
  autocomplete.nameCache          true
  batchContinueOnError            false
+ bulkSource                      false
  connectTimeout                  10
  credentialStore.excludeFilters  []
  credentialStore.helper          default
@@ -498,6 +501,7 @@
 Switching to SQL mode... Commands end with ;
  autocomplete.nameCache          true (Compiled default)
  batchContinueOnError            false (Compiled default)
+ bulkSource                      false (Compiled default)
  connectTimeout                  10 (Compiled default)
  credentialStore.excludeFilters  [] (Compiled default)
  credentialStore.helper          default (Compiled default)
@@ -1503,6 +1503,9 @@ DESCRIPTION
       - table: string - name of table where the data will be imported.
       - tableColumn: string (default: "doc") - name of column in target table
         where the imported JSON documents will be stored.
+      - threads: int (default: 1) - Use N threads and X Protocol sessions to
+        import the documents. Only used when importing from a regular file,
+        which is split at document boundaries.
       - convertBsonTypes: bool (default: false) - enables the BSON data type
         conversion.
       - convertBsonOid: bool (default: the value of convertBsonTypes) - enables
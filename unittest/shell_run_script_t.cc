@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017, 2021, Oracle and/or its affiliates.
+ * Copyright (c) 2017, 2022, Oracle and/or its affiliates.
  *
  * This program is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License, version 2.0,
@@ -155,6 +155,19 @@ select 'hello
 world'; select 3;
 select error;)*");
 
+    shcore::create_file("bulk.sql",
+                        R"*(DROP SCHEMA IF EXISTS bulk_source;
+CREATE SCHEMA bulk_source;
+CREATE TABLE bulk_source.t (id INT PRIMARY KEY);
+/*!40000 ALTER TABLE bulk_source.t DISABLE KEYS */;
+INSERT INTO bulk_source.t VALUES (1), (2);
+INSERT INTO bulk_source.t VALUES (2);
+INSERT INTO bulk_source.t VALUES (3);
+/*!40000 ALTER TABLE bulk_source.t ENABLE KEYS */;
+SELECT COUNT(*) FROM bulk_source.t;
+DROP SCHEMA bulk_source;
+)*");
+
     shcore::create_file("good_int.py",
                         "print(1)\n"
                         "print(2)\n"
@@ -249,6 +262,7 @@ session.run_sql("DROP SCHEMA `test-ó`")
     shcore::delete_file("good.sql");
     shcore::delete_file("bad.sql");
     shcore::delete_file("error_test.sql");
+    shcore::delete_file("bulk.sql");
     shcore::delete_file("good.js");
     shcore::delete_file("bad.js");
     shcore::delete_file("badsyn.js");
@@ -381,6 +395,27 @@ ERROR: 1008 at line 2: Can't drop database 'bogusdb'; database doesn't exist)";
   MY_EXPECT_CMD_OUTPUT_CONTAINS(result2);
 }
 
+TEST_F(ShellExeRunScript, sql_file_bulk_source) {
+  int rc;
+  wipe_out();
+  rc = execute({_mysqlsh, _mysql_uri.c_str(), "--sql", "--bulk-source", "-f",
+                "bulk.sql", nullptr});
+  EXPECT_EQ(1, rc);
+  MY_EXPECT_CMD_OUTPUT_CONTAINS(
+      "ERROR: 1062 at line 6: Duplicate entry '2' for key");
+  MY_EXPECT_CMD_OUTPUT_NOT_CONTAINS("COUNT(*)");
+
+  // the failed statement is skipped, the rest of the batch is executed
+  wipe_out();
+  execute({_mysqlsh, _mysql_uri.c_str(), "--sql", "--bulk-source", "--force",
+           "-f", "bulk.sql", nullptr});
+  MY_EXPECT_CMD_OUTPUT_CONTAINS(
+      "ERROR: 1062 at line 6: Duplicate entry '2' for key");
+  MY_EXPECT_CMD_OUTPUT_CONTAINS("COUNT(*)\n3");
+  // information about each statement is still printed
+  MY_EXPECT_CMD_OUTPUT_CONTAINS("Records: 2  Duplicates: 0  Warnings: 0");
+}
+
 TEST_F(ShellRunScript, sql_stream) {
   {
     RESET_BATCH("sql");